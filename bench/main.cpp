@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include <unistd.h>
+
+#include "DBGHAssert.h"
+#include "impl/CIoUringSink.h"
+#include "impl/CWritevSink.h"
+
+namespace
+{
+
+constexpr int s_iReportCount = 200000;
+
+void FailWarnings()
+{
+    for (int i = 0; i < s_iReportCount; ++i)
+    {
+        ASSERT_WARNING(i < 0, "The value must be negative, the current value is: {}.", i);
+    }
+}
+
+template<class TFunction>
+void Measure(std::string_view name, TFunction&& function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    std::cout << name << ": " << nanoseconds / s_iReportCount << " ns/report" << std::endl;
+}
+
+template<class TSink, class... TArgs>
+void MeasureSink(std::string_view name, TArgs&&... args)
+{
+    auto* pFile = std::tmpfile();
+    auto sink = std::make_shared<TSink>(::fileno(pFile), std::forward<TArgs>(args)...);
+    auto router = std::make_unique<dbgh::CAssertRouter>();
+    router->Subscribe(dbgh::EAssertLevel::Warning, sink);
+    dbgh::CAssertConfig::Get().SetExecutor(std::move(router));
+
+    Measure(name, [&sink]
+    {
+        FailWarnings();
+        sink->Flush();
+    });
+
+    dbgh::CAssertConfig::Get().SetExecutor();
+    std::fclose(pFile);
+}
+
+template<class TSink, class... TArgs>
+void MeasureSinkWrites(std::string_view name, TArgs&&... args)
+{
+    // The cost of the sink alone, for the report which is already formatted.
+    const std::string strReport(200, 'r');
+    auto* pFile = std::tmpfile();
+    {
+        TSink sink { ::fileno(pFile), std::forward<TArgs>(args)... };
+        Measure(name, [&sink, &strReport]
+        {
+            for (int i = 0; i < s_iReportCount; ++i)
+            {
+                sink.Write(dbgh::EAssertLevel::Warning, strReport);
+            }
+            sink.Flush();
+        });
+    }
+    std::fclose(pFile);
+}
+
+}
+
+int main()
+{
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Warning);
+
+    {
+        // The std::cerr path of the default executor, stderr is redirected to a temporary file.
+        auto* pFile = std::tmpfile();
+        const int stderrCopy = ::dup(STDERR_FILENO);
+        ::dup2(::fileno(pFile), STDERR_FILENO);
+        Measure("std::cerr", FailWarnings);
+        ::dup2(stderrCopy, STDERR_FILENO);
+        ::close(stderrCopy);
+        std::fclose(pFile);
+    }
+
+    MeasureSink<dbgh::CWritevSink>("writev sink");
+    MeasureSink<dbgh::CIoUringSink>("io_uring sink");
+    MeasureSinkWrites<dbgh::CWritevSink>("writev sink, write only");
+    MeasureSinkWrites<dbgh::CIoUringSink>("io_uring sink, write only");
+
+    std::cout << "__END__" << std::endl;
+    return 0;
+}
@@ -0,0 +1,65 @@
+# Generates the compile-time demotion table of the hot assertion sites (see include/impl/CSiteDemotions.h).
+#
+# The profile is written by the build with DBGH_ASSERTS_PROFILE, run with DBGH_ASSERTS_PROFILE_FILE=<profile>.
+# The site is demoted by the share of its evaluation ticks in the evaluation ticks of all sites:
+#   share >= DBGH_ASSERTS_DEMOTION_REMOVE_PERCENT  - the check is removed (0 disables the removal),
+#   share >= DBGH_ASSERTS_DEMOTION_SAMPLE_PERCENT  - the check is sampled.
+
+function(dbgh_asserts_generate_demotions target profile)
+    if (NOT EXISTS "${profile}")
+        message(FATAL_ERROR "DBGH_ASSERTS_DEMOTION_PROFILE: the profile '${profile}' does not exist.")
+    endif()
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${profile}")
+
+    file(STRINGS "${profile}" profileLines REGEX "^[^#]")
+    set(sites)
+    set(totalTicks 0)
+    foreach(profileLine IN LISTS profileLines)
+        string(REPLACE "\t" ";" fields "${profileLine}")
+        list(LENGTH fields fieldCount)
+        if (fieldCount LESS 6)
+            message(WARNING "DBGH_ASSERTS_DEMOTION_PROFILE: skipped the malformed line '${profileLine}'.")
+            continue()
+        endif()
+        list(GET fields 3 ticks)
+        math(EXPR totalTicks "${totalTicks} + ${ticks}")
+        list(APPEND sites "${profileLine}")
+    endforeach()
+
+    set(entries "")
+    set(sampledCount 0)
+    set(removedCount 0)
+    foreach(site IN LISTS sites)
+        string(REPLACE "\t" ";" fields "${site}")
+        list(GET fields 0 file)
+        list(GET fields 1 line)
+        list(GET fields 3 ticks)
+        math(EXPR share "${ticks} * 100")
+        math(EXPR removeBound "${totalTicks} * ${DBGH_ASSERTS_DEMOTION_REMOVE_PERCENT}")
+        math(EXPR sampleBound "${totalTicks} * ${DBGH_ASSERTS_DEMOTION_SAMPLE_PERCENT}")
+        if (DBGH_ASSERTS_DEMOTION_REMOVE_PERCENT GREATER 0 AND share GREATER 0 AND NOT share LESS removeBound)
+            set(mode Disabled)
+            math(EXPR removedCount "${removedCount} + 1")
+        elseif (share GREATER 0 AND NOT share LESS sampleBound)
+            set(mode Sampled)
+            math(EXPR sampledCount "${sampledCount} + 1")
+        else()
+            continue()
+        endif()
+        string(REPLACE "\\" "\\\\" file "${file}")
+        string(REPLACE "\"" "\\\"" file "${file}")
+        string(APPEND entries "    { \"${file}\", ${line}, dbgh::ESiteMode::${mode} }, \\\n")
+    endforeach()
+
+    set(generatedDir "${CMAKE_CURRENT_BINARY_DIR}/generated")
+    file(WRITE "${generatedDir}/DBGHAssertDemotions.h.tmp"
+            "// Generated by cmake/DBGHAssertsDemotion.cmake from ${profile}, do not edit.\n"
+            "#pragma once\n\n"
+            "#define DBGH_ASSERTS_DEMOTIONS \\\n${entries}\n")
+    # Copied only on change, so the unchanged profile does not rebuild the asserting sources.
+    configure_file("${generatedDir}/DBGHAssertDemotions.h.tmp" "${generatedDir}/DBGHAssertDemotions.h" COPYONLY)
+
+    target_include_directories(${target} PUBLIC "${generatedDir}")
+    target_compile_definitions(${target} PUBLIC "DBGH_ASSERTS_DEMOTIONS_HEADER=\"DBGHAssertDemotions.h\"")
+    message(STATUS "DBGH_ASSERTS: ${sampledCount} sites sampled, ${removedCount} sites removed by ${profile}.")
+endfunction()
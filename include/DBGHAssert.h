@@ -11,8 +11,15 @@
 #include <format>
 
 #include "impl/CAssertException.h"
+#include "impl/CAssertCategory.h"
 #include "impl/CAssertConfig.h"
 #include "impl/CAssertHandler.h"
+#include "impl/CBasicAsserts.h"
+#include "impl/CAssertRouter.h"
+#include "impl/CScopedContext.h"
+#include "impl/CCoroutineContext.h"
+#include "impl/CMessageSketches.h"
+#include "impl/CSiteDemotions.h"
 
 
 #ifdef _MSC_VER
@@ -36,22 +43,72 @@
 #endif
 
 
+#ifndef DBGH_ASSERTS_HANDLER
+
+/**
+ * @brief      The front end which handles the failed assertions.
+ *
+ * @details    By default the failed assertions are handled by the executor installed in \ref dbgh::CAssertConfig.
+ *              To bind the executor at compile time, define DBGH_ASSERTS_HANDLER as \ref dbgh::CBasicAsserts
+ *              with your executor type before including this header.
+ *
+ * @example    #define DBGH_ASSERTS_HANDLER dbgh::CBasicAsserts<MyExecutor>
+ *             #include "DBGHAssert.h"
+ */
+#define DBGH_ASSERTS_HANDLER dbgh::impl::CAssertHandler
+#endif
+
+
+/**
+ * @brief      Measures the failure handling of the site when the asserts are built with DBGH_ASSERTS_PROFILE.
+ *
+ * @param      _site_        The site of the failed assertion.
+ */
+#if defined(DBGH_ASSERTS_PROFILE)
+#define IMPL_DBGH_PROFILE_HANDLER(_site_) const dbgh::CHandlerProfileScope __profileScope { _site_ }
+#else
+#define IMPL_DBGH_PROFILE_HANDLER(_site_) (void) 0
+#endif
+
+
 /**
  * @brief      The helper macro using for place code for asserts in one line.
  *
  * @param      _level_       The assert level.
+ * @param      _category_    The assert category, see \ref dbgh::SAssertCategory.
  * @param      _expression_  Expression to be evaluated. If this expression evaluates to false, this causes an assertion failure.
  * @param      ...           The string and args for formating will appear as a runtime error if the _expression_ is false.
  */
-#define IMPL_DBGH_ASSERT(_level_, _expression_, ...)                                                                                    \
-    if ( dbgh::CAssertConfig::Get().IsActiveAssert(_level_) && ! bool(_expression_) )                                                   \
+#define IMPL_DBGH_ASSERT(_level_, _category_, _expression_, ...)                                                                        \
+    if constexpr ( constexpr auto __mode = dbgh::CSiteDemotions::Get(_level_, __FILE__, __LINE__);                                      \
+                   dbgh::ESiteMode::Disabled != __mode )                                                                                \
     {                                                                                                                                   \
-        try {                                                                                                                           \
-            dbgh::impl::CAssertHandler::HandleAssert<_level_>(std::format(__VA_ARGS__)                                                  \
-                                                           , #_expression_ , __FILE__                                                   \
-                                                           , __LINE__, __func__);                                                       \
-        } catch (const dbgh::CAssertException& e) {                                                                                     \
-            throw e;                                                                                                                    \
+        if ( dbgh::CAssertConfig::Get().IsActiveAssert(_level_, (_category_).index) )                                                   \
+        {                                                                                                                               \
+            static dbgh::SAssertSite __site { _level_, #_expression_, __FILE__, __LINE__, __func__, (_category_).index };               \
+            dbgh::CAssertProbe __probe { __site, __mode };                                                                              \
+            if ( __probe.ShouldEvaluate() && ! __probe.Finish(bool(_expression_)) )                                                     \
+            {                                                                                                                           \
+                const auto __stamp = dbgh::CCaptureClock::Capture();                                                                    \
+                if ( dbgh::CAssertConfig::Get().ShouldReport(__site) )                                                                  \
+                {                                                                                                                       \
+                    try {                                                                                                               \
+                        IMPL_DBGH_PROFILE_HANDLER(__site);                                                                              \
+                        DBGH_ASSERTS_HANDLER::HandleAssert<_level_>(                                                                    \
+                                __stamp                                                                                                 \
+                                , dbgh::CMessageSketches::Observe(                                                                      \
+                                        __site, (DBGH_ASSERTS_HANDLER::IsMessageUsed<_level_>() || dbgh::CMessageSketches::IsEnabled()) \
+                                                ? std::format(__VA_ARGS__) : std::string { })                                           \
+                                , #_expression_ , __FILE__, __LINE__, __func__);                                                        \
+                    } catch (const dbgh::CAssertException& e) {                                                                         \
+                        throw e;                                                                                                        \
+                    }                                                                                                                   \
+                }                                                                                                                       \
+                else if ( dbgh::CMessageSketches::ShouldSampleSuppressed() )                                                            \
+                {                                                                                                                       \
+                    dbgh::CMessageSketches::ObserveSuppressed(__site, std::format(__VA_ARGS__));                                        \
+                }                                                                                                                       \
+            }                                                                                                                           \
         }                                                                                                                               \
     }                                                                                                                                   \
     (void) 0
@@ -62,24 +119,40 @@
  *              Specialization for ASSERT_DEBUG.
  *
  * @param      _level_       The assert level.
+ * @param      _category_    The assert category, see \ref dbgh::SAssertCategory.
  * @param      _expression_  Expression to be evaluated. If this expression evaluates to false, this causes an assertion failure.
  * @param      ...           The string and args for formating will appear as a runtime error if the _expression_ is false.
  */
-#define IMPL_DBGH_ASSERT_DEBUG(_level_, _expression_, ...)                                                                              \
+#define IMPL_DBGH_ASSERT_DEBUG(_level_, _category_, _expression_, ...)                                                                  \
+    if constexpr ( constexpr auto __mode = dbgh::CSiteDemotions::Get(_level_, __FILE__, __LINE__);                                      \
+                   dbgh::ESiteMode::Disabled != __mode )                                                                                \
     {                                                                                                                                   \
         static bool __ignore { false };                                                                                                 \
-        if ( (! __ignore) && (dbgh::CAssertConfig::Get().IsActiveAssert(_level_)) && (! bool(_expression_)) )                           \
+        if ( (! __ignore) && (dbgh::CAssertConfig::Get().IsActiveAssert(_level_, (_category_).index)) )                                 \
         {                                                                                                                               \
-            try {                                                                                                                       \
-                dbgh::impl::CAssertHandler::HandleAssert<_level_>(std::format(__VA_ARGS__)                                              \
-                                                               , #_expression_ , __FILE__                                               \
-                                                               , __LINE__, __func__, __ignore);                                         \
-            } catch (const dbgh::impl::CAssertHandler::SStartDebuggingException) {                                                      \
-                 START_DEBUGGING;                                                                                                       \
-            } catch (const dbgh::CAssertException& e) {                                                                                 \
-                throw e;                                                                                                                \
+            static dbgh::SAssertSite __site { _level_, #_expression_, __FILE__, __LINE__, __func__, (_category_).index };               \
+            dbgh::CAssertProbe __probe { __site, __mode };                                                                              \
+            if ( __probe.ShouldEvaluate() && ! __probe.Finish(bool(_expression_)) )                                                     \
+            {                                                                                                                           \
+                const auto __stamp = dbgh::CCaptureClock::Capture();                                                                    \
+                if ( dbgh::CAssertConfig::Get().ShouldReport(__site) )                                                                  \
+                {                                                                                                                       \
+                    try {                                                                                                               \
+                        IMPL_DBGH_PROFILE_HANDLER(__site);                                                                              \
+                        DBGH_ASSERTS_HANDLER::HandleAssert<_level_>(                                                                    \
+                                __stamp, dbgh::CMessageSketches::Observe(__site, std::format(__VA_ARGS__))                              \
+                                , #_expression_ , __FILE__, __LINE__, __func__, __ignore);                                              \
+                    } catch (const dbgh::impl::CAssertHandler::SStartDebuggingException) {                                              \
+                         START_DEBUGGING;                                                                                               \
+                    } catch (const dbgh::CAssertException& e) {                                                                         \
+                        throw e;                                                                                                        \
+                    }                                                                                                                   \
+                }                                                                                                                       \
+                else if ( dbgh::CMessageSketches::ShouldSampleSuppressed() )                                                            \
+                {                                                                                                                       \
+                    dbgh::CMessageSketches::ObserveSuppressed(__site, std::format(__VA_ARGS__));                                        \
+                }                                                                                                                       \
             }                                                                                                                           \
-                                                                                                                                        \
         }                                                                                                                               \
     }                                                                                                                                   \
     (void) 0
@@ -137,7 +210,7 @@
  * @param      _expression_  Expression to be evaluated. If this expression evaluates to false, this causes an assertion failure.
  * @param      ...           The string and args for formating will appear as a runtime error if the _expression_ is false.
  */
-#define ASSERT_DEBUG(_expression_, ...)    IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, _expression_, __VA_ARGS__)
+#define ASSERT_DEBUG(_expression_, ...)    IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, dbgh::DefaultCategory, _expression_, __VA_ARGS__)
 
 #ifndef DEBUG
 
@@ -184,7 +257,7 @@
  * @param      _expression_  Expression to be evaluated. If this expression evaluates to false, this causes an assertion failure.
  * @param      ...           The string and args for formating will appear as a runtime error if the _expression_ is false.
  */
-#define ASSERT_WARNING(_expression_, ...)  IMPL_DBGH_ASSERT(dbgh::EAssertLevel::Warning, _expression_, __VA_ARGS__)
+#define ASSERT_WARNING(_expression_, ...)  IMPL_DBGH_ASSERT(dbgh::EAssertLevel::Warning, dbgh::DefaultCategory, _expression_, __VA_ARGS__)
 
 /**
  * @brief      If the argument expression of this macro with functional form compares equal to 0 (i.e., the expression is false),
@@ -231,7 +304,7 @@
  * @param      _expression_  Expression to be evaluated. If this expression evaluates to false, this causes an assertion failure.
  * @param      ...           The string and args for formating will appear as a runtime error if the _expression_ is false.
  */
-#define ASSERT_ERROR(_expression_, ...)    IMPL_DBGH_ASSERT(dbgh::EAssertLevel::Error, _expression_, __VA_ARGS__)
+#define ASSERT_ERROR(_expression_, ...)    IMPL_DBGH_ASSERT(dbgh::EAssertLevel::Error, dbgh::DefaultCategory, _expression_, __VA_ARGS__)
 
 /**
  * @brief      If the argument expression of this macro with functional form compares equal to 0 (i.e., the expression is false),
@@ -279,7 +352,7 @@
  * @param      _expression_  Expression to be evaluated. If this expression evaluates to false, this causes an assertion failure.
  * @param      .             The string and args for formating will appear as a runtime error if the _expression_ is false.
  */
-#define ASSERT_FATAL(_expression_, ...)    IMPL_DBGH_ASSERT(dbgh::EAssertLevel::Fatal, _expression_, __VA_ARGS__)
+#define ASSERT_FATAL(_expression_, ...)    IMPL_DBGH_ASSERT(dbgh::EAssertLevel::Fatal, dbgh::DefaultCategory, _expression_, __VA_ARGS__)
 
 #else
 
@@ -288,8 +361,35 @@
  *
  * @details    In debug mode, all asserts replace to \ref ASSERT_DEBUG
  */
-#define ASSERT_WARNING(_expression_, ...)  IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, _expression_, __VA_ARGS__)
-#define ASSERT_ERROR(_expression_, ...)    IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, _expression_, __VA_ARGS__)
-#define ASSERT_FATAL(_expression_, ...)    IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, _expression_, __VA_ARGS__)
+#define ASSERT_WARNING(_expression_, ...)  IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, dbgh::DefaultCategory, _expression_, __VA_ARGS__)
+#define ASSERT_ERROR(_expression_, ...)    IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, dbgh::DefaultCategory, _expression_, __VA_ARGS__)
+#define ASSERT_FATAL(_expression_, ...)    IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, dbgh::DefaultCategory, _expression_, __VA_ARGS__)
+
+#endif
 
+
+/**
+ * @brief      The asserts of the category, the category is enabled per level (see \ref dbgh::CAssertConfig::EnableCategory
+ *              and the "categories" configuration key), the other behavior is the same as of the untagged asserts.
+ *
+ * @details    The category is a compile-time constant declared by \ref DBGH_ASSERT_CATEGORY, the disabled category costs
+ *              one AND against the enable word of the configuration, the same as the disabled level.
+ *
+ * @example    DBGH_ASSERT_CATEGORY(Network, 2);
+ *             ASSERT_WARNING_IN(Network, packet.size() <= mtu, "The packet size {} exceeds the MTU.", packet.size());
+ *
+ * @param      _category_    The assert category, see \ref dbgh::SAssertCategory.
+ * @param      _expression_  Expression to be evaluated. If this expression evaluates to false, this causes an assertion failure.
+ * @param      ...           The string and args for formating will appear as a runtime error if the _expression_ is false.
+ */
+#define ASSERT_DEBUG_IN(_category_, _expression_, ...)    IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, _category_, _expression_, __VA_ARGS__)
+
+#ifndef DEBUG
+#define ASSERT_WARNING_IN(_category_, _expression_, ...)  IMPL_DBGH_ASSERT(dbgh::EAssertLevel::Warning, _category_, _expression_, __VA_ARGS__)
+#define ASSERT_ERROR_IN(_category_, _expression_, ...)    IMPL_DBGH_ASSERT(dbgh::EAssertLevel::Error, _category_, _expression_, __VA_ARGS__)
+#define ASSERT_FATAL_IN(_category_, _expression_, ...)    IMPL_DBGH_ASSERT(dbgh::EAssertLevel::Fatal, _category_, _expression_, __VA_ARGS__)
+#else
+#define ASSERT_WARNING_IN(_category_, _expression_, ...)  IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, _category_, _expression_, __VA_ARGS__)
+#define ASSERT_ERROR_IN(_category_, _expression_, ...)    IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, _category_, _expression_, __VA_ARGS__)
+#define ASSERT_FATAL_IN(_category_, _expression_, ...)    IMPL_DBGH_ASSERT_DEBUG(dbgh::EAssertLevel::Debug, _category_, _expression_, __VA_ARGS__)
 #endif
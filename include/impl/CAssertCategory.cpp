@@ -0,0 +1,79 @@
+/**
+ * @file        CAssertCategory.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CCategoryRegistry class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <array>
+#include <charconv>
+#include <mutex>
+
+#include "CAssertCategory.h"
+
+namespace dbgh
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The names of the categories and the mutex protecting them.
+ */
+struct SCategoryNames
+{
+    std::mutex mtx;
+    std::array<const char*, MaxCategories> arrNames { DefaultCategory.name };
+};
+
+/**
+ * @internal
+ * @brief      Gets the names of the categories.
+ */
+SCategoryNames& Names()
+{
+    static SCategoryNames names;
+    return names;
+}
+}  // unnamed namespace
+
+void CCategoryRegistry::Register(const SAssertCategory& category) noexcept
+{
+    if (category.index < MaxCategories)
+    {
+        auto& names = Names();
+        std::lock_guard lock { names.mtx };
+        names.arrNames[category.index] = category.name;
+    }
+}
+
+std::optional<std::uint32_t> CCategoryRegistry::Find(const std::string_view name)
+{
+    std::uint32_t uIndex = 0;
+    const auto [pEnd, error] = std::from_chars(name.data(), name.data() + name.size(), uIndex);
+    if (std::errc { } == error && name.data() + name.size() == pEnd)
+    {
+        return (uIndex < MaxCategories) ? std::optional { uIndex } : std::nullopt;
+    }
+
+    auto& names = Names();
+    std::lock_guard lock { names.mtx };
+    for (std::uint32_t uCategory = 0; uCategory < MaxCategories; ++uCategory)
+    {
+        if (nullptr != names.arrNames[uCategory] && name == names.arrNames[uCategory])
+        {
+            return uCategory;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string CCategoryRegistry::Name(const std::uint32_t index)
+{
+    auto& names = Names();
+    std::lock_guard lock { names.mtx };
+    return (index < MaxCategories && nullptr != names.arrNames[index]) ? names.arrNames[index] : std::to_string(index);
+}
+
+} // namespace dbgh
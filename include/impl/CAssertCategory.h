@@ -0,0 +1,118 @@
+/**
+ * @file        CAssertCategory.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for SAssertCategory struct, CCategoryRegistry class and DBGH_ASSERT_CATEGORY macro.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "EAssertLevel.h"
+
+namespace dbgh
+{
+
+/**
+ * @struct     SAssertCategory
+ * @brief      The category tag of the asserts, enabled per level (see \ref CAssertConfig::EnableCategory).
+ *
+ * @details    The category is a compile-time constant, the assert macros check its bit of the enable word of the
+ *              level. The index 0 is \ref DefaultCategory, the category of the untagged asserts. Declare the
+ *              categories with \ref DBGH_ASSERT_CATEGORY.
+ */
+struct SAssertCategory
+{
+    /**
+     * @brief      The index of the category, less than \ref MaxCategories.
+     */
+    std::uint32_t index;
+
+    /**
+     * @brief      The name of the category, used by the configuration.
+     */
+    const char* name;
+};
+
+/**
+ * @brief      The category of the untagged asserts.
+ */
+inline constexpr SAssertCategory DefaultCategory { 0, "default" };
+
+
+/**
+ * @class      CCategoryRegistry
+ * @brief      The names of the declared categories, used by the configuration.
+ */
+class CCategoryRegistry
+{
+public:
+
+    CCategoryRegistry() = delete;
+
+    /**
+     * @brief      Registers the name of the category, the later name of the index wins.
+     *
+     * @param[in]  category  The category.
+     */
+    static void Register(const SAssertCategory& category) noexcept;
+
+    /**
+     * @brief      Finds the category by the name or the decimal index.
+     *
+     * @param[in]  name  The name or the index.
+     *
+     * @return     The index, or empty if the name is not registered.
+     */
+    [[nodiscard]] static std::optional<std::uint32_t> Find(std::string_view name);
+
+    /**
+     * @brief      Gets the name of the category.
+     *
+     * @param[in]  index  The index of the category.
+     *
+     * @return     The registered name, or the decimal index.
+     */
+    [[nodiscard]] static std::string Name(std::uint32_t index);
+
+}; // class CCategoryRegistry
+
+
+/**
+ * @internal
+ * @struct     SCategoryRegistrar
+ * @brief      Registers the category declared by \ref DBGH_ASSERT_CATEGORY at the static initialization.
+ */
+struct SCategoryRegistrar
+{
+    explicit SCategoryRegistrar(const SAssertCategory& category) noexcept
+    {
+        CCategoryRegistry::Register(category);
+    }
+};
+
+} // namespace dbgh
+
+
+/**
+ * @brief      Declares the assert category at namespace scope.
+ *
+ * @details    The name of the category is the name of the constant, the configuration refers to it by the name
+ *              (registered at the static initialization) or by the index.
+ *
+ * @example    DBGH_ASSERT_CATEGORY(Storage, 1);
+ *             ASSERT_WARNING_IN(Storage, page.IsValid(), "The page {} is corrupted.", page.Id());
+ *             dbgh::CAssertConfig::Get().Configure("categories=Storage");
+ *
+ * @param      _name_   The name of the category constant.
+ * @param      _index_  The index of the category, from 1 to \ref dbgh::MaxCategories - 1.
+ */
+#define DBGH_ASSERT_CATEGORY(_name_, _index_)                                                                                           \
+    static_assert(0 < (_index_) && (_index_) < dbgh::MaxCategories, "The category index must be from 1 to MaxCategories - 1.");         \
+    inline constexpr dbgh::SAssertCategory _name_ { (_index_), #_name_ };                                                               \
+    inline const dbgh::SCategoryRegistrar _name_##Registrar_ { _name_ }
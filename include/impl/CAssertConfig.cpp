@@ -6,24 +6,118 @@
  * @copyright   Copyright (c) 2020
  */
 
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
 #include <stdexcept>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+
+#include "CRotatingFileSink.h"
+#include "CWritevSink.h"
+#endif
+
 #include "CAssertConfig.h"
+#include "CAssertRouter.h"
+#include "CBudgetGovernor.h"
+#include "CBurstScheduler.h"
+#include "CCircuitBreaker.h"
+#include "CConfigParser.h"
+#include "CConfigWatcher.h"
+#include "CControlServer.h"
+#include "CMessageSketches.h"
+#include "CMetricsExporter.h"
+#include "CReportBackoff.h"
+#include "CSharedControl.h"
+#include "CSiteRules.h"
+#include "CStatsSegment.h"
 
 namespace dbgh
 {
 
+namespace
+{
+/**
+ * @internal
+ * @brief      Reads the whole configuration file.
+ */
+std::string ReadConfigFile(const std::string& path)
+{
+    std::ifstream file { path };
+    if (! file)
+    {
+        throw std::runtime_error { "Cannot open the config file: " + path + "." };
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+/**
+ * @internal
+ * @brief      Creates the executor writing the reports of all levels to the chosen sink.
+ */
+std::unique_ptr<CHandlerExecutor> MakeSinkExecutor(const ESinkChoice sink, const std::string& path)
+{
+    std::shared_ptr<CAssertSink> pSink;
+    switch (sink)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        case ESinkChoice::Stderr:
+            pSink = std::make_shared<CWritevSink>(STDERR_FILENO);
+            break;
+        case ESinkChoice::File:
+            pSink = std::make_shared<CRotatingFileSink>(path);
+            break;
+#else
+        case ESinkChoice::Stderr:
+            [[fallthrough]];
+        case ESinkChoice::File:
+            throw std::invalid_argument { "The sink '" + path + "' is available on POSIX platforms only." };
+#endif
+        case ESinkChoice::Default:
+            [[fallthrough]];
+        default:
+            return std::make_unique<CHandlerExecutor>();
+    }
+    auto pRouter = std::make_unique<CAssertRouter>();
+    for (std::size_t uLevel = 0; uLevel < static_cast<std::size_t>(EAssertLevel::END_ENUM_); ++uLevel)
+    {
+        pRouter->Subscribe(static_cast<EAssertLevel>(uLevel), pSink);
+    }
+    return pRouter;
+}
+}  // unnamed namespace
+
 CAssertConfig::CAssertConfig()
-        : m_arrEnableFlags {
-        true,    // Warning default value.
-        true,    // Debug default value.
-        true,    // Error default value.
-        false }, // Fatal default value.
-    m_pHandlerExecutor { std::make_unique<dbgh::CHandlerExecutor>() }
-{ }
+        : m_uEnableWord { EnableWordOf(CConfigParser::DefaultLevels) },
+    m_pSharedControl { nullptr },
+    m_bFileSink { false },
+    m_pHandlerExecutor { std::make_unique<dbgh::CHandlerExecutor>() },
+    m_pfnFilter { nullptr },
+    m_uFilterGeneration { 0 },
+    m_eReportFormat { EReportFormat::Text },
+    m_uBackoffLevels { 0 },
+    m_uTrippedLevels { 0 }
+{
+    CSiteRules::BindEnableWord(m_uEnableWord);
+    loadStartupConfig();
+}
 
 
-CAssertConfig::~CAssertConfig() = default;
+CAssertConfig::~CAssertConfig()
+{
+#if defined(__linux__)
+    if (auto* pControl = m_pSharedControl.load(std::memory_order_acquire); nullptr != pControl)
+    {
+        // The block outlives the configuration, its mirror thread must not write to the destroyed word.
+        pControl->Mirror({ });
+    }
+#endif
+}
 
 CAssertConfig& CAssertConfig::Get()
 {
@@ -33,17 +127,43 @@ CAssertConfig& CAssertConfig::Get()
 
 [[maybe_unused]] void CAssertConfig::EnableAsserts(const EAssertLevel level) noexcept
 {
-    m_arrEnableFlags[static_cast<size_t>(level)] = true;
+    forgetBursts(LevelBits(level));
+    updateEnableWord([level](const std::uint64_t uWord) { return uWord | LevelBits(level); });
 }
 
 [[maybe_unused]] void CAssertConfig::DisableAsserts(const EAssertLevel level) noexcept
 {
-    m_arrEnableFlags[static_cast<size_t>(level)] = false;
+    forgetBursts(LevelBits(level));
+    updateEnableWord([level](const std::uint64_t uWord) { return uWord & ~LevelBits(level); });
 }
 
-bool CAssertConfig::IsActiveAssert(const EAssertLevel level) const noexcept
+[[maybe_unused]] void CAssertConfig::EnableCategory(const EAssertLevel level, const SAssertCategory& category) noexcept
 {
-    return m_arrEnableFlags[static_cast<size_t>(level)];
+    const auto uBit = EnableBit(level, category.index);
+    forgetBursts(uBit);
+    updateEnableWord([uBit](const std::uint64_t uWord) { return uWord | uBit; });
+}
+
+[[maybe_unused]] void CAssertConfig::DisableCategory(const EAssertLevel level, const SAssertCategory& category) noexcept
+{
+    const auto uBit = EnableBit(level, category.index);
+    forgetBursts(uBit);
+    updateEnableWord([uBit](const std::uint64_t uWord) { return uWord & ~uBit; });
+}
+
+[[maybe_unused]] void CAssertConfig::EnableFor(const EAssertLevel level, const std::chrono::milliseconds duration)
+{
+    burstScheduler().EnableBits(LevelBits(level), impl::CBurstScheduler::TClock::now() + duration);
+}
+
+[[maybe_unused]] void CAssertConfig::EnableSiteFor(
+        const std::string_view file, const TLine line, const std::chrono::milliseconds duration)
+{
+    if (file.empty())
+    {
+        throw std::invalid_argument { "The file of the site cannot be empty." };
+    }
+    burstScheduler().EnableSite(std::string { file }, line, impl::CBurstScheduler::TClock::now() + duration);
 }
 
 [[maybe_unused]] void CAssertConfig::SetExecutor(std::unique_ptr<dbgh::CHandlerExecutor> executor)
@@ -52,12 +172,448 @@ bool CAssertConfig::IsActiveAssert(const EAssertLevel level) const noexcept
     {
         throw std::invalid_argument { "Executor cannot be null." };
     }
-    m_pHandlerExecutor = std::move(executor);
+    m_pHandlerExecutor.store(std::move(executor), std::memory_order_release);
+}
+
+std::shared_ptr<CHandlerExecutor> CAssertConfig::GetExecutor() const noexcept
+{
+    return m_pHandlerExecutor.load(std::memory_order_acquire);
+}
+
+[[maybe_unused]] void CAssertConfig::SetFilter(const TAssertFilter filter) noexcept
+{
+    m_pfnFilter.store(filter, std::memory_order_release);
+    m_uFilterGeneration.fetch_add(1, std::memory_order_acq_rel);
+    CAssertSiteRegistry::ForEach([](SAssertSite& site)
+    {
+        site.flags.fetch_and(~SAssertSite::FilterMask, std::memory_order_relaxed);
+    });
+}
+
+[[maybe_unused]] void CAssertConfig::SetCpuBudget(const double fraction, const std::chrono::milliseconds period)
+{
+    std::lock_guard lock { m_mtxBudget };
+    m_pBudgetGovernor.reset();
+    if (fraction > 0.0)
+    {
+        m_pBudgetGovernor = std::make_unique<impl::CBudgetGovernor>(fraction, period);
+    }
+}
+
+[[maybe_unused]] void CAssertConfig::SetReportBackoff(const std::uint32_t levels, const std::chrono::milliseconds summaryPeriod)
+{
+    if (0 != (levels & (LevelMask(EAssertLevel::Error) | LevelMask(EAssertLevel::Fatal))))
+    {
+        throw std::invalid_argument { "The report backoff is available for the warning and debug levels only." };
+    }
+    std::lock_guard lock { m_mtxBackoff };
+    m_pReportBackoff.reset();
+    m_uBackoffLevels.store(0, std::memory_order_relaxed);
+    // Every site starts again from its first failure.
+    CAssertSiteRegistry::ForEach([](SAssertSite& site)
+    {
+        site.backoffFailures.store(0, std::memory_order_relaxed);
+    });
+    m_uBackoffLevels.store(levels & AllLevelsMask, std::memory_order_relaxed);
+    if (0 != levels)
+    {
+        m_pReportBackoff = std::make_unique<impl::CReportBackoff>(levels, summaryPeriod);
+    }
+}
+
+[[maybe_unused]] void CAssertConfig::SetCircuitBreaker(const double failuresPerSecond, const std::chrono::milliseconds period)
+{
+    std::lock_guard lock { m_mtxBreaker };
+    m_pCircuitBreaker.reset();
+    if (failuresPerSecond > 0.0)
+    {
+        m_pCircuitBreaker = std::make_unique<impl::CCircuitBreaker>(failuresPerSecond, period, m_uTrippedLevels);
+    }
+}
+
+[[maybe_unused]] void CAssertConfig::Configure(const std::string_view text)
+{
+    applySettings(CConfigParser::Parse(text), false);
+}
+
+[[maybe_unused]] void CAssertConfig::Amend(const std::string_view text)
+{
+    applySettings(CConfigParser::Parse(text), true);
+}
+
+void CAssertConfig::applySettings(SConfigSettings settings, const bool keepRules)
+{
+    if (settings.sink.has_value())
+    {
+        // Created first, the sink which cannot be opened leaves the configuration unchanged.
+        SetExecutor(MakeSinkExecutor(*settings.sink, settings.sinkPath));
+    }
+    if (settings.reportFormat.has_value())
+    {
+        SetReportFormat(*settings.reportFormat);
+    }
+    if (settings.cpuBudget.has_value())
+    {
+        SetCpuBudget(*settings.cpuBudget);
+    }
+    if (settings.backoffMask.has_value())
+    {
+        SetReportBackoff(*settings.backoffMask);
+    }
+    if (settings.breakerThreshold.has_value())
+    {
+        SetCircuitBreaker(*settings.breakerThreshold);
+    }
+    if (settings.messageSketches.has_value())
+    {
+        CMessageSketches::SetEnabled(*settings.messageSketches);
+    }
+    if (keepRules)
+    {
+        auto vecRules = CSiteRules::Get();
+        vecRules.insert(vecRules.end(), std::make_move_iterator(settings.siteRules.begin()),
+                        std::make_move_iterator(settings.siteRules.end()));
+        settings.siteRules = std::move(vecRules);
+    }
+    if (settings.enableMask.has_value() || settings.categoryMask.has_value()
+        || std::ranges::any_of(settings.levelCategoryMasks, [](const auto& mask) { return mask.has_value(); }))
+    {
+        forgetBursts(~std::uint64_t { 0 });
+    }
+    switchConfiguration(settings);
+}
+
+void CAssertConfig::switchConfiguration(SConfigSettings& settings)
+{
+    const auto update = [&settings](const std::uint64_t uWord)
+    {
+        return CConfigParser::UpdateEnableWord(settings, uWord);
+    };
+#if defined(__linux__)
+    auto* pControl = m_pSharedControl.load(std::memory_order_acquire);
+#endif
+    {
+        std::lock_guard lock { m_mtxEnable };
+        auto uWord = GetEnableWord();
+#if defined(__linux__)
+        if (nullptr != pControl)
+        {
+            // The levels of the block are applied by CAS, the concurrent writers of other processes are not lost.
+            auto& sharedWord = pControl->EnableWord();
+            uWord = sharedWord.load(std::memory_order_relaxed);
+            while (! sharedWord.compare_exchange_weak(uWord, update(uWord), std::memory_order_relaxed))
+            {
+            }
+        }
+#endif
+        CSiteRules::Set(std::move(settings.siteRules), update(uWord));
+    }
+#if defined(__linux__)
+    if (nullptr != pControl)
+    {
+        pControl->PublishEnableWord();
+    }
+#endif
+}
+
+[[maybe_unused]] void CAssertConfig::LoadConfigFile(const std::string& path)
+{
+    Configure(ReadConfigFile(path));
 }
 
-CHandlerExecutor* CAssertConfig::GetExecutor() const noexcept
+[[maybe_unused]] void CAssertConfig::WatchConfigFile(const std::string& path)
 {
-    return m_pHandlerExecutor.get();
+    std::lock_guard lock { m_mtxWatcher };
+    m_pConfigWatcher.reset();
+    if (path.empty())
+    {
+        return;
+    }
+#if defined(__linux__)
+    auto strContent = ReadConfigFile(path);
+    applyFileConfig(strContent);
+    m_pConfigWatcher = std::make_unique<impl::CConfigWatcher>(path, std::move(strContent),
+                                                              [this, path](const std::string& content)
+    {
+        try
+        {
+            applyFileConfig(content);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "DBGH_ASSERTS: the changed config file '" << path << "' is ignored. " << e.what() << std::endl;
+        }
+    });
+#else
+    throw std::runtime_error { "Watching the config file is available on Linux only." };
+#endif
+}
+
+[[maybe_unused]] void CAssertConfig::EvaluateCpuBudget()
+{
+    std::lock_guard lock { m_mtxBudget };
+    if (nullptr != m_pBudgetGovernor)
+    {
+        m_pBudgetGovernor->Evaluate();
+    }
+}
+
+double CAssertConfig::GetCpuBudgetUsage() const
+{
+    std::lock_guard lock { m_mtxBudget };
+    return (nullptr == m_pBudgetGovernor) ? 0.0 : m_pBudgetGovernor->GetUsage();
+}
+
+[[maybe_unused]] void CAssertConfig::SetReportFormat(const EReportFormat format) noexcept
+{
+    m_eReportFormat.store(format, std::memory_order_relaxed);
+}
+
+EReportFormat CAssertConfig::GetReportFormat() const noexcept
+{
+    return m_eReportFormat.load(std::memory_order_relaxed);
+}
+
+std::string CAssertConfig::RenderMetrics() const
+{
+    return impl::CMetricsExporter::Render(IsCircuitBreakerTripped());
+}
+
+[[maybe_unused]] void CAssertConfig::StartMetricsFile(const std::string& path, const std::chrono::milliseconds period)
+{
+    std::lock_guard lock { m_mtxMetrics };
+    m_pMetricsExporter.reset();
+    if (! path.empty())
+    {
+        m_pMetricsExporter = std::make_unique<impl::CMetricsExporter>(path, period, *this);
+    }
+}
+
+[[maybe_unused]] void CAssertConfig::StartControlServer(const std::string& path)
+{
+    std::lock_guard lock { m_mtxControl };
+    m_pControlServer.reset();
+    if (path.empty())
+    {
+        return;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    m_pControlServer = std::make_unique<impl::CControlServer>(path);
+#else
+    throw std::runtime_error { "The control socket is available on POSIX platforms only." };
+#endif
+}
+
+[[maybe_unused]] void CAssertConfig::StartStatsSegment(const std::string& name, const std::chrono::milliseconds period)
+{
+    std::lock_guard lock { m_mtxStats };
+    m_pStatsSegment.reset();
+    if (name.empty())
+    {
+        return;
+    }
+#if defined(__linux__)
+    m_pStatsSegment = std::make_unique<impl::CStatsSegment>(name, period);
+#else
+    static_cast<void>(period);
+    throw std::runtime_error { "The stats segment is available on Linux only." };
+#endif
+}
+
+[[maybe_unused]] void CAssertConfig::AttachSharedControl(const std::string& name)
+{
+#if defined(__linux__)
+    const auto mirror = [this](const std::uint64_t word)
+    {
+        std::lock_guard lock { m_mtxEnable };
+        storeEnableWord(word);
+    };
+    auto& control = impl::CSharedControl::Attach(name, GetEnableWord(), mirror);
+    m_pSharedControl.store(&control, std::memory_order_release);
+#else
+    static_cast<void>(name);
+    throw std::runtime_error { "The shared control block is available on Linux only." };
+#endif
+}
+
+void CAssertConfig::loadStartupConfig() noexcept
+{
+    try
+    {
+        const char* pszFile = std::getenv("DBGH_ASSERTS_CONFIG");
+        const char* pszWatch = std::getenv("DBGH_ASSERTS_WATCH");
+        if (nullptr != pszFile && '\0' != *pszFile && nullptr != pszWatch && std::string_view { "1" } == pszWatch)
+        {
+            WatchConfigFile(pszFile);
+        }
+        else if (nullptr != pszFile && '\0' != *pszFile)
+        {
+            applyFileConfig(ReadConfigFile(pszFile));
+        }
+        else if (nullptr != std::getenv("DBGH_ASSERTS"))
+        {
+            applyFileConfig({ });
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "DBGH_ASSERTS: the configuration is ignored. " << e.what() << std::endl;
+    }
+    try
+    {
+        if (const char* pszShared = std::getenv("DBGH_ASSERTS_SHM"); nullptr != pszShared && '\0' != *pszShared)
+        {
+            AttachSharedControl(pszShared);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "DBGH_ASSERTS: the shared control block is not attached. " << e.what() << std::endl;
+    }
+    try
+    {
+        if (const char* pszStats = std::getenv("DBGH_ASSERTS_STATS"); nullptr != pszStats && '\0' != *pszStats)
+        {
+            StartStatsSegment(pszStats);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "DBGH_ASSERTS: the stats segment is not created. " << e.what() << std::endl;
+    }
+    try
+    {
+        if (const char* pszMetrics = std::getenv("DBGH_ASSERTS_METRICS"); nullptr != pszMetrics && '\0' != *pszMetrics)
+        {
+            StartMetricsFile(pszMetrics);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "DBGH_ASSERTS: the metrics file is not written. " << e.what() << std::endl;
+    }
+    try
+    {
+        if (const char* pszSocket = std::getenv("DBGH_ASSERTS_CONTROL"); nullptr != pszSocket && '\0' != *pszSocket)
+        {
+            StartControlServer(pszSocket);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "DBGH_ASSERTS: the control socket is not started. " << e.what() << std::endl;
+    }
+}
+
+void CAssertConfig::applyFileConfig(const std::string& content)
+{
+    std::string strConfig { content };
+    if (const char* pszConfig = std::getenv("DBGH_ASSERTS"); nullptr != pszConfig)
+    {
+        strConfig.append("\n").append(pszConfig);
+    }
+    auto settings = CConfigParser::Parse(strConfig);
+    CConfigParser::ResetOmitted(settings);
+    // The executor set from the code is replaced only by the file which sets the sink.
+    const auto bFileSink = settings.sink.has_value();
+    if (! bFileSink && m_bFileSink.load(std::memory_order_relaxed))
+    {
+        settings.sink = ESinkChoice::Default;
+    }
+    applySettings(std::move(settings), false);
+    m_bFileSink.store(bFileSink, std::memory_order_relaxed);
+}
+
+impl::CBurstScheduler& CAssertConfig::burstScheduler()
+{
+    std::lock_guard lock { m_mtxBurst };
+    if (nullptr == m_pBurstScheduler)
+    {
+        m_pBurstScheduler = std::make_unique<impl::CBurstScheduler>([this](const std::uint64_t set, const std::uint64_t clear)
+        {
+            return updateEnableWord([set, clear](const std::uint64_t uWord) { return (uWord | set) & ~clear; });
+        });
+    }
+    return *m_pBurstScheduler;
+}
+
+template<class TUpdate>
+std::uint64_t CAssertConfig::updateEnableWord(const TUpdate update) noexcept
+{
+#if defined(__linux__)
+    if (auto* pControl = m_pSharedControl.load(std::memory_order_acquire); nullptr != pControl)
+    {
+        // The mirror of the block stores the new word, see AttachSharedControl.
+        auto& sharedWord = pControl->EnableWord();
+        auto uWord = sharedWord.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const auto uNewWord = update(uWord);
+            if (uNewWord == uWord)
+            {
+                return uWord;
+            }
+            if (sharedWord.compare_exchange_weak(uWord, uNewWord, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        pControl->PublishEnableWord();
+        return uWord;
+    }
+#endif
+    std::lock_guard lock { m_mtxEnable };
+    const auto uWord = GetEnableWord();
+    storeEnableWord(update(uWord));
+    return uWord;
+}
+
+void CAssertConfig::storeEnableWord(const std::uint64_t word) noexcept
+{
+    CSiteRules::SetEnableWord(word);
+}
+
+void CAssertConfig::forgetBursts(const std::uint64_t bits) noexcept
+{
+    std::lock_guard lock { m_mtxBurst };
+    if (nullptr != m_pBurstScheduler)
+    {
+        m_pBurstScheduler->Forget(bits);
+    }
+}
+
+bool CAssertConfig::applyFilter(SAssertSite& site) const noexcept
+{
+    const auto uGeneration = m_uFilterGeneration.load(std::memory_order_acquire);
+    const auto filter = m_pfnFilter.load(std::memory_order_acquire);
+    const auto verdict = (nullptr == filter)
+            ? EFilterVerdict::AcceptForever
+            : filter(site, SThreadContext::Current());
+
+    std::uint32_t uCached = 0;
+    switch (verdict)
+    {
+        case EFilterVerdict::Accept:
+            return true;
+        case EFilterVerdict::Reject:
+            return false;
+        case EFilterVerdict::AcceptForever:
+            uCached = SAssertSite::FilterAccepted;
+            break;
+        case EFilterVerdict::RejectForever:
+            uCached = SAssertSite::FilterRejected;
+            break;
+        default:
+            return true;
+    }
+
+    site.flags.fetch_or(uCached, std::memory_order_relaxed);
+    if (m_uFilterGeneration.load(std::memory_order_acquire) != uGeneration)
+    {
+        // The filter was changed during the call, the verdict of the old filter must not stay in the cache.
+        site.flags.fetch_and(~SAssertSite::FilterMask, std::memory_order_relaxed);
+    }
+    return SAssertSite::FilterAccepted == uCached;
 }
 
 } // namespace dbgh
@@ -8,49 +8,75 @@
 
 #pragma once
 
-#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <memory>
 #include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
 
+#include "CAssertCategory.h"
+#include "CAssertProbe.h"
+#include "CAssertSite.h"
 #include "CHandlerExecutor.h"
+#include "CReportFormatter.h"
+#include "CRequestSampling.h"
+#include "EAssertLevel.h"
 
 namespace dbgh
 {
 
+struct SConfigSettings;
+
+namespace impl
+{
+class CBudgetGovernor;
+class CBurstScheduler;
+class CCircuitBreaker;
+class CReportBackoff;
+class CConfigWatcher;
+class CControlServer;
+class CMetricsExporter;
+class CSharedControl;
+class CStatsSegment;
+} // namespace impl
+
 /**
- * @enum       EAssertLevel
- * @brief      The described types for assertions.
+ * @enum       EFilterVerdict
+ * @brief      The decision of the filter installed in \ref dbgh::CAssertConfig::SetFilter.
  */
-enum class EAssertLevel : size_t
+enum class EFilterVerdict
 {
     /**
-     * @brief   The enum value mapped to \ref ASSERT_WARNING assert.
-     */
-    Warning,
-
-    /**
-     * @brief   The enum value mapped to \ref ASSERT_DEBUG assert.
+     * @brief   The report is formatted and passed to the executor.
      */
-    Debug,
+    Accept,
 
     /**
-     * @brief   The enum value mapped to \ref ASSERT_ERROR assert.
+     * @brief   The report is dropped before formatting.
      */
-    Error,
+    Reject,
 
     /**
-     * @brief   The enum value mapped to \ref ASSERT_FATAL assert.
+     * @brief   The report is accepted and the filter is not called again for the site.
      */
-    Fatal,
+    AcceptForever,
 
     /**
-     * @internal
-     * @breaf   An enumeration value that indicates the end of the enumeration.
+     * @brief   The report is dropped and the filter is not called again for the site.
      */
-    END_ENUM_
+    RejectForever
 };
 
 
+/**
+ * @brief      The filter for the failed assertions, called before the report is formatted.
+ */
+using TAssertFilter = EFilterVerdict (*)(const SAssertSite& site, const SThreadContext& context);
+
+
 /**
  * @class      CAssertConfig
  * @brief      This singleton class describes an assert configuration.
@@ -63,6 +89,50 @@ enum class EAssertLevel : size_t
  * @details    Allows to set of a new executor which defines assertions behavior.
  * @example    class NewExecutor : public dbgh::CHandlerExecutor { ... };
  *             dbgh::CAssertConfig::Get().SetExecutor(std::make_unique<NewExecutor>());
+ *
+ * @details    Allows to set a filter which drops the failed assertions before the report is formatted.
+ * @example    dbgh::CAssertConfig::Get().SetFilter([](const dbgh::SAssertSite& site, const dbgh::SThreadContext&)
+ *                 { return site.line < 100 ? dbgh::EFilterVerdict::RejectForever : dbgh::EFilterVerdict::Accept; });
+ *
+ * @details    Allows to enable the expensive levels and the sites for a while, see \ref EnableFor.
+ * @example    dbgh::CAssertConfig::Get().EnableFor(dbgh::EAssertLevel::Debug, std::chrono::seconds { 60 });
+ *
+ * @details    Allows to report only the 1st, 2nd, 4th, 8th... failure of the chronic warnings, see \ref SetReportBackoff.
+ * @example    dbgh::CAssertConfig::Get().SetReportBackoff(dbgh::LevelMask(dbgh::EAssertLevel::Warning));
+ *
+ * @details    Allows to stop the non-fatal reports of the process during the assertion storms, see \ref SetCircuitBreaker.
+ * @example    dbgh::CAssertConfig::Get().SetCircuitBreaker(10000.0);
+ *
+ * @details    Allows to cap the CPU time spent in the evaluation of the assert expressions.
+ * @example    dbgh::CAssertConfig::Get().SetCpuBudget(0.01);
+ *
+ * @details    At the startup reads the configuration file named by the DBGH_ASSERTS_CONFIG environment variable and
+ *              then the configuration in the DBGH_ASSERTS environment variable, see \ref Configure. The startup is the
+ *              first call of \ref Get, which may be an assertion of the static initialization: the categories
+ *              declared in the translation units not initialized yet are not known by the name then, only by the
+ *              index. Use the indexes in the startup configuration ("categories=0,1") if the asserts may fail before
+ *              main, the unknown name rejects the whole startup configuration.
+ * @example    DBGH_ASSERTS="levels=warning,error,fatal; file:net/=sampled" ./server
+ *
+ * @details    Allows to reload the configuration file when it changes, see \ref WatchConfigFile. At the startup the
+ *              file named by DBGH_ASSERTS_CONFIG is watched if DBGH_ASSERTS_WATCH is set to 1.
+ * @example    DBGH_ASSERTS_CONFIG=/etc/server/asserts.conf DBGH_ASSERTS_WATCH=1 ./server
+ *
+ * @details    Allows to list and toggle the sites of the running process with the dbgh-ctl tool, see
+ *              \ref StartControlServer. At the startup the server listens on the socket named by DBGH_ASSERTS_CONTROL.
+ * @example    DBGH_ASSERTS_CONTROL=/tmp/server.asserts ./server & dbgh-ctl /tmp/server.asserts list net/
+ *
+ * @details    Allows to scrape the assertion counters with Prometheus, see \ref RenderMetrics and \ref StartMetricsFile.
+ *              At the startup the metrics file named by DBGH_ASSERTS_METRICS is refreshed every 15 seconds.
+ * @example    DBGH_ASSERTS_METRICS=/var/lib/node_exporter/server_asserts.prom ./server
+ *
+ * @details    Allows to watch the live fire rates of the sites with the dbgh-top tool, see \ref StartStatsSegment. At the
+ *              startup the counters are published to the segment named by DBGH_ASSERTS_STATS.
+ * @example    DBGH_ASSERTS_STATS=/server.stats ./server & dbgh-top /server.stats
+ *
+ * @details    Allows to toggle the asserts of a group of processes at once through the shared-memory block, see
+ *              \ref AttachSharedControl. At the startup the process attaches to the block named by DBGH_ASSERTS_SHM.
+ * @example    DBGH_ASSERTS_SHM=/server.asserts ./server & dbgh-ctl shm:/server.asserts set "levels=error"
  */
 class CAssertConfig
 {
@@ -106,16 +176,93 @@ public:
      */
     [[maybe_unused]] void DisableAsserts(EAssertLevel level) noexcept;
 
+    /**
+     * @brief      Enables the asserts of the category of the level.
+     *
+     * @example    dbgh::CAssertConfig::Get().EnableCategory(dbgh::EAssertLevel::Debug, Storage);
+     *
+     * @param[in]  level     The level.
+     * @param[in]  category  The category, see \ref DBGH_ASSERT_CATEGORY.
+     */
+    [[maybe_unused]] void EnableCategory(EAssertLevel level, const SAssertCategory& category) noexcept;
+
+    /**
+     * @brief      Disables the asserts of the category of the level, the other categories of the level stay enabled.
+     *
+     * @example    dbgh::CAssertConfig::Get().DisableCategory(dbgh::EAssertLevel::Warning, Network);
+     *
+     * @param[in]  level     The level.
+     * @param[in]  category  The category, see \ref DBGH_ASSERT_CATEGORY.
+     */
+    [[maybe_unused]] void DisableCategory(EAssertLevel level, const SAssertCategory& category) noexcept;
+
+    /**
+     * @brief      Enables the asserts of the level for the duration, then disables them again.
+     *
+     * @details    The level is disabled by the background thread at the deadline, the assert macros do not check
+     *              the time. The categories of the level enabled before the call stay enabled after the deadline.
+     *              The repeated call extends the deadline. The level enabled or disabled explicitly before the
+     *              deadline (see \ref EnableAsserts, \ref Configure) keeps the explicit state.
+     *
+     * @example    dbgh::CAssertConfig::Get().EnableFor(dbgh::EAssertLevel::Debug, std::chrono::seconds { 60 });
+     *
+     * @param[in]  level     The level.
+     * @param[in]  duration  The duration.
+     */
+    [[maybe_unused]] void EnableFor(EAssertLevel level, std::chrono::milliseconds duration);
+
+    /**
+     * @brief      Evaluates the sites of the file and the line on every pass for the duration.
+     *
+     * @details    The sites are pinned to \ref ESiteMode::Full over the configuration rules and the CPU budget
+     *              until the deadline, as by the "site:<path>:<line>=full" rule appended to the configuration. The
+     *              sites are evaluated also if their level or category is disabled, the other sites of the level stay
+     *              disabled (see \ref CSiteRules::Enables). The zero line does not enable the sites of the disabled
+     *              levels, see \ref EnableFor.
+     *
+     * @example    dbgh::CAssertConfig::Get().EnableSiteFor("db/pool.cpp", 120, std::chrono::minutes { 5 });
+     *
+     * @param[in]  file      The path suffix of the sites, see \ref CSiteRules::MatchesPath.
+     * @param[in]  line      The line of the sites, zero matches all sites of the file.
+     * @param[in]  duration  The duration.
+     */
+    [[maybe_unused]] void EnableSiteFor(std::string_view file, TLine line, std::chrono::milliseconds duration);
+
 
     /**
      * @internal
      * @brief      Determines whether the specified level is active assert.
      *
-     * @param[in]  level  The level
+     * @details    The category of the level must be enabled in the configuration and the level must be enabled in the
+     *              level mask of the current thread, see \ref dbgh::CRequestSampling. The category and the level are
+     *              compile-time constants of the assert macros, so the bits are constants too. The disabled level
+     *              costs a relaxed load of the enable word and an AND: the word is a member of the configuration at a
+     *              fixed address (the word of the shared control block is mirrored to it, see
+     *              \ref AttachSharedControl), the thread-local level mask is loaded only if the level is enabled.
+     *             The override bit of the level (see \ref OverrideBit) is tested by the same AND: while a site rule
+     *              or \ref EnableSiteFor may enable a site of the disabled level, the sites of the level pass and
+     *              \ref CAssertProbe evaluates only the enabled ones.
+     *
+     * @param[in]  level     The level
+     * @param[in]  category  The index of the category, see \ref SAssertCategory.
      *
      * @return     True if the asserts of a given type are active, False otherwise.
      */
-    [[nodiscard]] bool IsActiveAssert(EAssertLevel level) const noexcept;
+    [[nodiscard]] bool IsActiveAssert(const EAssertLevel level, const std::uint32_t category = 0) const noexcept
+    {
+        return 0 != (m_uEnableWord.load(std::memory_order_relaxed) & (EnableBit(level, category) | OverrideBit(level)))
+               && 0 != (CRequestSampling::ThreadMask() & LevelMask(level));
+    }
+
+    /**
+     * @brief      Gets the enabled categories of the levels.
+     *
+     * @return     The enable word, see \ref EnableBit.
+     */
+    [[nodiscard]] std::uint64_t GetEnableWord() const noexcept
+    {
+        return m_uEnableWord.load(std::memory_order_relaxed) & ~OverrideWordOf(AllLevelsMask);
+    }
 
     /**
      * @brief      Sets the new executor.
@@ -133,6 +280,9 @@ public:
      * @note       SetExecutor without arguments resets the current executor to default state.
      * @example    dbgh::CAssertConfig::Get().SetExecutor();
      *
+     * @note       The executor can be replaced while other threads report through it: the previous executor is
+     *              destroyed when the last report which uses it is finished.
+     *
      * @throw      std::invalid_argument exception if the new executor is null.
      *              The exception message is "Executor cannot be null."
      *
@@ -142,25 +292,541 @@ public:
             std::unique_ptr<dbgh::CHandlerExecutor> executor = std::make_unique<dbgh::CHandlerExecutor>());
 
     /**
-     * @brief      Gets the raw pointer to the current executor.
+     * @brief      Gets the current executor.
+     *
+     * @details    The returned pointer keeps the executor alive, also if it is replaced meanwhile by
+     *              \ref SetExecutor. Hold it for the whole report, not beyond it.
+     *
+     * @return     The shared pointer to the executor.
+     */
+    [[nodiscard]] std::shared_ptr<dbgh::CHandlerExecutor> GetExecutor() const noexcept;
+
+    /**
+     * @brief      Sets the filter for the failed assertions.
+     *
+     * @details    The filter sees only the site metadata (level, file, line, function, expression) and the thread
+     *              context, it is called before the message and the report are formatted, so the rejected
+     *              assertion costs no string building.
+     *             The AcceptForever and RejectForever verdicts are cached in the site, the next failures of the site
+     *              cost one load. Setting a new filter clears all cached verdicts.
+     *
+     * @note       SetFilter without arguments removes the filter.
+     * @example    dbgh::CAssertConfig::Get().SetFilter();
+     *
+     * @param[in]  filter  The filter, or nullptr.
+     */
+    [[maybe_unused]] void SetFilter(TAssertFilter filter = nullptr) noexcept;
+
+    /**
+     * @brief      Sets the output format of the assertion reports passed to the executor.
+     *
+     * @details    By default the reports are multi-line text blocks. \ref EReportFormat::JsonLines serializes
+     *              every report as a single JSON object: level, timestamp, thread, file, line, function,
+     *              expression, uncaught and message.
+     *
+     * @example    dbgh::CAssertConfig::Get().SetReportFormat(dbgh::EReportFormat::JsonLines);
+     *
+     * @param[in]  format  The report format.
+     */
+    [[maybe_unused]] void SetReportFormat(EReportFormat format) noexcept;
+
+    /**
+     * @brief      Gets the output format of the assertion reports.
+     *
+     * @return     The report format.
+     */
+    [[nodiscard]] EReportFormat GetReportFormat() const noexcept;
+
+    /**
+     * @brief      Caps the CPU time spent in the evaluation of the assert expressions.
+     *
+     * @details    The evaluation time is measured at the sampled passes, and every period the most expensive
+     *              sites are moved to \ref ESiteMode::Sampled or \ref ESiteMode::Disabled while the cost exceeds
+     *              the budget, and moved back while it is under the half of the budget. The evaluation runs in
+     *              a background thread, the assert macros take no lock.
+     *
+     * @note       SetCpuBudget without arguments disables the budget and moves all sites back to ESiteMode::Full.
+     * @example    dbgh::CAssertConfig::Get().SetCpuBudget();
+     *
+     * @param[in]  fraction  The budget, as a fraction of the process CPU time, zero disables the budget.
+     * @param[in]  period    The period of the evaluation.
+     */
+    [[maybe_unused]] void SetCpuBudget(
+            double fraction = 0.0, std::chrono::milliseconds period = std::chrono::milliseconds { 1000 });
+
+    /**
+     * @brief      Reports only the 1st, 2nd, 4th, 8th... failure of every site of the levels, the others are counted.
+     *
+     * @details    The failures are counted per site from the call, the failures suppressed by the tripped circuit
+     *              breaker are not counted. The decision is made before the filter and before the report is
+     *              formatted, the suppressed failure costs two atomic increments.
+     *             Every period the summary thread writes one report for every site with suppressed failures in the
+     *              period, for example "The site failed 1200000 times in the last 10s, 2 of them reported.", see
+     *              \ref impl::CReportBackoff. The levels without the backoff report every failure.
+     *
+     * @note       The backoff is available for the warning and debug levels only: the report of the error and
+     *              fatal levels throws or terminates.
+     * @note       SetReportBackoff without arguments disables the backoff.
+     *
+     * @throw      std::invalid_argument exception if the mask contains the error or fatal level.
+     *
+     * @param[in]  levels         The mask of the levels, see \ref LevelMask.
+     * @param[in]  summaryPeriod  The period of the summaries.
+     */
+    [[maybe_unused]] void SetReportBackoff(
+            std::uint32_t levels = 0, std::chrono::milliseconds summaryPeriod = std::chrono::milliseconds { 10000 });
+
+    /**
+     * @brief      Stops the non-fatal reports while the aggregate failure rate of the process exceeds the threshold.
+     *
+     * @details    The failure rate of all sites is measured every period in the background thread. Over the
+     *              threshold the breaker trips: the failures of the warning, debug and error levels are only
+     *              counted, the error asserts do not throw. Under the half of the threshold it recovers. One summary
+     *              report is passed to \ref CHandlerExecutor::HandleWarning on each transition, see
+     *              \ref impl::CCircuitBreaker. The fatal failures are always reported.
+     *
+     * @note       SetCircuitBreaker without arguments disables the breaker.
+     *
+     * @param[in]  failuresPerSecond  The threshold, zero disables the breaker.
+     * @param[in]  period             The period of the measurement.
+     */
+    [[maybe_unused]] void SetCircuitBreaker(
+            double failuresPerSecond = 0.0, std::chrono::milliseconds period = std::chrono::milliseconds { 1000 });
+
+    /**
+     * @brief      Determines whether the circuit breaker is tripped, see \ref SetCircuitBreaker.
+     *
+     * @return     True if the non-fatal reports are stopped, False otherwise.
+     */
+    [[nodiscard]] bool IsCircuitBreakerTripped() const noexcept
+    {
+        return 0 != m_uTrippedLevels.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief      Applies the text configuration: levels, report format, CPU budget, sink and site rules.
+     *
+     * @details    The syntax is described in \ref CConfigParser. The settings which are not in the text keep their
+     *              state, the site rules are replaced by the rules of the text. The rules are compiled into the flags
+     *              of the sites, the assert macros do not look them up.
+     *             The text is parsed and the sink is opened before anything is applied. Then the settings are
+     *              applied one after another: the sink, the format, the budget, the backoff, the breaker and the
+     *              sketches. The levels and the site rules are published last by one switch (see
+     *              \ref CSiteRules::Set), a concurrent assertion never runs the new levels under the old rules, but
+     *              it may see the new sink with the old levels. The replaced executor stays alive until its reports
+     *              are finished, see \ref SetExecutor.
+     *
+     * @example    dbgh::CAssertConfig::Get().Configure("levels=warning,error; site:db/pool.cpp:120=off");
+     *
+     * @throw      std::invalid_argument exception if an entry is malformed, then nothing is applied.
+     *
+     * @param[in]  text  The configuration.
+     */
+    [[maybe_unused]] void Configure(std::string_view text);
+
+    /**
+     * @brief      Applies the text configuration like \ref Configure, but appends the site rules to the current ones.
+     *
+     * @details    The appended rules win over the current rules matching the same sites.
+     *
+     * @throw      std::invalid_argument exception if an entry is malformed, then nothing is applied.
+     *
+     * @param[in]  text  The configuration.
+     */
+    [[maybe_unused]] void Amend(std::string_view text);
+
+    /**
+     * @brief      Reads the configuration file and applies it, see \ref Configure.
+     *
+     * @throw      std::runtime_error exception if the file cannot be read.
+     * @throw      std::invalid_argument exception if an entry is malformed, then nothing is applied.
+     *
+     * @param[in]  path  The path of the file.
+     */
+    [[maybe_unused]] void LoadConfigFile(const std::string& path);
+
+    /**
+     * @brief      Applies the configuration file and reapplies it in the background whenever the file changes.
+     *
+     * @details    The file is applied together with the DBGH_ASSERTS environment variable, which overrides it. The
+     *              file describes the whole configuration: the keys which are not in it return to their defaults (see
+     *              \ref CConfigParser::ResetOmitted), the sink returns to the default one only if the previous
+     *              version of the file set it. The new levels and site rules are published by one switch: the
+     *              asserting threads never block and never see the rules of two versions of the file. The other
+     *              settings are applied one by one, see \ref Configure. The changed file with a malformed entry is
+     *              reported to std::cerr and ignored, the previous configuration stays. The empty path stops watching.
+     *
+     * @throw      std::runtime_error exception if the file cannot be read or the watching is not supported.
+     * @throw      std::system_error exception if the file cannot be watched.
+     * @throw      std::invalid_argument exception if an entry is malformed, then nothing is applied.
+     *
+     * @note       Available on Linux.
+     *
+     * @param[in]  path  The path of the file.
+     */
+    [[maybe_unused]] void WatchConfigFile(const std::string& path = { });
+
+    /**
+     * @brief      Starts serving the control requests on the Unix domain socket, see \ref impl::CControlServer.
+     *
+     * @details    The requests list the sites with their modes and failure counts, show the status and change the
+     *              configuration. They are served in the background thread and add nothing to the assert macros.
+     *              The empty path stops serving.
+     *
+     * @throw      std::runtime_error exception if the control socket is not supported.
+     * @throw      std::system_error exception if the socket cannot be created.
+     * @throw      std::invalid_argument exception if the path is too long.
+     *
+     * @note       Available on POSIX platforms.
+     *
+     * @param[in]  path  The path of the socket.
+     */
+    [[maybe_unused]] void StartControlServer(const std::string& path = { });
+
+    /**
+     * @brief      Renders the assertion counters per level and per site in the Prometheus text exposition format.
+     *
+     * @details    The failure, suppression, drop and evaluation counters are read without stopping the asserting
+     *              threads, see \ref impl::CMetricsExporter for the metric names.
+     *
+     * @return     The metrics.
+     */
+    [[nodiscard]] std::string RenderMetrics() const;
+
+    /**
+     * @brief      Writes the metrics (see \ref RenderMetrics) to the file and refreshes it in the background thread.
+     *
+     * @details    The file is replaced by the rename, so the scraper never reads a partial file. The empty path stops
+     *              refreshing.
+     *
+     * @param[in]  path    The path of the file.
+     * @param[in]  period  The period of the refresh.
+     */
+    [[maybe_unused]] void StartMetricsFile(
+            const std::string& path = { }, std::chrono::milliseconds period = std::chrono::milliseconds { 15000 });
+
+    /**
+     * @brief      Publishes the counters of the sites to the named shared-memory segment, see \ref impl::CStatsSegment.
+     *
+     * @details    The background thread copies the counters to the segment every period, the asserting threads do
+     *              not write to it. The readers (the dbgh-top tool) map the segment read-only. The empty name stops
+     *              publishing and removes the segment.
+     *
+     * @throw      std::runtime_error exception if the stats segment is not supported.
+     * @throw      std::system_error exception if the segment cannot be created or is published by the running
+     *              process.
+     *
+     * @note       Available on Linux.
+     *
+     * @param[in]  name    The name of the segment.
+     * @param[in]  period  The period of the publication.
+     */
+    [[maybe_unused]] void StartStatsSegment(
+            const std::string& name = { }, std::chrono::milliseconds period = std::chrono::milliseconds { 1000 });
+
+    /**
+     * @brief      Attaches the process to the named shared control block, see \ref impl::CSharedControl.
+     *
+     * @details    The processes attached to one block (for example, the pre-forked workers) share the enable
+     *              word and the site rules of the block: the writer (dbgh-ctl shm:<name> or any attached process calling
+     *              \ref EnableAsserts, \ref DisableAsserts or \ref Configure with levels) toggles the asserts of all
+     *              of them at once. The block is created with the current enable word if it does not exist.
+     *             The enable word of the block is mirrored to the enable word of the process by a thread woken on
+     *              the change, the asserting threads read the mirror and the rule words of the block with relaxed
+     *              loads, the IPC is not involved. The process stays attached until it exits.
+     *
+     * @example    dbgh::CAssertConfig::Get().AttachSharedControl("/server.asserts");
+     *
+     * @throw      std::runtime_error exception if the process is attached to another block or the shared control is
+     *              not supported.
+     * @throw      std::system_error exception if the segment cannot be opened or mapped.
+     *
+     * @note       Available on Linux.
+     *
+     * @param[in]  name  The name of the shared-memory segment.
+     */
+    [[maybe_unused]] void AttachSharedControl(const std::string& name);
+
+    /**
+     * @brief      Evaluates the CPU budget immediately, without waiting for the period.
+     */
+    [[maybe_unused]] void EvaluateCpuBudget();
+
+    /**
+     * @brief      Gets the cost of the assert expressions measured by the last budget evaluation.
+     *
+     * @return     The cost, as a fraction of the process CPU time, zero if the budget is disabled.
+     */
+    [[nodiscard]] double GetCpuBudgetUsage() const;
+
+    /**
+     * @brief      Gets the evaluation mode of the site: set by the configuration rules or chosen by the CPU budget.
+     *
+     * @param[in]  site  The assertion site, see \ref CAssertSiteRegistry::ForEach.
      *
-     * @return     The raw pointer to the executor.
+     * @return     The mode.
      */
-    [[nodiscard]] dbgh::CHandlerExecutor* GetExecutor() const noexcept;
+    [[nodiscard]] static ESiteMode GetSiteMode(const SAssertSite& site) noexcept
+    {
+        return CAssertProbe::GetEffectiveMode(site);
+    }
+
+    /**
+     * @internal
+     * @brief      Determines whether the failed assertion of the site must be reported.
+     *
+     * @param[in]  site  The site of the failed assertion.
+     *
+     * @return     True if the report must be formatted and passed to the executor, False otherwise.
+     */
+    [[nodiscard]] bool ShouldReport(SAssertSite& site) const noexcept
+    {
+        site.failures.fetch_add(1, std::memory_order_relaxed);
+        if (0 != (m_uTrippedLevels.load(std::memory_order_relaxed) & LevelMask(site.level))
+            || (0 != (m_uBackoffLevels.load(std::memory_order_relaxed) & LevelMask(site.level))
+                && ! std::has_single_bit(site.backoffFailures.fetch_add(1, std::memory_order_relaxed) + 1)))
+        {
+            site.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        const auto uVerdict = site.flags.load(std::memory_order_relaxed) & SAssertSite::FilterMask;
+        const auto bAccepted = (0 != uVerdict) ? SAssertSite::FilterAccepted == uVerdict : applyFilter(site);
+        if (! bAccepted)
+        {
+            site.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return bAccepted;
+    }
 
 private:
 
     /**
      * @internal
-     * @brief      An array that stores the state of the assertion (enabled(true) or disabled(false)).
+     * @brief      Applies the configuration of the environment and starts the control server, the errors are written
+     *              to std::cerr.
+     */
+    void loadStartupConfig() noexcept;
+
+    /**
+     * @internal
+     * @brief      Applies the content of the configuration file followed by the DBGH_ASSERTS environment variable.
+     */
+    void applyFileConfig(const std::string& content);
+
+    /**
+     * @internal
+     * @brief      Applies the parsed settings, the site rules replace or are appended to the current ones.
+     */
+    void applySettings(SConfigSettings settings, bool keepRules);
+
+    /**
+     * @internal
+     * @brief      Publishes the levels and the site rules of the settings by one switch, see \ref CSiteRules::Set.
+     *
+     * @details    The enable word is widened to the union of the old and the new words before the switch and
+     *              narrowed to the new one after it, so it admits every assert of the old and the new configuration
+     *              while the enable word of the rule slot decides.
+     */
+    void switchConfiguration(SConfigSettings& settings);
+
+    /**
+     * @internal
+     * @brief      Calls the filter for the site and caches the verdict if it is requested.
+     *
+     * @param[in]  site  The site of the failed assertion.
+     *
+     * @return     True if the report must be formatted and passed to the executor, False otherwise.
+     */
+    [[nodiscard]] bool applyFilter(SAssertSite& site) const noexcept;
+
+    /**
+     * @internal
+     * @brief      Gets the burst scheduler, creates it on the first call.
+     */
+    impl::CBurstScheduler& burstScheduler();
+
+    /**
+     * @internal
+     * @brief      Forgets the bursts of the bits of the enable word changed explicitly.
+     */
+    void forgetBursts(std::uint64_t bits) noexcept;
+
+    /**
+     * @internal
+     * @brief      Updates the enable word, the concurrent updates are not lost. While attached the word of the shared
+     *              control block is updated by CAS and the change is published to the mirrors.
+     *
+     * @param[in]  update  The function computing the new word from the current one.
+     *
+     * @return     The previous word.
+     */
+    template<class TUpdate>
+    std::uint64_t updateEnableWord(TUpdate update) noexcept;
+
+    /**
+     * @internal
+     * @brief      Stores the enable word and the enable word of the active rule slot by \ref CSiteRules, called
+     *              under \ref m_mtxEnable.
+     */
+    void storeEnableWord(std::uint64_t word) noexcept;
+
+    /**
+     * @internal
+     * @brief      The enabled categories of the levels and the override bits of the site rules, see \ref EnableBit.
+     *              The mirror of the word of the shared control block while attached, written by \ref CSiteRules.
+     */
+    std::atomic<std::uint64_t> m_uEnableWord;
+
+    /**
+     * @internal
+     * @brief      The mutex serializing the writers of the enable word of the process.
+     */
+    std::mutex m_mtxEnable;
+
+    /**
+     * @internal
+     * @brief      The attached shared control block, the writes of the enable word go to it, or null.
+     */
+    std::atomic<impl::CSharedControl*> m_pSharedControl;
+
+    /**
+     * @internal
+     * @brief      True if the last applied configuration file set the sink, its removal from the file restores the
+     *              default sink.
+     */
+    std::atomic<bool> m_bFileSink;
+
+    /**
+     * @internal
+     * @brief      The pointer to executor, replaced atomically, see \ref GetExecutor.
+     */
+    std::atomic<std::shared_ptr<dbgh::CHandlerExecutor>> m_pHandlerExecutor;
+
+    /**
+     * @internal
+     * @brief      The filter for the failed assertions, or nullptr.
+     */
+    std::atomic<TAssertFilter> m_pfnFilter;
+
+    /**
+     * @internal
+     * @brief      Incremented on every filter change, protects the cache from the verdicts of the old filter.
+     */
+    std::atomic<std::uint64_t> m_uFilterGeneration;
+
+    /**
+     * @internal
+     * @brief      The output format of the assertion reports.
+     */
+    std::atomic<EReportFormat> m_eReportFormat;
+
+    /**
+     * @internal
+     * @brief      The mask of the levels with the report backoff, see \ref SetReportBackoff.
+     */
+    std::atomic<std::uint32_t> m_uBackoffLevels;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the report backoff.
+     */
+    std::mutex m_mtxBackoff;
+
+    /**
+     * @internal
+     * @brief      The summary writer of the report backoff, or null if the backoff is disabled.
+     */
+    std::unique_ptr<impl::CReportBackoff> m_pReportBackoff;
+
+    /**
+     * @internal
+     * @brief      The mask of the levels stopped by the tripped circuit breaker, see \ref SetCircuitBreaker.
+     */
+    std::atomic<std::uint32_t> m_uTrippedLevels;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the circuit breaker.
+     */
+    std::mutex m_mtxBreaker;
+
+    /**
+     * @internal
+     * @brief      The circuit breaker, or null if it is disabled.
+     */
+    std::unique_ptr<impl::CCircuitBreaker> m_pCircuitBreaker;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the budget governor.
+     */
+    mutable std::mutex m_mtxBudget;
+
+    /**
+     * @internal
+     * @brief      The CPU budget governor, or null if the budget is disabled.
+     */
+    std::unique_ptr<impl::CBudgetGovernor> m_pBudgetGovernor;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the burst scheduler.
+     */
+    std::mutex m_mtxBurst;
+
+    /**
+     * @internal
+     * @brief      The burst scheduler, or null before the first burst.
+     */
+    std::unique_ptr<impl::CBurstScheduler> m_pBurstScheduler;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the metrics exporter.
+     */
+    std::mutex m_mtxMetrics;
+
+    /**
+     * @internal
+     * @brief      The exporter which refreshes the metrics file, or null.
+     */
+    std::unique_ptr<impl::CMetricsExporter> m_pMetricsExporter;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the stats segment.
+     */
+    std::mutex m_mtxStats;
+
+    /**
+     * @internal
+     * @brief      The segment the counters are published to, or null.
+     */
+    std::unique_ptr<impl::CStatsSegment> m_pStatsSegment;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the config watcher.
+     */
+    std::mutex m_mtxWatcher;
+
+    /**
+     * @internal
+     * @brief      The watcher of the configuration file, or null. Stopped before the members it uses.
+     */
+    std::unique_ptr<impl::CConfigWatcher> m_pConfigWatcher;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the control server.
      */
-    std::array<bool, static_cast<size_t>(EAssertLevel::END_ENUM_)> m_arrEnableFlags;
+    std::mutex m_mtxControl;
 
     /**
      * @internal
-     * @brief      The pointer to executor.
+     * @brief      The control server, or null. Declared last to be stopped first.
      */
-    std::unique_ptr<dbgh::CHandlerExecutor> m_pHandlerExecutor;
+    std::unique_ptr<impl::CControlServer> m_pControlServer;
 
 };
 
@@ -10,9 +10,15 @@
 
 #include <type_traits>
 #include <memory>
+#include <optional>
+#include <cassert>
+#include <concepts>
+#include <string>
+#include <string_view>
 
 #include "CAssertConfig.h"
 #include "CHandlerExecutor.h"
+#include "CReportFormatter.h"
 
 namespace dbgh::impl
 {
@@ -71,6 +77,7 @@ public:
      * @brief      The internal handler for the assertion.
      *             Template function specialization for Warning assert.
      *
+     * @param[in]  stamp         The time, thread and CPU captured at the failure.
      * @param[in]  message       The error description.
      * @param[in]  expression    Expression to be evaluated, as a string.
      * @param[in]  file          The filename that contains the code is a failed assertion.
@@ -81,13 +88,15 @@ public:
      */
     template<EAssertLevel T, std::enable_if_t<(EAssertLevel::Warning == T), int> = 0>
     static void HandleAssert(
-            std::string message, const char* expression, const char* file, TLine line, const char* function);
+            const SCaptureStamp& stamp, std::string message, const char* expression, const char* file, TLine line,
+            const char* function);
 
     /**
      * @internal
      * @brief      The internal handler for the assertion.
      *             Template function specialization for Debug assert.
      *
+     * @param[in]  stamp         The time, thread and CPU captured at the failure.
      * @param[in]  message       The error description.
      * @param[in]  expression    Expression to be evaluated, as a string.
      * @param[in]  file          The filename that contains the code is a failed assertion.
@@ -98,14 +107,15 @@ public:
      */
     template<EAssertLevel T, std::enable_if_t<(EAssertLevel::Debug == T), int> = 0>
     static void HandleAssert(
-            std::string message, const char* expression, const char* file, TLine line, const char* function,
-            bool& ignore);
+            const SCaptureStamp& stamp, std::string message, const char* expression, const char* file, TLine line,
+            const char* function, bool& ignore);
 
     /**
      * @internal
      * @brief      The internal handler for the assertion.
      *             Template function specialization for Error assert.
      *
+     * @param[in]  stamp         The time, thread and CPU captured at the failure.
      * @param[in]  message       The error description.
      * @param[in]  expression    Expression to be evaluated, as a string.
      * @param[in]  file          The filename that contains the code is a failed assertion.
@@ -116,13 +126,15 @@ public:
      */
     template<EAssertLevel T, std::enable_if_t<(EAssertLevel::Error == T), int> = 0>
     static void HandleAssert(
-            std::string message, const char* expression, const char* file, TLine line, const char* function);
+            const SCaptureStamp& stamp, std::string message, const char* expression, const char* file, TLine line,
+            const char* function);
 
     /**
      * @internal
      * @brief      The internal handler for the assertion.
      *             Template function specialization for Fatal assert.
      *
+     * @param[in]  stamp         The time, thread and CPU captured at the failure.
      * @param[in]  message       The error description.
      * @param[in]  expression    Expression to be evaluated, as a string.
      * @param[in]  file          The filename that contains the code is a failed assertion.
@@ -133,17 +145,148 @@ public:
      */
     template<EAssertLevel T, std::enable_if_t<(EAssertLevel::Fatal == T), int> = 0>
     static void HandleAssert(
-            std::string message, const char* expression, const char* file, TLine line, const char* function);
+            const SCaptureStamp& stamp, std::string message, const char* expression, const char* file, TLine line,
+            const char* function);
+
+    /**
+     * @internal
+     * @brief      The internal handler for the assertion, bound to the given executor.
+     *             Template function specialization for Warning assert.
+     *
+     * @details    The executor type is a template parameter, so if TExecutor is a concrete (or final) type
+     *              the executor methods are statically bound and can be inlined.
+     *
+     * @param[in]  executor      The executor which defines the assertion behavior.
+     * @param[in]  stamp         The time, thread and CPU captured at the failure.
+     * @param[in]  message       The error description.
+     * @param[in]  expression    Expression to be evaluated, as a string.
+     * @param[in]  file          The filename that contains the code is a failed assertion.
+     * @param[in]  line          The line number in the file that contains the code that is failed assertion.
+     * @param[in]  function      The function that contains the code is a failed assertion.
+     *
+     * @enum       T             The \ref EAssertLevel enum value, type of assert.
+     * @tparam     TExecutor     The executor type, see \ref dbgh::CHandlerExecutor for the required methods.
+     */
+    template<EAssertLevel T, class TExecutor, std::enable_if_t<(EAssertLevel::Warning == T), int> = 0>
+    static void HandleAssertWith(
+            TExecutor& executor, const SCaptureStamp& stamp, std::string message, const char* expression,
+            const char* file, TLine line, const char* function);
+
+    /**
+     * @internal
+     * @brief      The internal handler for the assertion, bound to the given executor.
+     *             Template function specialization for Debug assert.
+     *
+     * @param[in]  executor      The executor which defines the assertion behavior.
+     * @param[in]  stamp         The time, thread and CPU captured at the failure.
+     * @param[in]  message       The error description.
+     * @param[in]  expression    Expression to be evaluated, as a string.
+     * @param[in]  file          The filename that contains the code is a failed assertion.
+     * @param[in]  line          The line number in the file that contains the code that is failed assertion.
+     * @param[in]  function      The function that contains the code is a failed assertion.
+     *
+     * @enum       T             The \ref EAssertLevel enum value, type of assert.
+     * @tparam     TExecutor     The executor type, see \ref dbgh::CHandlerExecutor for the required methods.
+     */
+    template<EAssertLevel T, class TExecutor, std::enable_if_t<(EAssertLevel::Debug == T), int> = 0>
+    static void HandleAssertWith(
+            TExecutor& executor, const SCaptureStamp& stamp, std::string message, const char* expression,
+            const char* file, TLine line, const char* function, bool& ignore);
+
+    /**
+     * @internal
+     * @brief      The internal handler for the assertion, bound to the given executor.
+     *             Template function specialization for Error assert.
+     *
+     * @param[in]  executor      The executor which defines the assertion behavior.
+     * @param[in]  stamp         The time, thread and CPU captured at the failure.
+     * @param[in]  message       The error description.
+     * @param[in]  expression    Expression to be evaluated, as a string.
+     * @param[in]  file          The filename that contains the code is a failed assertion.
+     * @param[in]  line          The line number in the file that contains the code that is failed assertion.
+     * @param[in]  function      The function that contains the code is a failed assertion.
+     *
+     * @enum       T             The \ref EAssertLevel enum value, type of assert.
+     * @tparam     TExecutor     The executor type, see \ref dbgh::CHandlerExecutor for the required methods.
+     */
+    template<EAssertLevel T, class TExecutor, std::enable_if_t<(EAssertLevel::Error == T), int> = 0>
+    static void HandleAssertWith(
+            TExecutor& executor, const SCaptureStamp& stamp, std::string message, const char* expression,
+            const char* file, TLine line, const char* function);
+
+    /**
+     * @internal
+     * @brief      The internal handler for the assertion, bound to the given executor.
+     *             Template function specialization for Fatal assert.
+     *
+     * @param[in]  executor      The executor which defines the assertion behavior.
+     * @param[in]  stamp         The time, thread and CPU captured at the failure.
+     * @param[in]  message       The error description.
+     * @param[in]  expression    Expression to be evaluated, as a string.
+     * @param[in]  file          The filename that contains the code is a failed assertion.
+     * @param[in]  line          The line number in the file that contains the code that is failed assertion.
+     * @param[in]  function      The function that contains the code is a failed assertion.
+     *
+     * @enum       T             The \ref EAssertLevel enum value, type of assert.
+     * @tparam     TExecutor     The executor type, see \ref dbgh::CHandlerExecutor for the required methods.
+     */
+    template<EAssertLevel T, class TExecutor, std::enable_if_t<(EAssertLevel::Fatal == T), int> = 0>
+    static void HandleAssertWith(
+            TExecutor& executor, const SCaptureStamp& stamp, std::string message, const char* expression,
+            const char* file, TLine line, const char* function);
+
+    /**
+     * @internal
+     * @brief      Determines whether the message of the failed assertion is used by the installed executor.
+     *
+     * @details    The assert macros do not format the message which is not used: the executor does not report the
+     *              Warning and Fatal levels (see \ref dbgh::CHandlerExecutor::IsReported). The message of the Error
+     *              level is used by the exception, the message of the Debug level is always shown.
+     *
+     * @return     True if the message has to be formatted, False otherwise.
+     *
+     * @enum       T             The \ref EAssertLevel enum value, type of assert.
+     */
+    template<EAssertLevel T>
+    [[nodiscard]] static bool IsMessageUsed();
+
+    /**
+     * @internal
+     * @brief      Determines whether the message of the failed assertion is used by the given executor, see
+     *              \ref IsMessageUsed.
+     *
+     * @param[in]  executor      The executor which defines the assertion behavior.
+     *
+     * @return     True if the message has to be formatted, False otherwise.
+     *
+     * @enum       T             The \ref EAssertLevel enum value, type of assert.
+     * @tparam     TExecutor     The executor type, see \ref dbgh::CHandlerExecutor for the required methods.
+     */
+    template<EAssertLevel T, class TExecutor>
+    [[nodiscard]] static bool IsMessageUsedBy(const TExecutor& executor) noexcept;
 
 private:
 
     /**
      * @internal
-     * @brief      { function_description }
+     * @brief      Prompts the user, using the given executor, until a valid action is chosen.
+     *
+     * @param[in]  executor  The executor used for the communication with the user.
      *
      * @return     The e assert action.
      */
-    static EAssertAction waitForUserDecision();
+    template<class TExecutor>
+    static EAssertAction waitForUserDecision(TExecutor& executor);
+
+    /**
+     * @internal
+     * @brief      Maps the user input to the assert action.
+     *
+     * @param[in]  input  The user input.
+     *
+     * @return     The assert action, or std::nullopt if the input is not valid.
+     */
+    static std::optional<EAssertAction> toAssertAction(char input);
 
     /**
      * @internal
@@ -153,39 +296,206 @@ private:
      */
     [[noreturn]] static void startDebugging();
 
+    /**
+     * @internal
+     * @brief      Determines whether the executor uses the reports of the level, the executor without the
+     *              IsReported method uses all reports.
+     *
+     * @param[in]  executor  The executor.
+     *
+     * @return     True if the report has to be formatted, False otherwise.
+     */
+    template<EAssertLevel T, class TExecutor>
+    static bool isReported(const TExecutor& executor) noexcept;
+
+    /**
+     * @internal
+     * @brief      Shows the report to the user with ShowReport, or with ShowMessage if the executor has no ShowReport.
+     *
+     * @param[in]  executor  The executor.
+     * @param[in]  report    The formatted report.
+     */
+    template<EAssertLevel T, class TExecutor>
+    static void showReport(TExecutor& executor, std::string_view report);
+
     /**
      * @internal
      * @brief      Merges information about assertion.
      *
      * @param[in]  level         The assert level.
+     * @param[in]  stamp         The time, thread and CPU captured at the failure.
      * @param[in]  message       The error description.
      * @param[in]  expression    Expression to be evaluated, as a string.
      * @param[in]  file          The filename that contains the code is a failed assertion.
      * @param[in]  line          The line number in the file that contains the code that is failed assertion.
      * @param[in]  function      The function that contains the code is a failed assertion.
      *
-     * @return     Merged information as a string.
+     * @note       The report holds the buffer of the thread until it is destroyed, the reports formatted meanwhile
+     *              (for example, by the executor which asserts) do not overwrite it.
+     *
+     * @return     Merged information, formatted according to \ref dbgh::CAssertConfig::SetReportFormat.
      */
-    static std::string margeAssertInfo(
-            EAssertLevel level, const std::string& message, const char* expression, const char* file, TLine line,
-            const char* function);
+    static CFormattedReport margeAssertInfo(
+            EAssertLevel level, const SCaptureStamp& stamp, const std::string& message, const char* expression,
+            const char* file, TLine line, const char* function);
+};
 
-private:
 
+template<EAssertLevel T, class TExecutor, std::enable_if_t<(EAssertLevel::Warning == T), int>>
+inline void CAssertHandler::HandleAssertWith(
+        TExecutor& executor, const SCaptureStamp& stamp, std::string message, const char* expression, const char* file,
+        TLine line, const char* function)
+{
+    if (! isReported<T>(executor))
+    {
+        return;
+    }
+    executor.HandleWarning(margeAssertInfo(T, stamp, message, expression, file, line, function));
+}
+
+template<EAssertLevel T, class TExecutor, std::enable_if_t<(EAssertLevel::Debug == T), int>>
+inline void CAssertHandler::HandleAssertWith(
+        TExecutor& executor, const SCaptureStamp& stamp, std::string message, const char* expression, const char* file,
+        TLine line, const char* function, bool& ignore)
+{
+    executor.DebugPreCall();
 
-};
+    const std::string strInfo { margeAssertInfo(T, stamp, message, expression, file, line, function) };
+
+    showReport<T>(executor, strInfo);
+
+    const auto action = waitForUserDecision(executor);
+    switch (action)
+    {
+        case EAssertAction::Abort:
+            executor.Terminate(strInfo);
+            break;
+        case EAssertAction::Throw:
+            throw CAssertException { message, expression, file, line, function };
+            break;
+        case EAssertAction::Debug:
+            startDebugging();
+            break;
+        case EAssertAction::Ignore:
+            return;
+        case EAssertAction::IgnoreForever:
+            ignore = true;
+            break;
+        default:
+            assert(false);
+    }
+}
+
+template<EAssertLevel T, class TExecutor, std::enable_if_t<(EAssertLevel::Error == T), int>>
+inline void CAssertHandler::HandleAssertWith(
+        TExecutor& executor, const SCaptureStamp& stamp, std::string message, const char* expression, const char* file,
+        TLine line, const char* function)
+{
+    if (isReported<T>(executor))
+    {
+        const auto assertInfo = margeAssertInfo(T, stamp, message, expression, file, line, function);
+        executor.HandleError(assertInfo, CAssertException { std::move(message), expression, file, line, function });
+        return;
+    }
+    executor.HandleError({ }, CAssertException { std::move(message), expression, file, line, function });
+}
+
+template<EAssertLevel T, class TExecutor, std::enable_if_t<(EAssertLevel::Fatal == T), int>>
+inline void CAssertHandler::HandleAssertWith(
+        TExecutor& executor, const SCaptureStamp& stamp, std::string message, const char* expression, const char* file,
+        TLine line, const char* function)
+{
+    if (isReported<T>(executor))
+    {
+        executor.Terminate(margeAssertInfo(T, stamp, message, expression, file, line, function));
+        return;
+    }
+    executor.Terminate({ });
+}
+
+template<EAssertLevel T>
+inline bool CAssertHandler::IsMessageUsed()
+{
+    if constexpr (EAssertLevel::Error == T || EAssertLevel::Debug == T)
+    {
+        return true;
+    }
+    else
+    {
+        return isReported<T>(*CAssertConfig::Get().GetExecutor());
+    }
+}
+
+template<EAssertLevel T, class TExecutor>
+inline bool CAssertHandler::IsMessageUsedBy(const TExecutor& executor) noexcept
+{
+    if constexpr (EAssertLevel::Error == T || EAssertLevel::Debug == T)
+    {
+        return true;
+    }
+    else
+    {
+        return isReported<T>(executor);
+    }
+}
+
+template<EAssertLevel T, class TExecutor>
+inline bool CAssertHandler::isReported(const TExecutor& executor) noexcept
+{
+    if constexpr (requires { { executor.IsReported(T) } -> std::convertible_to<bool>; })
+    {
+        return executor.IsReported(T);
+    }
+    else
+    {
+        return true;
+    }
+}
+
+template<EAssertLevel T, class TExecutor>
+inline void CAssertHandler::showReport(TExecutor& executor, std::string_view report)
+{
+    if constexpr (requires { executor.ShowReport(T, report); })
+    {
+        executor.ShowReport(T, report);
+    }
+    else
+    {
+        executor.ShowMessage(report);
+    }
+}
+
+template<class TExecutor>
+auto CAssertHandler::waitForUserDecision(TExecutor& executor) -> EAssertAction
+{
+    using namespace std::string_view_literals;
+
+    executor.ShowMessage(
+            "Press (I/i) - Ignore / (F/f) - Ignore forever / (D/d) - Debug / (T/t) - Throw exception / (B/b) - Abort \n"sv);
+
+    for (;;)
+    {
+        const auto action = toAssertAction(executor.GetUserInput());
+        if (! action.has_value())
+        {
+            executor.ShowMessage("ERROR: Invalid action, please try again.\n"sv);
+            continue;
+        }
+        return *action;
+    }
+}
 
 
-extern template void
-CAssertHandler::HandleAssert<EAssertLevel::Warning>(std::string, const char*, const char*, TLine, const char*);
+extern template void CAssertHandler::HandleAssert<EAssertLevel::Warning>(
+        const SCaptureStamp&, std::string, const char*, const char*, TLine, const char*);
 
-extern template void
-CAssertHandler::HandleAssert<EAssertLevel::Debug>(std::string, const char*, const char*, TLine, const char*, bool&);
+extern template void CAssertHandler::HandleAssert<EAssertLevel::Debug>(
+        const SCaptureStamp&, std::string, const char*, const char*, TLine, const char*, bool&);
 
-extern template void
-CAssertHandler::HandleAssert<EAssertLevel::Error>(std::string, const char*, const char*, TLine, const char*);
+extern template void CAssertHandler::HandleAssert<EAssertLevel::Error>(
+        const SCaptureStamp&, std::string, const char*, const char*, TLine, const char*);
 
-extern template void
-CAssertHandler::HandleAssert<EAssertLevel::Fatal>(std::string, const char*, const char*, TLine, const char*);
+extern template void CAssertHandler::HandleAssert<EAssertLevel::Fatal>(
+        const SCaptureStamp&, std::string, const char*, const char*, TLine, const char*);
 
 } // namespace dbgh
@@ -0,0 +1,479 @@
+/**
+ * @file        CAssertProbe.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for ESiteMode enum and CAssertProbe class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "CAssertProfiler.h"
+#include "CAssertSite.h"
+#include "CCaptureClock.h"
+
+namespace dbgh
+{
+
+/**
+ * @enum       ESiteMode
+ * @brief      The evaluation modes of the assertion site, chosen by the CPU budget governor.
+ */
+enum class ESiteMode
+{
+    /**
+     * @brief   The expression is evaluated on every pass.
+     */
+    Full,
+
+    /**
+     * @brief   The expression is evaluated on one of \ref CAssertProbe::SampleRate passes.
+     */
+    Sampled,
+
+    /**
+     * @brief   The expression is not evaluated.
+     */
+    Disabled
+};
+
+
+/**
+ * @class      CAssertProbe
+ * @brief      Decides whether the expression of the site is evaluated and measures the cost of the evaluation.
+ *
+ * @details    The probe lives for one pass of the assert macro:
+ *              if ( probe.ShouldEvaluate() && ! probe.Finish(bool(expression)) ) { ... }
+ *             While the CPU budget is enabled, one of \ref TimingRate evaluations of the Full site (chosen by a
+ *              per-thread pseudo-random generator) is timed and the time, scaled by the rate, is added to the site
+ *              counter. Every evaluation of the Sampled site is timed.
+ *              The counters are collected by \ref CAssertConfig::EvaluateCpuBudget, the pass takes no lock.
+ *             The site modes are also set by the configuration rules (see \ref CAssertConfig::Configure), the
+ *              Sampled site of the rule evaluates one of its own rate passes and is not timed.
+ *             The rules of the shared control block (see \ref CAssertConfig::AttachSharedControl) are read from the
+ *              rule word of the site in the block and win over the rules of the process.
+ *             Every rule slot has its enable word, see \ref PublishRules. The probe does not evaluate the site whose
+ *              level and category are disabled in the enable word of the slot it reads, unless the rule of the slot
+ *              enables it (see \ref SAssertSite::RuleEnabled), so the levels and the rules of the configuration are
+ *              switched together.
+ *             While neither the budget nor the rules are set, all sites are in \ref ESiteMode::Full and the probe
+ *              costs one acquire load (a plain load on x86) and a relaxed load of the enable word of the slot.
+ *             With the DBGH_ASSERTS_PROFILE definition every evaluation is timed and recorded in
+ *              \ref CAssertProfiler.
+ *             The site demoted at compile time (see \ref CSiteDemotions) passes \ref ESiteMode::Sampled as the
+ *              compiled mode, then it is evaluated as Sampled also while the budget is disabled or the site is Full.
+ */
+class CAssertProbe
+{
+public:
+
+    /**
+     * @brief      The Sampled site evaluates the expression on one of SampleRate passes, must be a power of two.
+     */
+    static constexpr std::uint32_t SampleRate = 64;
+
+    /**
+     * @brief      One of TimingRate evaluations of the Full site is timed, must be a power of two.
+     */
+    static constexpr std::uint32_t TimingRate = 64;
+
+    /**
+     * @brief      Makes the decision for the current pass.
+     *
+     * @param[in]  site          The assertion site.
+     * @param[in]  compiledMode  The lowest mode of the site, chosen at compile time.
+     */
+    explicit CAssertProbe(SAssertSite& site, const ESiteMode compiledMode = ESiteMode::Full) noexcept
+            : m_site { site },
+            m_uStart { 0 },
+            m_uWeight { 0 },
+            m_bEvaluate { true }
+    {
+        const auto uCompiledMode = (ESiteMode::Sampled == compiledMode) ? SAssertSite::ModeSampled : 0;
+        const auto uActive = s_uActive.load(std::memory_order_acquire);
+        const auto uEnableWord = s_arrEnableWords[activeSlot(uActive)].load(std::memory_order_relaxed);
+        if (0 == (uEnableWord & EnableBit(site.level, site.category))
+            && 0 == (ruleOf(site, site.flags.load(std::memory_order_relaxed), uActive) & SAssertSite::RuleEnabled))
+        {
+            // The pass which checked the previous enable word, or the override bit of the level, reads the slot of
+            // the new configuration.
+            m_bEvaluate = false;
+            return;
+        }
+        if (0 != uActive)
+        {
+            const auto bBudget = 0 != (uActive & ActiveBudget);
+            const auto uFlags = site.flags.load(std::memory_order_relaxed);
+            const auto uRule = ruleOf(site, uFlags, uActive);
+            auto uMode = (0 != (uRule & SAssertSite::RulePinned)) ? ruleMode(uRule) : uFlags & SAssertSite::ModeMask;
+            if (0 == uMode)
+            {
+                uMode = uCompiledMode;
+            }
+            if (0 == uMode)
+            {
+                m_uWeight = (bBudget && 0 == (nextRandom() & (TimingRate - 1))) ? TimingRate : 0;
+            }
+            else
+            {
+                // The sampled evaluations are rare, all of them are timed.
+                const auto uRateShift = (uRule & SAssertSite::RuleRateMask) >> SAssertSite::RuleRateShift;
+                const auto uSampleMask = (0 == uRateShift) ? SampleRate - 1 : (std::uint32_t { 1 } << uRateShift) - 1;
+                m_bEvaluate = (SAssertSite::ModeSampled == uMode) && 0 == (nextRandom() & uSampleMask);
+                m_uWeight = (bBudget && m_bEvaluate) ? 1 : 0;
+            }
+        }
+        else if (0 != uCompiledMode)
+        {
+            m_bEvaluate = 0 == (nextRandom() & (SampleRate - 1));
+        }
+#if defined(DBGH_ASSERTS_PROFILE)
+        if (m_bEvaluate)
+        {
+            m_uStart = CCaptureClock::Ticks();
+        }
+#else
+        if (0 != m_uWeight)
+        {
+            m_uStart = CCaptureClock::Ticks();
+        }
+#endif
+    }
+
+    CAssertProbe(CAssertProbe&&) = delete;
+
+    CAssertProbe(const CAssertProbe&) = delete;
+
+    CAssertProbe& operator=(CAssertProbe&&) = delete;
+
+    CAssertProbe& operator=(const CAssertProbe&) = delete;
+
+    /**
+     * @brief      Determines whether the expression must be evaluated in this pass.
+     *
+     * @return     True if the expression must be evaluated, False otherwise.
+     */
+    [[nodiscard]] bool ShouldEvaluate() const noexcept
+    {
+        return m_bEvaluate;
+    }
+
+    /**
+     * @brief      Completes the measurement, the argument is the value of the evaluated expression.
+     *
+     * @param[in]  result  The value of the expression.
+     *
+     * @return     The result.
+     */
+    bool Finish(const bool result) noexcept
+    {
+#if defined(DBGH_ASSERTS_PROFILE)
+        const auto uTicks = CCaptureClock::Ticks() - m_uStart;
+        CAssertProfiler::RecordEvaluation(m_site, uTicks);
+        if (0 != m_uWeight)
+        {
+            m_site.evaluationTicks.fetch_add(uTicks * m_uWeight, std::memory_order_relaxed);
+        }
+#else
+        if (0 != m_uWeight)
+        {
+            const auto uTicks = CCaptureClock::Ticks() - m_uStart;
+            m_site.evaluationTicks.fetch_add(uTicks * m_uWeight, std::memory_order_relaxed);
+        }
+#endif
+        return result;
+    }
+
+    /**
+     * @internal
+     * @brief      Enables the mode decisions and the timing, set by \ref CAssertConfig::SetCpuBudget.
+     *
+     * @param[in]  enabled  True to enable.
+     */
+    static void SetBudgetEnabled(const bool enabled) noexcept
+    {
+        setActive(ActiveBudget, enabled);
+    }
+
+    /**
+     * @internal
+     * @brief      Gets the index of the rule slot read by the asserting threads.
+     *
+     * @return     The index of the slot, 0 or 1.
+     */
+    [[nodiscard]] static std::uint32_t ActiveRuleSlot() noexcept
+    {
+        return activeSlot(s_uActive.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @internal
+     * @brief      Sets the enable word of the slot, set by \ref CSiteRules.
+     *
+     * @param[in]  slot  The index of the slot, 0 or 1.
+     * @param[in]  word  The enable word, see \ref EnableBit.
+     */
+    static void SetEnableWord(const std::uint32_t slot, const std::uint64_t word) noexcept
+    {
+        s_arrEnableWords[slot].store(word, std::memory_order_relaxed);
+    }
+
+    /**
+     * @internal
+     * @brief      Publishes the rules and the enable word written to the slot, set by \ref CSiteRules.
+     *
+     * @details    The release store orders the writes of the slot before the switch, the asserting threads see the
+     *              rules and the enable word of one slot.
+     *
+     * @param[in]  enabled  True if the slot contains rules.
+     * @param[in]  slot     The index of the slot, 0 or 1.
+     */
+    static void PublishRules(const bool enabled, const std::uint32_t slot) noexcept
+    {
+        const auto uSet = (enabled ? ActiveRules : 0) | (0 != slot ? ActiveSlotBit : 0);
+        auto uActive = s_uActive.load(std::memory_order_relaxed);
+        while (! s_uActive.compare_exchange_weak(
+                uActive, (uActive & ~(ActiveRules | ActiveSlotBit)) | uSet, std::memory_order_release))
+        {
+        }
+    }
+
+    /**
+     * @internal
+     * @brief      Enables the rules of the shared control block, set by \ref impl::CSharedControl.
+     *
+     * @param[in]  enabled  True to enable.
+     */
+    static void SetSharedEnabled(const bool enabled) noexcept
+    {
+        setActive(ActiveShared, enabled);
+    }
+
+    /**
+     * @brief      Gets the rule of the configuration published for the site, the pinned rule of the shared control
+     *              block wins over the rule of the process.
+     *
+     * @param[in]  site  The assertion site.
+     *
+     * @return     The rule bits, zero if the site matches no rule.
+     */
+    [[nodiscard]] static std::uint32_t GetRule(const SAssertSite& site) noexcept
+    {
+        return ruleOf(site, site.flags.load(std::memory_order_relaxed), s_uActive.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief      Gets the evaluation mode of the site: the mode of the rule if the site matches a rule, otherwise
+     *              the mode chosen by the CPU budget governor.
+     *
+     * @param[in]  site  The assertion site.
+     *
+     * @return     The mode.
+     */
+    [[nodiscard]] static ESiteMode GetEffectiveMode(const SAssertSite& site) noexcept
+    {
+        const auto uRule = GetRule(site);
+        if (0 == (uRule & SAssertSite::RulePinned))
+        {
+            return GetMode(site);
+        }
+        switch (ruleMode(uRule))
+        {
+            case SAssertSite::ModeSampled:
+                return ESiteMode::Sampled;
+            case SAssertSite::ModeDisabled:
+                return ESiteMode::Disabled;
+            default:
+                return ESiteMode::Full;
+        }
+    }
+
+    /**
+     * @brief      Gets the evaluation mode of the site.
+     *
+     * @param[in]  site  The assertion site.
+     *
+     * @return     The mode.
+     */
+    [[nodiscard]] static ESiteMode GetMode(const SAssertSite& site) noexcept
+    {
+        switch (site.flags.load(std::memory_order_relaxed) & SAssertSite::ModeMask)
+        {
+            case SAssertSite::ModeSampled:
+                return ESiteMode::Sampled;
+            case SAssertSite::ModeDisabled:
+                return ESiteMode::Disabled;
+            default:
+                return ESiteMode::Full;
+        }
+    }
+
+    /**
+     * @internal
+     * @brief      Sets the evaluation mode of the site.
+     *
+     * @param[in]  site  The assertion site.
+     * @param[in]  mode  The mode.
+     */
+    static void SetMode(SAssertSite& site, const ESiteMode mode) noexcept
+    {
+        std::uint32_t uMode = 0;
+        switch (mode)
+        {
+            case ESiteMode::Sampled:
+                uMode = SAssertSite::ModeSampled;
+                break;
+            case ESiteMode::Disabled:
+                uMode = SAssertSite::ModeDisabled;
+                break;
+            case ESiteMode::Full:
+                [[fallthrough]];
+            default:
+                break;
+        }
+        auto uFlags = site.flags.load(std::memory_order_relaxed);
+        while (! site.flags.compare_exchange_weak(
+                uFlags, (uFlags & ~SAssertSite::ModeMask) | uMode, std::memory_order_relaxed))
+        {
+        }
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      The bit of \ref s_uActive set while the CPU budget is enabled.
+     */
+    static constexpr std::uint32_t ActiveBudget = 1u << 0u;
+
+    /**
+     * @internal
+     * @brief      The bit of \ref s_uActive set while the configuration has site rules.
+     */
+    static constexpr std::uint32_t ActiveRules = 1u << 1u;
+
+    /**
+     * @internal
+     * @brief      The bit of \ref s_uActive which selects the rule slot read by the asserting threads.
+     */
+    static constexpr std::uint32_t ActiveSlotBit = 1u << 2u;
+
+    /**
+     * @internal
+     * @brief      The bit of \ref s_uActive set while the process is attached to the shared control block.
+     */
+    static constexpr std::uint32_t ActiveShared = 1u << 3u;
+
+    /**
+     * @internal
+     * @brief      Gets the index of the active rule slot from the value of \ref s_uActive.
+     */
+    static constexpr std::uint32_t activeSlot(const std::uint32_t uActive) noexcept
+    {
+        return (0 != (uActive & ActiveSlotBit)) ? 1 : 0;
+    }
+
+    /**
+     * @internal
+     * @brief      Gets the rule bits of the site from its flags and the value of \ref s_uActive.
+     */
+    static std::uint32_t ruleOf(const SAssertSite& site, const std::uint32_t uFlags, const std::uint32_t uActive) noexcept
+    {
+        if (0 != (uActive & ActiveShared))
+        {
+            if (const auto* pShared = site.sharedRule.load(std::memory_order_acquire); nullptr != pShared)
+            {
+                if (const auto uShared = pShared->load(std::memory_order_relaxed); 0 != (uShared & SAssertSite::RulePinned))
+                {
+                    return uShared;
+                }
+            }
+        }
+        return (0 != (uActive & ActiveRules)) ? SAssertSite::RuleOf(uFlags, activeSlot(uActive)) : 0;
+    }
+
+    /**
+     * @internal
+     * @brief      Converts the mode of the rule to the mode bits of the site.
+     */
+    static constexpr std::uint32_t ruleMode(const std::uint32_t uRule) noexcept
+    {
+        return (uRule & (SAssertSite::RuleSampled | SAssertSite::RuleDisabled)) << 2u;
+    }
+
+    /**
+     * @internal
+     * @brief      Sets or clears the bit of \ref s_uActive.
+     */
+    static void setActive(const std::uint32_t uBit, const bool enabled) noexcept
+    {
+        if (enabled)
+        {
+            s_uActive.fetch_or(uBit, std::memory_order_relaxed);
+        }
+        else
+        {
+            s_uActive.fetch_and(~uBit, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @internal
+     * @brief      Gets the next value of the per-thread xorshift generator.
+     */
+    static std::uint32_t nextRandom() noexcept
+    {
+        thread_local std::uint32_t t_uState = CCaptureClock::CurrentThreadId() * 2654435761u | 1u;
+        t_uState ^= t_uState << 13u;
+        t_uState ^= t_uState >> 17u;
+        t_uState ^= t_uState << 5u;
+        return t_uState;
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      The assertion site.
+     */
+    SAssertSite& m_site;
+
+    /**
+     * @internal
+     * @brief      The clock value at the start of the timed evaluation.
+     */
+    std::uint64_t m_uStart;
+
+    /**
+     * @internal
+     * @brief      The count of the evaluations represented by the timed one, zero if the evaluation is not timed.
+     */
+    std::uint32_t m_uWeight;
+
+    /**
+     * @internal
+     * @brief      True if the expression must be evaluated.
+     */
+    bool m_bEvaluate;
+
+    /**
+     * @internal
+     * @brief      The sources of the site modes: the CPU budget, the configuration rules and their active slot.
+     */
+    static inline std::atomic<std::uint32_t> s_uActive { 0 };
+
+    /**
+     * @internal
+     * @brief      The enable words of the rule slots, all levels are enabled until the configuration publishes its
+     *              word.
+     */
+    static inline std::array<std::atomic<std::uint64_t>, 2> s_arrEnableWords {
+            ~std::uint64_t { 0 }, ~std::uint64_t { 0 } };
+
+}; // class CAssertProbe
+
+} // namespace dbgh
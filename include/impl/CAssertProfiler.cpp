@@ -0,0 +1,382 @@
+/**
+ * @file        CAssertProfiler.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CAssertProfiler class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+#include "CAssertProfiler.h"
+
+namespace dbgh
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The count of the sites in one chunk of the per-thread storage.
+ */
+constexpr std::size_t s_uChunkSize = 64;
+
+/**
+ * @internal
+ * @brief      The maximum count of the chunks, the sites with the bigger id are not profiled.
+ */
+constexpr std::size_t s_uChunkCount = 1024;
+
+/**
+ * @internal
+ * @brief      The counters of one kind of the measurements, written only by the owning thread.
+ */
+struct SCounters
+{
+    std::atomic<std::uint64_t> count { 0 };
+    std::atomic<std::uint64_t> ticks { 0 };
+    std::array<std::atomic<std::uint64_t>, CAssertProfiler::BucketCount> histogram { };
+
+    /**
+     * @internal
+     * @brief      Adds the measurement, the owner is the only writer so the update is not a read-modify-write.
+     */
+    void Add(const std::uint64_t uTicks) noexcept
+    {
+        const auto increment = [](std::atomic<std::uint64_t>& counter, const std::uint64_t uValue)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + uValue, std::memory_order_relaxed);
+        };
+        const auto uBucket = std::min<std::size_t>(std::bit_width(uTicks), CAssertProfiler::BucketCount - 1);
+        increment(count, 1);
+        increment(ticks, uTicks);
+        increment(histogram[uBucket], 1);
+    }
+
+    /**
+     * @internal
+     * @brief      Adds the counters to the aggregated cost.
+     */
+    void AddTo(CAssertProfiler::SCost& cost) const noexcept
+    {
+        cost.count += count.load(std::memory_order_relaxed);
+        cost.ticks += ticks.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < CAssertProfiler::BucketCount; ++i)
+        {
+            cost.histogram[i] += histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @internal
+     * @brief      Adds the other counters, used for the merge of the finished thread.
+     */
+    void Merge(const SCounters& other) noexcept
+    {
+        const auto merge = [](std::atomic<std::uint64_t>& counter, const std::atomic<std::uint64_t>& source)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + source.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+        };
+        merge(count, other.count);
+        merge(ticks, other.ticks);
+        for (std::size_t i = 0; i < CAssertProfiler::BucketCount; ++i)
+        {
+            merge(histogram[i], other.histogram[i]);
+        }
+    }
+};
+
+/**
+ * @internal
+ * @brief      The counters of one site.
+ */
+struct SSiteCounters
+{
+    SCounters evaluation;
+    SCounters handler;
+};
+
+/**
+ * @internal
+ * @brief      The counters of all sites of one thread, allocated by chunks when the site is first measured.
+ */
+class CThreadProfile
+{
+public:
+
+    ~CThreadProfile()
+    {
+        for (auto& chunk : m_arrChunks)
+        {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    SSiteCounters* Get(const std::uint32_t siteId) noexcept
+    {
+        const auto uChunk = siteId / s_uChunkSize;
+        if (uChunk >= s_uChunkCount)
+        {
+            return nullptr;
+        }
+        auto* pChunk = m_arrChunks[uChunk].load(std::memory_order_relaxed);
+        if (nullptr == pChunk)
+        {
+            pChunk = new (std::nothrow) SSiteCounters[s_uChunkSize];
+            if (nullptr == pChunk)
+            {
+                return nullptr;
+            }
+            m_arrChunks[uChunk].store(pChunk, std::memory_order_release);
+        }
+        return pChunk + siteId % s_uChunkSize;
+    }
+
+    const SSiteCounters* Find(const std::uint32_t siteId) const noexcept
+    {
+        const auto uChunk = siteId / s_uChunkSize;
+        if (uChunk >= s_uChunkCount)
+        {
+            return nullptr;
+        }
+        const auto* pChunk = m_arrChunks[uChunk].load(std::memory_order_acquire);
+        return (nullptr == pChunk) ? nullptr : pChunk + siteId % s_uChunkSize;
+    }
+
+    void MergeTo(CThreadProfile& target) const noexcept
+    {
+        for (std::size_t uChunk = 0; uChunk < s_uChunkCount; ++uChunk)
+        {
+            const auto* pChunk = m_arrChunks[uChunk].load(std::memory_order_acquire);
+            for (std::size_t i = 0; nullptr != pChunk && i < s_uChunkSize; ++i)
+            {
+                auto* pTarget = target.Get(static_cast<std::uint32_t>(uChunk * s_uChunkSize + i));
+                if (nullptr != pTarget)
+                {
+                    pTarget->evaluation.Merge(pChunk[i].evaluation);
+                    pTarget->handler.Merge(pChunk[i].handler);
+                }
+            }
+        }
+    }
+
+private:
+
+    std::array<std::atomic<SSiteCounters*>, s_uChunkCount> m_arrChunks { };
+};
+
+/**
+ * @internal
+ * @brief      The profiles of the live threads and the merged profile of the finished ones.
+ */
+struct SProfileRegistry
+{
+    std::mutex mtx;
+    std::vector<CThreadProfile*> vecLive;
+    CThreadProfile retired;
+};
+
+/**
+ * @internal
+ * @brief      Gets the registry, the first call schedules the top report at the exit.
+ */
+SProfileRegistry& Registry()
+{
+    static SProfileRegistry registry;
+#if defined(DBGH_ASSERTS_PROFILE)
+    // Registered after the registry is constructed, so it runs before the registry is destroyed.
+    [[maybe_unused]] static const bool s_bReportScheduled = []
+    {
+        return 0 == std::atexit([]
+        {
+            CAssertProfiler::WriteTopReport(std::cerr);
+            if (const char* pszFile = std::getenv("DBGH_ASSERTS_PROFILE_FILE"); nullptr != pszFile)
+            {
+                std::ofstream file { pszFile, std::ios::trunc };
+                CAssertProfiler::WriteProfile(file);
+            }
+        });
+    }();
+#endif
+    return registry;
+}
+
+/**
+ * @internal
+ * @brief      Registers the profile of the thread and merges it into the common one when the thread finishes.
+ */
+class CThreadProfileHandle
+{
+public:
+
+    CThreadProfileHandle()
+            : m_pProfile { std::make_unique<CThreadProfile>() }
+    {
+        auto& registry = Registry();
+        std::lock_guard lock { registry.mtx };
+        registry.vecLive.push_back(m_pProfile.get());
+    }
+
+    ~CThreadProfileHandle()
+    {
+        auto& registry = Registry();
+        std::lock_guard lock { registry.mtx };
+        m_pProfile->MergeTo(registry.retired);
+        std::erase(registry.vecLive, m_pProfile.get());
+    }
+
+    CThreadProfileHandle(CThreadProfileHandle&&) = delete;
+
+    CThreadProfileHandle(const CThreadProfileHandle&) = delete;
+
+    CThreadProfileHandle& operator=(CThreadProfileHandle&&) = delete;
+
+    CThreadProfileHandle& operator=(const CThreadProfileHandle&) = delete;
+
+    CThreadProfile& Profile() noexcept
+    {
+        return *m_pProfile;
+    }
+
+private:
+
+    std::unique_ptr<CThreadProfile> m_pProfile;
+};
+
+/**
+ * @internal
+ * @brief      Gets the counters of the site in the current thread, null if the site id is out of range.
+ */
+SSiteCounters* ThreadCounters(const SAssertSite& site) noexcept
+{
+    thread_local CThreadProfileHandle t_handle;
+    return t_handle.Profile().Get(site.id);
+}
+}  // unnamed namespace
+
+std::uint64_t CAssertProfiler::SCost::Quantile(const double quantile) const noexcept
+{
+    const auto dTarget = quantile * static_cast<double>(count);
+    std::uint64_t uSeen = 0;
+    for (std::size_t i = 0; i < BucketCount; ++i)
+    {
+        uSeen += histogram[i];
+        if (0 != histogram[i] && static_cast<double>(uSeen) >= dTarget)
+        {
+            return (std::uint64_t { 1 } << i) - 1;
+        }
+    }
+    return 0;
+}
+
+void CAssertProfiler::RecordEvaluation(const SAssertSite& site, const std::uint64_t ticks) noexcept
+{
+    if (auto* pCounters = ThreadCounters(site); nullptr != pCounters)
+    {
+        pCounters->evaluation.Add(ticks);
+    }
+}
+
+void CAssertProfiler::RecordHandler(const SAssertSite& site, const std::uint64_t ticks) noexcept
+{
+    if (auto* pCounters = ThreadCounters(site); nullptr != pCounters)
+    {
+        pCounters->handler.Add(ticks);
+    }
+}
+
+auto CAssertProfiler::Collect() -> std::vector<SSiteProfile>
+{
+    auto& registry = Registry();
+    std::lock_guard lock { registry.mtx };
+
+    std::vector<SSiteProfile> vecProfiles;
+    CAssertSiteRegistry::ForEach([&](const SAssertSite& site)
+    {
+        SSiteProfile profile;
+        profile.pSite = &site;
+        const auto addCounters = [&profile](const SSiteCounters* pCounters)
+        {
+            if (nullptr != pCounters)
+            {
+                pCounters->evaluation.AddTo(profile.evaluation);
+                pCounters->handler.AddTo(profile.handler);
+            }
+        };
+        addCounters(registry.retired.Find(site.id));
+        for (const auto* pProfile : registry.vecLive)
+        {
+            addCounters(pProfile->Find(site.id));
+        }
+        if (0 != profile.evaluation.count || 0 != profile.handler.count)
+        {
+            vecProfiles.push_back(profile);
+        }
+    });
+    return vecProfiles;
+}
+
+void CAssertProfiler::WriteTopReport(std::ostream& stream, const std::size_t count)
+{
+    auto vecProfiles = Collect();
+    if (vecProfiles.empty())
+    {
+        return;
+    }
+    std::sort(vecProfiles.begin(), vecProfiles.end(), [](const SSiteProfile& lhs, const SSiteProfile& rhs)
+    {
+        return lhs.evaluation.ticks + lhs.handler.ticks > rhs.evaluation.ticks + rhs.handler.ticks;
+    });
+    vecProfiles.resize(std::min(vecProfiles.size(), count));
+
+    const auto dNanosecondsPerTick = CCaptureClock::NanosecondsPerTick();
+    const auto toMicroseconds = [dNanosecondsPerTick](const std::uint64_t uTicks)
+    {
+        return static_cast<double>(uTicks) * dNanosecondsPerTick / 1000.0;
+    };
+    const auto mean = [](const SCost& cost)
+    {
+        return (0 == cost.count) ? std::uint64_t { 0 } : cost.ticks / cost.count;
+    };
+
+    const auto flags = stream.flags();
+    stream << "TOP COSTLY ASSERTS (times in microseconds):\n"
+           << "  [rank] [total]      [evaluations] [eval mean] [eval p99]  [failures] [fail mean]  [site]\n"
+           << std::fixed << std::setprecision(3);
+    std::size_t uRank = 0;
+    for (const auto& profile : vecProfiles)
+    {
+        stream << "  " << std::setw(6) << ++uRank
+               << ' ' << std::setw(12) << toMicroseconds(profile.evaluation.ticks + profile.handler.ticks)
+               << ' ' << std::setw(13) << profile.evaluation.count
+               << ' ' << std::setw(11) << toMicroseconds(mean(profile.evaluation))
+               << ' ' << std::setw(11) << toMicroseconds(profile.evaluation.Quantile(0.99))
+               << ' ' << std::setw(10) << profile.handler.count
+               << ' ' << std::setw(11) << toMicroseconds(mean(profile.handler))
+               << "  " << profile.pSite->file << ':' << profile.pSite->line
+               << " (" << profile.pSite->expression << ")\n";
+    }
+    stream.flags(flags);
+}
+
+void CAssertProfiler::WriteProfile(std::ostream& stream)
+{
+    stream << "# file\tline\tevaluations\tevaluation_ticks\tfailures\tfailure_ticks\n";
+    for (const auto& profile : Collect())
+    {
+        stream << profile.pSite->file << '\t' << profile.pSite->line
+               << '\t' << profile.evaluation.count << '\t' << profile.evaluation.ticks
+               << '\t' << profile.handler.count << '\t' << profile.handler.ticks << '\n';
+    }
+}
+
+} // namespace dbgh
@@ -0,0 +1,197 @@
+/**
+ * @file        CAssertProfiler.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CAssertProfiler and CHandlerProfileScope classes.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "CAssertSite.h"
+#include "CCaptureClock.h"
+
+namespace dbgh
+{
+
+/**
+ * @class      CAssertProfiler
+ * @brief      The per-site cost of the assertions: the evaluation of the expression and the handling of the failure.
+ *
+ * @details    Enabled by the DBGH_ASSERTS_PROFILE definition (the CMake option of the same name), then every pass of
+ *              the assert macro measures the clock ticks of bool(expression), and every failure measures the ticks of
+ *              the message formatting and \ref impl::CAssertHandler::HandleAssert.
+ *             The measurements are aggregated in the histograms of the current thread (log2 buckets of ticks),
+ *              indexed by \ref SAssertSite::id, the recording takes no lock and no shared cache line. The histograms
+ *              of the finished threads are merged into the common one.
+ *             At the exit the top costly asserts are written to std::cerr, and the profile (see \ref WriteProfile)
+ *              is written to the file named by the DBGH_ASSERTS_PROFILE_FILE environment variable, if it is set.
+ */
+class CAssertProfiler
+{
+public:
+
+    /**
+     * @brief      The count of the histogram buckets, the bucket i holds the measurements of [2^(i-1), 2^i) ticks.
+     */
+    static constexpr std::size_t BucketCount = 48;
+
+    /**
+     * @struct     SCost
+     * @brief      The aggregated cost of one kind of the measurements.
+     */
+    struct SCost
+    {
+        /**
+         * @brief      The count of the measurements.
+         */
+        std::uint64_t count = 0;
+
+        /**
+         * @brief      The sum of the measured ticks.
+         */
+        std::uint64_t ticks = 0;
+
+        /**
+         * @brief      The log2 histogram of the measured ticks.
+         */
+        std::array<std::uint64_t, BucketCount> histogram { };
+
+        /**
+         * @brief      Gets the upper bound of the given quantile, from the histogram.
+         *
+         * @param[in]  quantile  The quantile, from 0.0 to 1.0.
+         *
+         * @return     The bound, in ticks.
+         */
+        [[nodiscard]] std::uint64_t Quantile(double quantile) const noexcept;
+    };
+
+    /**
+     * @struct     SSiteProfile
+     * @brief      The aggregated costs of one site.
+     */
+    struct SSiteProfile
+    {
+        /**
+         * @brief      The site.
+         */
+        const SAssertSite* pSite = nullptr;
+
+        /**
+         * @brief      The cost of the expression evaluation.
+         */
+        SCost evaluation;
+
+        /**
+         * @brief      The cost of the failure handling.
+         */
+        SCost handler;
+    };
+
+public:
+
+    CAssertProfiler() = delete;
+
+    /**
+     * @brief      Records the evaluation of the expression.
+     *
+     * @param[in]  site   The site.
+     * @param[in]  ticks  The measured clock ticks.
+     */
+    static void RecordEvaluation(const SAssertSite& site, std::uint64_t ticks) noexcept;
+
+    /**
+     * @brief      Records the handling of the failure.
+     *
+     * @param[in]  site   The site.
+     * @param[in]  ticks  The measured clock ticks.
+     */
+    static void RecordHandler(const SAssertSite& site, std::uint64_t ticks) noexcept;
+
+    /**
+     * @brief      Aggregates the measurements of all threads.
+     *
+     * @return     The profiles of the sites with at least one measurement.
+     */
+    [[nodiscard]] static std::vector<SSiteProfile> Collect();
+
+    /**
+     * @brief      Writes the sites with the biggest total cost, in the descending order.
+     *
+     * @param[out] stream  The output stream.
+     * @param[in]  count   The maximum count of the sites.
+     */
+    static void WriteTopReport(std::ostream& stream, std::size_t count = 20);
+
+    /**
+     * @brief      Writes the profile of all measured sites, the input of the compile-time demotion.
+     *
+     * @details    One line per site with tab separated fields:
+     *              file, line, evaluation count, evaluation ticks, failure count, failure ticks.
+     *             The lines starting with '#' are comments. See cmake/DBGHAssertsDemotion.cmake.
+     *
+     * @param[out] stream  The output stream.
+     */
+    static void WriteProfile(std::ostream& stream);
+
+}; // class CAssertProfiler
+
+
+/**
+ * @class      CHandlerProfileScope
+ * @brief      Measures the handling of the failure until the end of the scope, also if the handler throws.
+ */
+class CHandlerProfileScope
+{
+public:
+
+    /**
+     * @brief      Starts the measurement.
+     *
+     * @param[in]  site  The site of the failed assertion.
+     */
+    explicit CHandlerProfileScope(const SAssertSite& site) noexcept
+            : m_site { site },
+            m_uStart { CCaptureClock::Ticks() }
+    { }
+
+    /**
+     * @brief      Records the measurement.
+     */
+    ~CHandlerProfileScope()
+    {
+        CAssertProfiler::RecordHandler(m_site, CCaptureClock::Ticks() - m_uStart);
+    }
+
+    CHandlerProfileScope(CHandlerProfileScope&&) = delete;
+
+    CHandlerProfileScope(const CHandlerProfileScope&) = delete;
+
+    CHandlerProfileScope& operator=(CHandlerProfileScope&&) = delete;
+
+    CHandlerProfileScope& operator=(const CHandlerProfileScope&) = delete;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The site of the failed assertion.
+     */
+    const SAssertSite& m_site;
+
+    /**
+     * @internal
+     * @brief      The clock value at the start.
+     */
+    const std::uint64_t m_uStart;
+
+}; // class CHandlerProfileScope
+
+} // namespace dbgh
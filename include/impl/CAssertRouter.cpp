@@ -0,0 +1,132 @@
+/**
+ * @file        CAssertRouter.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CAssertRouter class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "CAssertRouter.h"
+
+namespace dbgh
+{
+
+CAssertRouter::CAssertRouter()
+{
+    for (auto& list : m_arrSinkLists)
+    {
+        list.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+CAssertRouter::~CAssertRouter() = default;
+
+void CAssertRouter::Subscribe(const EAssertLevel level, std::shared_ptr<CAssertSink> sink)
+{
+    if (nullptr == sink)
+    {
+        throw std::invalid_argument { "Sink cannot be null." };
+    }
+
+    std::lock_guard lock { m_mtxUpdate };
+    auto list = std::make_unique<SSinkList>();
+    if (const auto* pCurrent = m_arrSinkLists[static_cast<size_t>(level)].load(std::memory_order_relaxed))
+    {
+        list->vecSinks = pCurrent->vecSinks;
+    }
+    list->vecSinks.push_back(std::move(sink));
+    publish(level, std::move(list));
+}
+
+void CAssertRouter::Unsubscribe(const EAssertLevel level, const CAssertSink* sink)
+{
+    std::lock_guard lock { m_mtxUpdate };
+    const auto* pCurrent = m_arrSinkLists[static_cast<size_t>(level)].load(std::memory_order_relaxed);
+    if (nullptr == pCurrent)
+    {
+        return;
+    }
+
+    auto list = std::make_unique<SSinkList>();
+    std::copy_if(std::begin(pCurrent->vecSinks), std::end(pCurrent->vecSinks), std::back_inserter(list->vecSinks),
+                 [sink](const auto& subscribed) { return subscribed.get() != sink; });
+    publish(level, std::move(list));
+}
+
+bool CAssertRouter::HasSubscribers(const EAssertLevel level) const noexcept
+{
+    return nullptr != m_arrSinkLists[static_cast<size_t>(level)].load(std::memory_order_acquire);
+}
+
+void CAssertRouter::Flush()
+{
+    for (const auto& list : m_arrSinkLists)
+    {
+        if (const auto* pList = list.load(std::memory_order_acquire))
+        {
+            for (const auto& sink : pList->vecSinks)
+            {
+                sink->Flush();
+            }
+        }
+    }
+}
+
+void CAssertRouter::Terminate(std::string_view message)
+{
+    route(EAssertLevel::Fatal, message);
+    Flush();
+    std::terminate();
+}
+
+void CAssertRouter::HandleWarning(std::string_view message)
+{
+    route(EAssertLevel::Warning, message);
+}
+
+void CAssertRouter::HandleError(std::string_view message, const CAssertException& exception)
+{
+    route(EAssertLevel::Error, message);
+    throw exception;
+}
+
+bool CAssertRouter::IsReported(const EAssertLevel level) const noexcept
+{
+    return HasSubscribers(level);
+}
+
+void CAssertRouter::ShowReport(const EAssertLevel level, std::string_view report)
+{
+    route(level, report);
+    CHandlerExecutor::ShowReport(level, report);
+}
+
+void CAssertRouter::route(const EAssertLevel level, std::string_view report) const
+{
+    const auto* pList = m_arrSinkLists[static_cast<size_t>(level)].load(std::memory_order_acquire);
+    if (nullptr == pList)
+    {
+        return;
+    }
+    for (const auto& sink : pList->vecSinks)
+    {
+        sink->Write(level, report);
+    }
+}
+
+void CAssertRouter::publish(const EAssertLevel level, std::unique_ptr<SSinkList> list)
+{
+    const SSinkList* pPublished = nullptr;
+    if (! list->vecSinks.empty())
+    {
+        pPublished = list.get();
+        m_vecPublishedLists.push_back(std::move(list));
+    }
+    m_arrSinkLists[static_cast<size_t>(level)].store(pPublished, std::memory_order_release);
+}
+
+} // namespace dbgh
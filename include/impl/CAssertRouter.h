@@ -0,0 +1,176 @@
+/**
+ * @file        CAssertRouter.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CAssertRouter class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "CAssertConfig.h"
+#include "CAssertSink.h"
+#include "CHandlerExecutor.h"
+
+namespace dbgh
+{
+
+/**
+ * @class       CAssertRouter
+ * @brief       The executor which fans out the assertion reports to the sinks subscribed to each level.
+ *
+ * @details     Every \ref EAssertLevel has its own ordered list of sinks. The report is formatted once by the
+ *               assertion handler and the same buffer is passed to every sink of the level. Neither the message
+ *               nor the report of the Warning and Fatal levels without subscribers is formatted (see \ref IsReported):
+ *               the failure costs the lookup of the installed executor and one atomic load of the sink list.
+ *             The lists are immutable snapshots published with an atomic pointer, so the reporting path is lock-free.
+ *              Subscribe and Unsubscribe copy the list and publish the new snapshot, the old snapshots are kept
+ *              alive until the router is destroyed, the subscription changes are expected to be rare.
+ *
+ * @note       The control flow of the levels is kept: HandleError throws the exception and Terminate calls
+ *              std::terminate after the sinks. The Debug level reports are routed when they are shown to the user
+ *              (see \ref ShowReport).
+ *
+ * @example     auto router = std::make_unique<dbgh::CAssertRouter>();
+ *              router->Subscribe(dbgh::EAssertLevel::Warning, std::make_shared<CounterSink>());
+ *              router->Subscribe(dbgh::EAssertLevel::Warning, std::make_shared<FileSink>("asserts.log"));
+ *              dbgh::CAssertConfig::Get().SetExecutor(std::move(router));
+ */
+class CAssertRouter : public CHandlerExecutor
+{
+public:
+
+    CAssertRouter();
+
+    ~CAssertRouter() override;
+
+    /**
+     * @brief      Appends the sink to the list of the given level.
+     *
+     * @throw      std::invalid_argument exception if the sink is null.
+     *
+     * @param[in]  level  The level of the assertions that are routed to the sink.
+     * @param[in]  sink   The sink.
+     */
+    void Subscribe(EAssertLevel level, std::shared_ptr<CAssertSink> sink);
+
+    /**
+     * @brief      Removes the sink from the list of the given level.
+     *
+     * @param[in]  level  The level.
+     * @param[in]  sink   The raw pointer to the subscribed sink.
+     */
+    void Unsubscribe(EAssertLevel level, const CAssertSink* sink);
+
+    /**
+     * @brief      Determines whether the level has subscribers.
+     *
+     * @param[in]  level  The level.
+     *
+     * @return     True if at least one sink is subscribed to the level, False otherwise.
+     */
+    [[nodiscard]] bool HasSubscribers(EAssertLevel level) const noexcept;
+
+    /**
+     * @brief      Flushes all subscribed sinks.
+     */
+    void Flush();
+
+    /**
+     * @brief      Routes the report to the Fatal sinks and calls std::terminate.
+     *
+     * @param[in]  message  The formatted report.
+     */
+    [[noreturn]] void Terminate(std::string_view message) override;
+
+    /**
+     * @brief      Routes the report to the Warning sinks.
+     *
+     * @param[in]  message  The formatted report.
+     */
+    void HandleWarning(std::string_view message) override;
+
+    /**
+     * @brief      Routes the report to the Error sinks and throws the given exception.
+     *
+     * @param[in]  message    The formatted report.
+     * @param[in]  exception  The exception to throw.
+     */
+    [[noreturn]] void HandleError(std::string_view message, const CAssertException& exception) override;
+
+    /**
+     * @brief      Determines whether the level has subscribers, the report of the level without subscribers is not
+     *              formatted.
+     *
+     * @param[in]  level  The level.
+     *
+     * @return     True if at least one sink is subscribed to the level, False otherwise.
+     */
+    [[nodiscard]] bool IsReported(EAssertLevel level) const noexcept override;
+
+    /**
+     * @brief      Routes the report to the sinks of the level and shows it to the user.
+     *
+     * @param[in]  level   The level.
+     * @param[in]  report  The formatted report.
+     */
+    void ShowReport(EAssertLevel level, std::string_view report) override;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The immutable snapshot of the sinks subscribed to a level.
+     */
+    struct SSinkList
+    {
+        std::vector<std::shared_ptr<CAssertSink>> vecSinks;
+    };
+
+    /**
+     * @internal
+     * @brief      Passes the report to the sinks subscribed to the level.
+     *
+     * @param[in]  level   The level.
+     * @param[in]  report  The formatted report.
+     */
+    void route(EAssertLevel level, std::string_view report) const;
+
+    /**
+     * @internal
+     * @brief      Publishes the new list for the level, must be called under m_mtxUpdate.
+     *
+     * @param[in]  level  The level.
+     * @param[in]  list   The new list, empty list is published as null.
+     */
+    void publish(EAssertLevel level, std::unique_ptr<SSinkList> list);
+
+private:
+
+    /**
+     * @internal
+     * @brief      The current sink list of each level, null if the level has no subscribers.
+     */
+    std::array<std::atomic<const SSinkList*>, static_cast<size_t>(EAssertLevel::END_ENUM_)> m_arrSinkLists;
+
+    /**
+     * @internal
+     * @brief      The mutex serializing the subscription changes.
+     */
+    std::mutex m_mtxUpdate;
+
+    /**
+     * @internal
+     * @brief      All published lists, owned by the router until destruction.
+     */
+    std::vector<std::unique_ptr<SSinkList>> m_vecPublishedLists;
+
+}; // class CAssertRouter
+
+} // namespace dbgh
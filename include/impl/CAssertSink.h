@@ -0,0 +1,69 @@
+/**
+ * @file        CAssertSink.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CAssertSink class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "CAssertConfig.h"
+
+namespace dbgh
+{
+
+/**
+ * @class       CAssertSink
+ * @brief       The interface for the destinations of the assertion reports.
+ *
+ * @details     A sink receives already formatted reports, it is subscribed to one or more levels in
+ *               \ref dbgh::CAssertRouter. The same sink object may be subscribed to several levels and several
+ *               routers, so Write must be thread-safe.
+ *
+ * @example     class CounterSink : public dbgh::CAssertSink
+ *              {
+ *              public:
+ *                  void Write(dbgh::EAssertLevel, std::string_view) override { ++m_counter; }
+ *              private:
+ *                  std::atomic<size_t> m_counter { 0 };
+ *              };
+ */
+class CAssertSink
+{
+public:
+
+    CAssertSink() = default;
+
+    virtual ~CAssertSink() = default;
+
+    CAssertSink(CAssertSink&&) = delete;
+
+    CAssertSink(const CAssertSink&) = delete;
+
+    CAssertSink& operator=(CAssertSink&&) = delete;
+
+    CAssertSink& operator=(const CAssertSink&) = delete;
+
+    /**
+     * @brief      Writes the formatted report.
+     *
+     * @note       The report is valid only during the call, the sink must copy it if it is needed later.
+     *
+     * @param[in]  level   The level of the failed assertion.
+     * @param[in]  report  The formatted report.
+     */
+    virtual void Write(EAssertLevel level, std::string_view report) = 0;
+
+    /**
+     * @brief      Flushes the reports buffered by the sink.
+     *
+     * @details    By default empty.
+     */
+    virtual void Flush() { }
+
+}; // class CAssertSink
+
+} // namespace dbgh
@@ -0,0 +1,74 @@
+/**
+ * @file        CAssertSite.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for SAssertSite struct and CAssertSiteRegistry class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <exception>
+
+#include "CAssertSite.h"
+#include "CSharedControl.h"
+#include "CSiteRules.h"
+
+namespace dbgh
+{
+
+SAssertSite::SAssertSite(
+        const EAssertLevel level_,
+        const char* expression_,
+        const char* file_,
+        const TLine line_,
+        const char* function_,
+        const std::uint32_t category_) noexcept
+        : level { level_ },
+        category { category_ },
+        expression { expression_ },
+        file { file_ },
+        line { line_ },
+        function { function_ },
+        flags { 0 },
+        evaluationTicks { 0 },
+        failures { 0 },
+        suppressed { 0 },
+        dropped { 0 },
+        backoffFailures { 0 },
+        sharedRule { nullptr },
+        id { 0 },
+        next { nullptr }
+{
+    CAssertSiteRegistry::Register(*this);
+}
+
+SThreadContext SThreadContext::Current() noexcept
+{
+    return SThreadContext { std::this_thread::get_id(), std::uncaught_exceptions() };
+}
+
+void CAssertSiteRegistry::Register(SAssertSite& site) noexcept
+{
+    static std::atomic<std::uint32_t> s_uNextId { 0 };
+    site.id = s_uNextId.fetch_add(1, std::memory_order_relaxed);
+
+    auto& listHead = head();
+    auto* pHead = listHead.load(std::memory_order_relaxed);
+    do
+    {
+        site.next = pHead;
+    } while (! listHead.compare_exchange_weak(pHead, &site, std::memory_order_release, std::memory_order_relaxed));
+
+    // Applied after the linking, so the concurrent CSiteRules::Set either sees the site or is seen by it.
+    CSiteRules::Apply(site);
+#if defined(__linux__)
+    impl::CSharedControl::BindSite(site);
+#endif
+}
+
+std::atomic<SAssertSite*>& CAssertSiteRegistry::head() noexcept
+{
+    static std::atomic<SAssertSite*> listHead { nullptr };
+    return listHead;
+}
+
+} // namespace dbgh
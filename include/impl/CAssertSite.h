@@ -0,0 +1,289 @@
+/**
+ * @file        CAssertSite.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for SAssertSite struct and CAssertSiteRegistry class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "CAssertException.h"
+#include "EAssertLevel.h"
+
+namespace dbgh
+{
+
+/**
+ * @struct     SAssertSite
+ * @brief      The static metadata and the runtime state of one assertion in the source code.
+ *
+ * @details    Every assert macro expansion owns one static SAssertSite object, it is created the first time
+ *              the assertion is evaluated and registered in \ref dbgh::CAssertSiteRegistry.
+ */
+struct SAssertSite
+{
+    /**
+     * @brief      The cached filter verdict: the reports of the site are accepted without calling the filter.
+     */
+    static constexpr std::uint32_t FilterAccepted = 1u << 0u;
+
+    /**
+     * @brief      The cached filter verdict: the reports of the site are dropped without calling the filter.
+     */
+    static constexpr std::uint32_t FilterRejected = 1u << 1u;
+
+    /**
+     * @brief      The mask of all cached filter verdicts.
+     */
+    static constexpr std::uint32_t FilterMask = FilterAccepted | FilterRejected;
+
+    /**
+     * @brief      The evaluation mode: the expression is evaluated only for a sample of the passes.
+     */
+    static constexpr std::uint32_t ModeSampled = 1u << 2u;
+
+    /**
+     * @brief      The evaluation mode: the expression is not evaluated.
+     */
+    static constexpr std::uint32_t ModeDisabled = 1u << 3u;
+
+    /**
+     * @brief      The mask of the evaluation modes, no bit means that the expression is always evaluated.
+     */
+    static constexpr std::uint32_t ModeMask = ModeSampled | ModeDisabled;
+
+    /**
+     * @brief      The rule of the configuration: the expression is evaluated only for a sample of the passes.
+     */
+    static constexpr std::uint32_t RuleSampled = 1u << 0u;
+
+    /**
+     * @brief      The rule of the configuration: the expression is not evaluated.
+     */
+    static constexpr std::uint32_t RuleDisabled = 1u << 1u;
+
+    /**
+     * @brief      The site matches a rule of the configuration, its mode is not chosen by the CPU budget governor.
+     */
+    static constexpr std::uint32_t RulePinned = 1u << 2u;
+
+    /**
+     * @brief      The position of the log2 of the sampling rate of the rule, zero means the default rate.
+     */
+    static constexpr std::uint32_t RuleRateShift = 3u;
+
+    /**
+     * @brief      The mask of the log2 of the sampling rate of the rule.
+     */
+    static constexpr std::uint32_t RuleRateMask = 0x1fu << RuleRateShift;
+
+    /**
+     * @brief      The rule enables the site also if its level or its category is disabled, see \ref dbgh::OverrideBit.
+     */
+    static constexpr std::uint32_t RuleEnabled = 1u << 8u;
+
+    /**
+     * @brief      The count of the bits of one rule slot.
+     */
+    static constexpr std::uint32_t RuleSlotBits = 9u;
+
+    /**
+     * @brief      The position of the first of the two rule slots in the flags.
+     *
+     * @details    The new rules are written to the inactive slot of every site and then published by switching the
+     *              active slot with one store, so the asserting threads see either the old or the new rules of all
+     *              sites, see \ref dbgh::CSiteRules.
+     */
+    static constexpr std::uint32_t RuleSlotShift = 8u;
+
+    /**
+     * @brief      Gets the rule of the slot.
+     *
+     * @param[in]  flags  The flags of the site.
+     * @param[in]  slot   The index of the slot, 0 or 1.
+     *
+     * @return     The rule bits.
+     */
+    [[nodiscard]] static constexpr std::uint32_t RuleOf(const std::uint32_t flags, const std::uint32_t slot) noexcept
+    {
+        return (flags >> (RuleSlotShift + slot * RuleSlotBits)) & ((1u << RuleSlotBits) - 1);
+    }
+
+    /**
+     * @brief      Constructs the site and registers it in \ref dbgh::CAssertSiteRegistry.
+     *
+     * @param[in]  level       The assert level.
+     * @param[in]  expression  Expression to be evaluated, as a string.
+     * @param[in]  file        The filename that contains the assertion.
+     * @param[in]  line        The line number in the file that contains the assertion.
+     * @param[in]  function    The function that contains the assertion.
+     * @param[in]  category    The index of the category, see \ref SAssertCategory.
+     */
+    SAssertSite(
+            EAssertLevel level, const char* expression, const char* file, TLine line, const char* function,
+            std::uint32_t category = 0) noexcept;
+
+    SAssertSite(SAssertSite&&) = delete;
+
+    SAssertSite(const SAssertSite&) = delete;
+
+    SAssertSite& operator=(SAssertSite&&) = delete;
+
+    SAssertSite& operator=(const SAssertSite&) = delete;
+
+    /**
+     * @brief      The assert level.
+     */
+    const EAssertLevel level;
+
+    /**
+     * @brief      The index of the category, see \ref SAssertCategory.
+     */
+    const std::uint32_t category;
+
+    /**
+     * @brief      Expression to be evaluated, as a string.
+     */
+    const char* const expression;
+
+    /**
+     * @brief      The filename that contains the assertion.
+     */
+    const char* const file;
+
+    /**
+     * @brief      The line number in the file that contains the assertion.
+     */
+    const TLine line;
+
+    /**
+     * @brief      The function that contains the assertion.
+     */
+    const char* const function;
+
+    /**
+     * @brief      The runtime flags of the site.
+     */
+    std::atomic<std::uint32_t> flags;
+
+    /**
+     * @brief      The estimated clock ticks spent in the evaluation of the expression, see \ref dbgh::CAssertProbe.
+     */
+    std::atomic<std::uint64_t> evaluationTicks;
+
+    /**
+     * @brief      The number of the failed assertions of the site, counted before the filter.
+     */
+    std::atomic<std::uint64_t> failures;
+
+    /**
+     * @brief      The number of the failures not reported because of the report backoff or the circuit breaker.
+     */
+    std::atomic<std::uint64_t> suppressed;
+
+    /**
+     * @brief      The number of the failures dropped by the filter.
+     */
+    std::atomic<std::uint64_t> dropped;
+
+    /**
+     * @brief      The number of the failures seen by the report backoff since it was enabled, see
+     *              \ref dbgh::CAssertConfig::SetReportBackoff.
+     */
+    std::atomic<std::uint64_t> backoffFailures;
+
+    /**
+     * @brief      The rule word of the site in the shared control block, or null, see \ref impl::CSharedControl.
+     */
+    std::atomic<std::atomic<std::uint32_t>*> sharedRule;
+
+    /**
+     * @brief      The sequential number of the site, assigned at the registration.
+     */
+    std::uint32_t id;
+
+    /**
+     * @internal
+     * @brief      The next registered site.
+     */
+    SAssertSite* next;
+};
+
+
+/**
+ * @struct     SThreadContext
+ * @brief      The information about the thread in which the assertion failed.
+ */
+struct SThreadContext
+{
+    /**
+     * @brief      The identifier of the thread.
+     */
+    std::thread::id threadId;
+
+    /**
+     * @brief      The number of uncaught exceptions in the thread.
+     */
+    int uncaughtExceptions;
+
+    /**
+     * @brief      Captures the context of the current thread.
+     *
+     * @return     The context.
+     */
+    [[nodiscard]] static SThreadContext Current() noexcept;
+};
+
+
+/**
+ * @class      CAssertSiteRegistry
+ * @brief      The lock-free list of all registered assertion sites.
+ *
+ * @details    The sites are pushed to the head of the list and never removed, so the list can be walked
+ *              concurrently with the registration.
+ */
+class CAssertSiteRegistry
+{
+public:
+
+    CAssertSiteRegistry() = delete;
+
+    /**
+     * @brief      Registers the site, assigns its id and applies the configuration rules to it.
+     *
+     * @param[in]  site  The site.
+     */
+    static void Register(SAssertSite& site) noexcept;
+
+    /**
+     * @brief      Calls the function for every registered site.
+     *
+     * @param[in]  function  The function, takes SAssertSite&.
+     */
+    template<class TFunction>
+    static void ForEach(TFunction&& function)
+    {
+        for (auto* pSite = head().load(std::memory_order_acquire); nullptr != pSite; pSite = pSite->next)
+        {
+            function(*pSite);
+        }
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      Gets the head of the list.
+     *
+     * @return     The reference to the head.
+     */
+    static std::atomic<SAssertSite*>& head() noexcept;
+
+}; // class CAssertSiteRegistry
+
+} // namespace dbgh
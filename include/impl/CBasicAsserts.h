@@ -0,0 +1,104 @@
+/**
+ * @file        CBasicAsserts.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration and implementation for CBasicAsserts class template.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <utility>
+
+#include "CAssertConfig.h"
+#include "CAssertHandler.h"
+
+namespace dbgh
+{
+
+/**
+ * @class      CBasicAsserts
+ * @brief      The policy-based front end for assertions, the executor is chosen at build time.
+ *
+ * @details    The default front end (\ref dbgh::impl::CAssertHandler) dispatches every action through the virtual
+ *              methods of the executor installed in \ref dbgh::CAssertConfig. CBasicAsserts binds the executor type
+ *              at compile time instead, so all handlers are statically bound and can be inlined.
+ *             TExecutor must be default constructible and provide the same methods as \ref dbgh::CHandlerExecutor
+ *              (Terminate, HandleWarning, HandleError, Logs, ShowMessage, GetUserInput, DebugPreCall), they do not
+ *              need to be virtual. IsReported and ShowReport are optional. Deriving from
+ *              \ref dbgh::CHandlerExecutor is allowed, mark the class final to let the compiler devirtualize the calls.
+ *
+ * @note       To use the policy for all asserts in a translation unit, define DBGH_ASSERTS_HANDLER before
+ *              including "DBGHAssert.h", or pass it as a compile definition for the whole target.
+ * @example    target_compile_definitions(my_app PRIVATE "DBGH_ASSERTS_HANDLER=dbgh::CBasicAsserts<MyExecutor>")
+ *
+ * @note       The enable flags still come from \ref dbgh::CAssertConfig, only the executor is replaced.
+ *
+ * @tparam     TExecutor  The executor type.
+ */
+template<class TExecutor>
+class CBasicAsserts
+{
+public:
+
+    /**
+     * @brief The executor type.
+     */
+    using TExecutorType = TExecutor;
+
+    CBasicAsserts() = delete;
+
+    ~CBasicAsserts() = delete;
+
+    CBasicAsserts(CBasicAsserts&&) noexcept = delete;
+
+    CBasicAsserts(const CBasicAsserts&) = delete;
+
+    CBasicAsserts& operator=(CBasicAsserts&&) = delete;
+
+    CBasicAsserts& operator=(const CBasicAsserts&) = delete;
+
+    /**
+     * @brief      Gets a reference to the executor instance, shared by all asserts with the same policy.
+     *
+     * @return     The reference to the executor.
+     */
+    static TExecutor& Executor()
+    {
+        static TExecutor executor;
+        return executor;
+    }
+
+    /**
+     * @internal
+     * @brief      The internal handler for the assertion, forwards to \ref dbgh::impl::CAssertHandler::HandleAssertWith
+     *              with the statically bound executor.
+     *
+     * @param[in]  args  The assertion information, the same as for \ref dbgh::impl::CAssertHandler::HandleAssert.
+     *
+     * @enum       T     The \ref EAssertLevel enum value, type of assert.
+     */
+    template<EAssertLevel T, class... TArgs>
+    static void HandleAssert(TArgs&&... args)
+    {
+        impl::CAssertHandler::HandleAssertWith<T>(Executor(), std::forward<TArgs>(args)...);
+    }
+
+    /**
+     * @internal
+     * @brief      Determines whether the message of the failed assertion is used by the executor, see
+     *              \ref dbgh::impl::CAssertHandler::IsMessageUsed.
+     *
+     * @return     True if the message has to be formatted, False otherwise.
+     *
+     * @enum       T     The \ref EAssertLevel enum value, type of assert.
+     */
+    template<EAssertLevel T>
+    [[nodiscard]] static bool IsMessageUsed()
+    {
+        return impl::CAssertHandler::IsMessageUsedBy<T>(Executor());
+    }
+
+}; // class CBasicAsserts
+
+} // namespace dbgh
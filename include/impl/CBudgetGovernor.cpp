@@ -0,0 +1,175 @@
+/**
+ * @file        CBudgetGovernor.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CBudgetGovernor class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <algorithm>
+#include <ctime>
+#include <vector>
+
+#include "CBudgetGovernor.h"
+
+namespace dbgh::impl
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The site with the cost collected by one evaluation.
+ */
+struct SCandidate
+{
+    SAssertSite* pSite;
+    ESiteMode mode;
+    double dCost;
+    double dFullCost;
+};
+}  // unnamed namespace
+
+CBudgetGovernor::CBudgetGovernor(const double fraction, const std::chrono::milliseconds period)
+        : m_dFraction { fraction },
+        m_period { period },
+        m_dLastCpu { processCpuNanoseconds() },
+        m_dUsage { 0.0 }
+{
+    CAssertProbe::SetBudgetEnabled(true);
+    m_worker = std::jthread { [this](std::stop_token stopToken) { workerLoop(std::move(stopToken)); } };
+}
+
+CBudgetGovernor::~CBudgetGovernor()
+{
+    m_worker.request_stop();
+    m_worker.join();
+
+    CAssertProbe::SetBudgetEnabled(false);
+    CAssertSiteRegistry::ForEach([](SAssertSite& site)
+    {
+        CAssertProbe::SetMode(site, ESiteMode::Full);
+        site.evaluationTicks.store(0, std::memory_order_relaxed);
+    });
+}
+
+void CBudgetGovernor::Evaluate()
+{
+    std::lock_guard lock { m_mtxEvaluate };
+
+    const auto dCpu = processCpuNanoseconds();
+    const auto dElapsed = dCpu - m_dLastCpu;
+    m_dLastCpu = dCpu;
+    const auto dNanosecondsPerTick = CCaptureClock::NanosecondsPerTick();
+
+    std::vector<SCandidate> vecCandidates;
+    double dTotal = 0.0;
+    CAssertSiteRegistry::ForEach([&](SAssertSite& site)
+    {
+        const auto uTicks = site.evaluationTicks.exchange(0, std::memory_order_relaxed);
+        const auto dCost = static_cast<double>(uTicks) * dNanosecondsPerTick;
+        const auto mode = CAssertProbe::GetMode(site);
+        auto& state = m_mapSites[&site];
+        switch (mode)
+        {
+            case ESiteMode::Full:
+                state.dFullCost = dCost;
+                break;
+            case ESiteMode::Sampled:
+                if (0 != uTicks)
+                {
+                    state.dFullCost = dCost * CAssertProbe::SampleRate;
+                }
+                break;
+            case ESiteMode::Disabled:
+                [[fallthrough]];
+            default:
+                break;
+        }
+        dTotal += dCost;
+        if (0 == (CAssertProbe::GetRule(site) & SAssertSite::RulePinned))
+        {
+            vecCandidates.push_back(SCandidate { &site, mode, dCost, state.dFullCost });
+        }
+    });
+
+    if (! (dElapsed > 0.0))
+    {
+        return;
+    }
+    m_dUsage = dTotal / dElapsed;
+
+    const auto dBudget = m_dFraction * dElapsed;
+    constexpr auto dSampledShare = 1.0 / CAssertProbe::SampleRate;
+    if (dTotal > dBudget)
+    {
+        std::sort(vecCandidates.begin(), vecCandidates.end(),
+                  [](const SCandidate& lhs, const SCandidate& rhs) { return lhs.dCost > rhs.dCost; });
+        for (const auto& candidate : vecCandidates)
+        {
+            if (! (dTotal > dBudget) || ! (candidate.dCost > 0.0))
+            {
+                break;
+            }
+            if (ESiteMode::Full == candidate.mode)
+            {
+                CAssertProbe::SetMode(*candidate.pSite, ESiteMode::Sampled);
+                dTotal -= candidate.dCost * (1.0 - dSampledShare);
+            }
+            else if (ESiteMode::Sampled == candidate.mode)
+            {
+                CAssertProbe::SetMode(*candidate.pSite, ESiteMode::Disabled);
+                dTotal -= candidate.dCost;
+            }
+        }
+        return;
+    }
+
+    const auto dPromotionLimit = dBudget / 2.0;
+    if (dTotal < dPromotionLimit)
+    {
+        std::erase_if(vecCandidates, [](const SCandidate& candidate) { return ESiteMode::Full == candidate.mode; });
+        std::sort(vecCandidates.begin(), vecCandidates.end(),
+                  [](const SCandidate& lhs, const SCandidate& rhs) { return lhs.dFullCost < rhs.dFullCost; });
+        for (const auto& candidate : vecCandidates)
+        {
+            const auto bDisabled = (ESiteMode::Disabled == candidate.mode);
+            const auto dIncrease = bDisabled
+                    ? candidate.dFullCost * dSampledShare
+                    : candidate.dFullCost * (1.0 - dSampledShare);
+            if (dTotal + dIncrease > dPromotionLimit)
+            {
+                break;
+            }
+            CAssertProbe::SetMode(*candidate.pSite, bDisabled ? ESiteMode::Sampled : ESiteMode::Full);
+            dTotal += dIncrease;
+        }
+    }
+}
+
+double CBudgetGovernor::GetUsage() const
+{
+    std::lock_guard lock { m_mtxEvaluate };
+    return m_dUsage;
+}
+
+void CBudgetGovernor::workerLoop(std::stop_token stopToken)
+{
+    std::mutex mtxWait;
+    std::unique_lock lock { mtxWait };
+    while (! m_cvWorker.wait_for(lock, stopToken, m_period, [] { return false; }))
+    {
+        if (stopToken.stop_requested())
+        {
+            return;
+        }
+        Evaluate();
+    }
+}
+
+double CBudgetGovernor::processCpuNanoseconds() noexcept
+{
+    return static_cast<double>(std::clock()) * (1e9 / static_cast<double>(CLOCKS_PER_SEC));
+}
+
+} // namespace dbgh::impl
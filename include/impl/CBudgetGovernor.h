@@ -0,0 +1,154 @@
+/**
+ * @file        CBudgetGovernor.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CBudgetGovernor class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "CAssertProbe.h"
+
+namespace dbgh::impl
+{
+
+/**
+ * @internal
+ * @class      CBudgetGovernor
+ * @brief      Keeps the CPU time spent in the evaluation of the assert expressions under the budget.
+ *
+ * @details    Every period the governor collects the evaluation costs of the sites (see \ref dbgh::CAssertProbe)
+ *              and compares their sum with the budget share of the process CPU time spent in the same period.
+ *             Over the budget, the most expensive sites are moved one step down (Full to Sampled, Sampled to
+ *              Disabled) until the projected cost fits. Under the half of the budget, the cheapest demoted sites are
+ *              moved one step up while the projected cost stays under the half, the gap avoids the oscillation.
+ *              The cost of a disabled site is the last cost measured before it was disabled.
+ *             The sites pinned by the configuration rules are counted in the cost but their modes are kept.
+ */
+class CBudgetGovernor
+{
+public:
+
+    /**
+     * @internal
+     * @brief      Starts the periodic evaluation.
+     *
+     * @param[in]  fraction  The budget, as a fraction of the process CPU time.
+     * @param[in]  period    The period of the evaluation.
+     */
+    CBudgetGovernor(double fraction, std::chrono::milliseconds period);
+
+    /**
+     * @internal
+     * @brief      Stops the periodic evaluation and moves all sites back to \ref ESiteMode::Full.
+     */
+    ~CBudgetGovernor();
+
+    CBudgetGovernor(CBudgetGovernor&&) = delete;
+
+    CBudgetGovernor(const CBudgetGovernor&) = delete;
+
+    CBudgetGovernor& operator=(CBudgetGovernor&&) = delete;
+
+    CBudgetGovernor& operator=(const CBudgetGovernor&) = delete;
+
+    /**
+     * @internal
+     * @brief      Collects the costs and updates the site modes.
+     */
+    void Evaluate();
+
+    /**
+     * @internal
+     * @brief      Gets the cost measured by the last evaluation.
+     *
+     * @return     The cost, as a fraction of the process CPU time.
+     */
+    [[nodiscard]] double GetUsage() const;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The state of the site kept between evaluations.
+     */
+    struct SSiteState
+    {
+        /**
+         * @brief      The cost of the site evaluated on every pass, in nanoseconds per period.
+         */
+        double dFullCost = 0.0;
+    };
+
+    /**
+     * @internal
+     * @brief      The loop of the background thread.
+     */
+    void workerLoop(std::stop_token stopToken);
+
+    /**
+     * @internal
+     * @brief      Gets the CPU time of the process.
+     */
+    static double processCpuNanoseconds() noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The budget, as a fraction of the process CPU time.
+     */
+    const double m_dFraction;
+
+    /**
+     * @internal
+     * @brief      The period of the evaluation.
+     */
+    const std::chrono::milliseconds m_period;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the state of the evaluation.
+     */
+    mutable std::mutex m_mtxEvaluate;
+
+    /**
+     * @internal
+     * @brief      The process CPU time at the last evaluation.
+     */
+    double m_dLastCpu;
+
+    /**
+     * @internal
+     * @brief      The cost measured by the last evaluation.
+     */
+    double m_dUsage;
+
+    /**
+     * @internal
+     * @brief      The states of the sites.
+     */
+    std::unordered_map<SAssertSite*, SSiteState> m_mapSites;
+
+    /**
+     * @internal
+     * @brief      Wakes the background thread on stop.
+     */
+    std::condition_variable_any m_cvWorker;
+
+    /**
+     * @internal
+     * @brief      The background thread, declared last to be stopped before the other members are destroyed.
+     */
+    std::jthread m_worker;
+
+}; // class CBudgetGovernor
+
+} // namespace dbgh::impl
@@ -0,0 +1,161 @@
+/**
+ * @file        CBurstScheduler.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CBurstScheduler class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <algorithm>
+
+#include "CBurstScheduler.h"
+#include "CSiteRules.h"
+
+namespace dbgh::impl
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The longest sleep of the background thread without bursts.
+ */
+constexpr std::chrono::hours s_idlePeriod { 1 };
+}  // unnamed namespace
+
+CBurstScheduler::CBurstScheduler(TUpdateWord updateWord)
+        : m_fnUpdateWord { std::move(updateWord) },
+        m_arrBitDeadlines { },
+        m_bRescheduled { false }
+{
+    m_worker = std::jthread { [this](std::stop_token stopToken) { workerLoop(std::move(stopToken)); } };
+}
+
+CBurstScheduler::~CBurstScheduler()
+{
+    m_worker.request_stop();
+    m_worker.join();
+}
+
+void CBurstScheduler::EnableBits(const std::uint64_t bits, const TClock::time_point deadline)
+{
+    std::lock_guard lock { m_mtxBursts };
+    const auto uPrevious = m_fnUpdateWord(bits, 0);
+    for (std::uint32_t uBit = 0; uBit < m_arrBitDeadlines.size(); ++uBit)
+    {
+        const auto uMask = std::uint64_t { 1 } << uBit;
+        if (0 == (bits & uMask))
+        {
+            continue;
+        }
+        // The bit enabled before the burst is not reverted, the bit of the running burst gets the later deadline.
+        auto& bitDeadline = m_arrBitDeadlines[uBit];
+        if (0 == (uPrevious & uMask))
+        {
+            bitDeadline = deadline;
+        }
+        else if (TClock::time_point { } != bitDeadline)
+        {
+            bitDeadline = std::max(bitDeadline, deadline);
+        }
+    }
+    m_bRescheduled = true;
+    m_cvWorker.notify_one();
+}
+
+void CBurstScheduler::EnableSite(std::string file, const TLine line, const TClock::time_point deadline)
+{
+    std::lock_guard lock { m_mtxBursts };
+    const auto itBurst = std::find_if(m_vecSites.begin(), m_vecSites.end(), [&file, line](const SSiteBurst& burst)
+    {
+        return burst.file == file && burst.line == line;
+    });
+    if (m_vecSites.end() != itBurst)
+    {
+        itBurst->deadline = std::max(itBurst->deadline, deadline);
+        return;
+    }
+    m_vecSites.push_back(SSiteBurst { std::move(file), line, deadline });
+    publishSites();
+    m_bRescheduled = true;
+    m_cvWorker.notify_one();
+}
+
+void CBurstScheduler::Forget(const std::uint64_t bits) noexcept
+{
+    std::lock_guard lock { m_mtxBursts };
+    for (std::uint32_t uBit = 0; uBit < m_arrBitDeadlines.size(); ++uBit)
+    {
+        if (0 != (bits & (std::uint64_t { 1 } << uBit)))
+        {
+            m_arrBitDeadlines[uBit] = { };
+        }
+    }
+}
+
+void CBurstScheduler::workerLoop(std::stop_token stopToken)
+{
+    std::unique_lock lock { m_mtxBursts };
+    while (! stopToken.stop_requested())
+    {
+        const auto nextDeadline = expire(TClock::now());
+        m_cvWorker.wait_until(lock, stopToken, nextDeadline, [this] { return m_bRescheduled; });
+        m_bRescheduled = false;
+    }
+}
+
+CBurstScheduler::TClock::time_point CBurstScheduler::expire(const TClock::time_point now)
+{
+    auto nextDeadline = now + s_idlePeriod;
+    std::uint64_t uExpired = 0;
+    for (std::uint32_t uBit = 0; uBit < m_arrBitDeadlines.size(); ++uBit)
+    {
+        auto& bitDeadline = m_arrBitDeadlines[uBit];
+        if (TClock::time_point { } == bitDeadline)
+        {
+            continue;
+        }
+        if (bitDeadline <= now)
+        {
+            uExpired |= std::uint64_t { 1 } << uBit;
+            bitDeadline = { };
+        }
+        else
+        {
+            nextDeadline = std::min(nextDeadline, bitDeadline);
+        }
+    }
+    if (0 != uExpired)
+    {
+        m_fnUpdateWord(0, uExpired);
+    }
+
+    const auto uSites = m_vecSites.size();
+    std::erase_if(m_vecSites, [now](const SSiteBurst& burst) { return burst.deadline <= now; });
+    for (const auto& burst : m_vecSites)
+    {
+        nextDeadline = std::min(nextDeadline, burst.deadline);
+    }
+    if (uSites != m_vecSites.size())
+    {
+        publishSites();
+    }
+    return nextDeadline;
+}
+
+void CBurstScheduler::publishSites() const
+{
+    std::vector<SSiteRule> vecRules;
+    vecRules.reserve(m_vecSites.size());
+    for (const auto& burst : m_vecSites)
+    {
+        SSiteRule rule;
+        rule.file = burst.file;
+        rule.line = burst.line;
+        rule.mode = ESiteMode::Full;
+        vecRules.push_back(std::move(rule));
+    }
+    CSiteRules::SetBursts(std::move(vecRules));
+}
+
+} // namespace dbgh::impl
@@ -0,0 +1,192 @@
+/**
+ * @file        CBurstScheduler.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CBurstScheduler class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CAssertSite.h"
+
+namespace dbgh::impl
+{
+
+/**
+ * @internal
+ * @class      CBurstScheduler
+ * @brief      Enables the bits of the enable word and the sites until their deadlines.
+ *
+ * @details    The bursts are enabled at once and reverted by the background thread at the deadline, so the assert
+ *              macros check neither the clock nor the deadline: the burst costs them nothing.
+ *             Only the bits which were disabled before the burst are reverted, the bits enabled before stay. The
+ *              repeated burst of the same bits or site extends the deadline. The bits changed explicitly during the
+ *              burst are forgotten (see \ref Forget) and stay as set.
+ *             The burst of the site is the pinned Full rule appended after the configuration rules, see
+ *              \ref CSiteRules::SetBursts.
+ */
+class CBurstScheduler
+{
+public:
+
+    /**
+     * @internal
+     * @brief      The clock of the deadlines.
+     */
+    using TClock = std::chrono::steady_clock;
+
+    /**
+     * @internal
+     * @brief      Sets and clears the bits of the enable word, returns the previous word.
+     */
+    using TUpdateWord = std::function<std::uint64_t(std::uint64_t set, std::uint64_t clear)>;
+
+    /**
+     * @internal
+     * @brief      Starts the background thread.
+     *
+     * @param[in]  updateWord  The function which changes the enable word.
+     */
+    explicit CBurstScheduler(TUpdateWord updateWord);
+
+    /**
+     * @internal
+     * @brief      Stops the background thread, the pending bursts stay enabled.
+     */
+    ~CBurstScheduler();
+
+    CBurstScheduler(CBurstScheduler&&) = delete;
+
+    CBurstScheduler(const CBurstScheduler&) = delete;
+
+    CBurstScheduler& operator=(CBurstScheduler&&) = delete;
+
+    CBurstScheduler& operator=(const CBurstScheduler&) = delete;
+
+    /**
+     * @internal
+     * @brief      Enables the bits of the enable word until the deadline.
+     *
+     * @param[in]  bits      The bits, see \ref EnableBit.
+     * @param[in]  deadline  The deadline.
+     */
+    void EnableBits(std::uint64_t bits, TClock::time_point deadline);
+
+    /**
+     * @internal
+     * @brief      Enables the sites of the file and the line until the deadline.
+     *
+     * @param[in]  file      The path suffix of the sites, see \ref CSiteRules::MatchesPath.
+     * @param[in]  line      The line of the sites, zero matches any line.
+     * @param[in]  deadline  The deadline.
+     */
+    void EnableSite(std::string file, TLine line, TClock::time_point deadline);
+
+    /**
+     * @internal
+     * @brief      Forgets the bursts of the bits, the bits are not reverted at the deadlines.
+     *
+     * @param[in]  bits  The bits changed explicitly.
+     */
+    void Forget(std::uint64_t bits) noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The burst of the site.
+     */
+    struct SSiteBurst
+    {
+        /**
+         * @brief      The path suffix of the sites.
+         */
+        std::string file;
+
+        /**
+         * @brief      The line of the sites.
+         */
+        TLine line;
+
+        /**
+         * @brief      The deadline.
+         */
+        TClock::time_point deadline;
+    };
+
+    /**
+     * @internal
+     * @brief      The loop of the background thread.
+     */
+    void workerLoop(std::stop_token stopToken);
+
+    /**
+     * @internal
+     * @brief      Reverts the expired bursts, returns the nearest deadline. Called under the mutex.
+     */
+    TClock::time_point expire(TClock::time_point now);
+
+    /**
+     * @internal
+     * @brief      Publishes the burst rules of the sites. Called under the mutex.
+     */
+    void publishSites() const;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The function which changes the enable word.
+     */
+    const TUpdateWord m_fnUpdateWord;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the bursts.
+     */
+    std::mutex m_mtxBursts;
+
+    /**
+     * @internal
+     * @brief      The deadlines of the bits of the enable word, the epoch if the bit has no burst.
+     */
+    std::array<TClock::time_point, 64> m_arrBitDeadlines;
+
+    /**
+     * @internal
+     * @brief      The bursts of the sites.
+     */
+    std::vector<SSiteBurst> m_vecSites;
+
+    /**
+     * @internal
+     * @brief      Set when a burst is added, the background thread recomputes the nearest deadline.
+     */
+    bool m_bRescheduled;
+
+    /**
+     * @internal
+     * @brief      Wakes the background thread on the new burst and on stop.
+     */
+    std::condition_variable_any m_cvWorker;
+
+    /**
+     * @internal
+     * @brief      The background thread, declared last to be stopped before the other members are destroyed.
+     */
+    std::jthread m_worker;
+
+}; // class CBurstScheduler
+
+} // namespace dbgh::impl
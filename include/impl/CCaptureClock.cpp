@@ -0,0 +1,207 @@
+/**
+ * @file        CCaptureClock.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CCaptureClock class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "CCaptureClock.h"
+
+namespace dbgh
+{
+
+namespace
+{
+#if defined(IMPL_DBGH_CAPTURE_TSC)
+/**
+ * @internal
+ * @brief      The minimum time between the anchor and the calibration point for a stable tick rate.
+ */
+constexpr std::chrono::milliseconds s_minCalibrationSpan { 10 };
+
+/**
+ * @internal
+ * @brief      The minimum time between the anchor and the calibration point for the provisional tick rate.
+ */
+constexpr std::chrono::microseconds s_minProvisionalSpan { 10 };
+#endif
+
+/**
+ * @internal
+ * @brief      The age of the anchor from which the next conversion takes a new anchor and recalibrates the rate.
+ */
+constexpr std::chrono::seconds s_recalibrationPeriod { 60 };
+
+/**
+ * @internal
+ * @brief      The pair of the raw ticks and the wall-clock time taken at the same moment.
+ */
+struct SAnchor
+{
+    std::uint64_t ticks;
+    std::chrono::steady_clock::time_point steady;
+    std::chrono::system_clock::time_point system;
+
+    static SAnchor Now() noexcept
+    {
+        return SAnchor { CCaptureClock::Capture().ticks, std::chrono::steady_clock::now(),
+                         std::chrono::system_clock::now() };
+    }
+};
+
+/**
+ * @internal
+ * @brief      The anchor of the conversion and the tick rate measured up to it.
+ */
+struct SCalibration
+{
+    SAnchor anchor;
+    double dNanosecondsPerTick;
+};
+
+/**
+ * @internal
+ * @brief      Gets the anchor taken at startup.
+ */
+const SAnchor& StartupAnchor() noexcept
+{
+    static const SAnchor anchor = SAnchor::Now();
+    return anchor;
+}
+
+/**
+ * @internal
+ * @brief      Takes the startup anchor during the static initialization, before the first report.
+ */
+[[maybe_unused]] const SAnchor& s_startupAnchor = StartupAnchor();
+
+/**
+ * @internal
+ * @brief      Gets the published calibration, empty until the first stable rate is measured.
+ */
+std::atomic<std::shared_ptr<const SCalibration>>& PublishedCalibration() noexcept
+{
+    static std::atomic<std::shared_ptr<const SCalibration>> s_pCalibration;
+    return s_pCalibration;
+}
+
+/**
+ * @internal
+ * @brief      Measures the length of one tick between the anchors.
+ */
+double RateBetween(const SAnchor& from, const SAnchor& to) noexcept
+{
+#if defined(IMPL_DBGH_CAPTURE_TSC)
+    const auto dNanoseconds = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(to.steady - from.steady).count());
+    return dNanoseconds / static_cast<double>(to.ticks - from.ticks);
+#else
+    static_cast<void>(from);
+    static_cast<void>(to);
+    return 1.0;
+#endif
+}
+
+/**
+ * @internal
+ * @brief      Publishes the calibration if the published one is still the expected one.
+ */
+void Publish(std::shared_ptr<const SCalibration> pExpected, const SCalibration& calibration) noexcept
+{
+    try
+    {
+        PublishedCalibration().compare_exchange_strong(
+                pExpected, std::make_shared<const SCalibration>(calibration), std::memory_order_acq_rel);
+    }
+    catch (...)
+    {
+        // The calibration is published by one of the next conversions.
+    }
+}
+
+/**
+ * @internal
+ * @brief      Gets the calibration for the conversion of the ticks.
+ *
+ * @details    Shortly after the startup the rate is estimated from the span so far and not published, the thread
+ *              never sleeps. The ticks converted meanwhile are close to the anchor, so the error of their time stays
+ *              small. Once the published anchor is older than \ref s_recalibrationPeriod, the next conversion takes
+ *              a new anchor: the rate is measured over the whole period, so its error shrinks instead of adding up,
+ *              and the wall-clock time of the anchor follows the adjustments of the system clock (NTP slew and
+ *              steps).
+ */
+SCalibration CurrentCalibration() noexcept
+{
+    auto pPublished = PublishedCalibration().load(std::memory_order_acquire);
+    if (nullptr == pPublished)
+    {
+        const auto& anchor = StartupAnchor();
+        auto current = SAnchor::Now();
+#if defined(IMPL_DBGH_CAPTURE_TSC)
+        while (current.steady - anchor.steady < s_minProvisionalSpan || current.ticks == anchor.ticks)
+        {
+            current = SAnchor::Now();
+        }
+        const SCalibration calibration { anchor, RateBetween(anchor, current) };
+        if (current.steady - anchor.steady >= s_minCalibrationSpan)
+        {
+            Publish(std::move(pPublished), calibration);
+        }
+#else
+        const SCalibration calibration { current, RateBetween(anchor, current) };
+        Publish(std::move(pPublished), calibration);
+#endif
+        return calibration;
+    }
+
+    if (std::chrono::steady_clock::now() - pPublished->anchor.steady < s_recalibrationPeriod)
+    {
+        return *pPublished;
+    }
+    const auto next = SAnchor::Now();
+    const SCalibration calibration { next, RateBetween(pPublished->anchor, next) };
+    Publish(std::move(pPublished), calibration);
+    return calibration;
+}
+}  // unnamed namespace
+
+double CCaptureClock::NanosecondsPerTick() noexcept
+{
+    return CurrentCalibration().dNanosecondsPerTick;
+}
+
+std::uint32_t CCaptureClock::CurrentThreadId() noexcept
+{
+    thread_local const std::uint32_t t_uThreadId = []
+    {
+#if defined(__linux__)
+        return static_cast<std::uint32_t>(::syscall(SYS_gettid));
+#else
+        return static_cast<std::uint32_t>(std::hash<std::thread::id> { }(std::this_thread::get_id()));
+#endif
+    }();
+    return t_uThreadId;
+}
+
+std::chrono::system_clock::time_point CCaptureClock::ToSystemTime(const std::uint64_t ticks) noexcept
+{
+    const auto calibration = CurrentCalibration();
+    const auto& anchor = calibration.anchor;
+    const auto dOffset = (static_cast<double>(ticks) - static_cast<double>(anchor.ticks))
+            * calibration.dNanosecondsPerTick;
+    const auto offset = std::chrono::nanoseconds { static_cast<std::chrono::nanoseconds::rep>(dOffset) };
+    return anchor.system + std::chrono::duration_cast<std::chrono::system_clock::duration>(offset);
+}
+
+} // namespace dbgh
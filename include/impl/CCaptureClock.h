@@ -0,0 +1,145 @@
+/**
+ * @file        CCaptureClock.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for SCaptureStamp struct and CCaptureClock class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @internal
+ * @brief      Defined if the capture clock reads the TSC: on x86 and x86-64 only, also with MSVC.
+ */
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define IMPL_DBGH_CAPTURE_TSC
+#endif
+
+#if defined(IMPL_DBGH_CAPTURE_TSC) && defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(IMPL_DBGH_CAPTURE_TSC)
+#include <x86intrin.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace dbgh
+{
+
+/**
+ * @struct     SCaptureStamp
+ * @brief      The raw time, thread and CPU of a failed assertion, captured without any conversion.
+ */
+struct SCaptureStamp
+{
+    /**
+     * @brief      The raw clock value: TSC ticks on x86, std::chrono::steady_clock nanoseconds elsewhere.
+     */
+    std::uint64_t ticks;
+
+    /**
+     * @brief      The kernel thread identifier, cached per thread.
+     */
+    std::uint32_t threadId;
+
+    /**
+     * @brief      The CPU the thread was running on, 0 if the platform does not tell it.
+     */
+    std::uint32_t cpu;
+};
+
+
+/**
+ * @class      CCaptureClock
+ * @brief      The low-cost capture of the report context and its late conversion to wall-clock time.
+ *
+ * @details    Capture reads the TSC and the CPU number with a single rdtscp on x86 (Linux keeps the CPU number in
+ *              TSC_AUX), the thread identifier is read from a per-thread cache. On the other platforms the clock is
+ *              std::chrono::steady_clock in nanoseconds (CLOCK_MONOTONIC through the vDSO on Linux, with the
+ *              nanosecond resolution needed for the interval measurements of the profiler and the budget governor),
+ *              the CPU is taken from sched_getcpu on Linux and is 0 elsewhere.
+ *             The conversion to the wall-clock time happens only when the report is rendered: the tick rate is
+ *              calibrated against std::chrono::steady_clock from an anchor taken at startup. Every minute the next
+ *              conversion takes a new anchor and recalibrates the rate over the minute, so the converted time of a
+ *              long-running process follows the adjustments of the system clock.
+ *
+ * @note       The ticks are comparable across threads on the CPUs with an invariant and synchronized TSC.
+ */
+class CCaptureClock
+{
+public:
+
+    CCaptureClock() = delete;
+
+    /**
+     * @brief      Captures the current time, thread and CPU.
+     *
+     * @return     The raw stamp.
+     */
+    [[nodiscard]] static SCaptureStamp Capture() noexcept
+    {
+        SCaptureStamp stamp { };
+#if defined(IMPL_DBGH_CAPTURE_TSC)
+        unsigned int uAux = 0;
+        stamp.ticks = __rdtscp(&uAux);
+        stamp.cpu = uAux & 0xFFFu;
+#else
+        stamp.ticks = Ticks();
+#if defined(__linux__)
+        const auto iCpu = ::sched_getcpu();
+        stamp.cpu = (iCpu < 0) ? 0 : static_cast<std::uint32_t>(iCpu);
+#endif
+#endif
+        stamp.threadId = CurrentThreadId();
+        return stamp;
+    }
+
+    /**
+     * @brief      Reads only the clock, for the interval measurements.
+     *
+     * @return     The raw clock value, in the units of \ref SCaptureStamp::ticks.
+     */
+    [[nodiscard]] static std::uint64_t Ticks() noexcept
+    {
+#if defined(IMPL_DBGH_CAPTURE_TSC)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * @brief      Gets the length of one tick, calibrated against std::chrono::steady_clock.
+     *
+     * @details    The rate is cached once 10 ms have passed since the startup anchor, the earlier calls estimate it
+     *              from the span so far and wait at most 10 microseconds, they never sleep. The cached rate is
+     *              measured again every minute, see \ref ToSystemTime.
+     *
+     * @return     The count of nanoseconds per tick.
+     */
+    [[nodiscard]] static double NanosecondsPerTick() noexcept;
+
+    /**
+     * @brief      Gets the kernel identifier of the current thread, the system call is made once per thread.
+     *
+     * @return     The thread identifier.
+     */
+    [[nodiscard]] static std::uint32_t CurrentThreadId() noexcept;
+
+    /**
+     * @brief      Converts the raw ticks to the wall-clock time.
+     *
+     * @param[in]  ticks  The ticks from \ref SCaptureStamp.
+     *
+     * @return     The wall-clock time.
+     */
+    [[nodiscard]] static std::chrono::system_clock::time_point ToSystemTime(std::uint64_t ticks) noexcept;
+
+}; // class CCaptureClock
+
+} // namespace dbgh
@@ -0,0 +1,130 @@
+/**
+ * @file        CCircuitBreaker.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CCircuitBreaker class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <array>
+#include <cstdio>
+
+#include "CAssertConfig.h"
+#include "CCircuitBreaker.h"
+#include "CReportFormatter.h"
+
+namespace dbgh::impl
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The levels stopped while the breaker is tripped: all but fatal.
+ */
+constexpr std::uint32_t s_uStoppedLevels = AllLevelsMask & ~LevelMask(EAssertLevel::Fatal);
+
+/**
+ * @internal
+ * @brief      Formats the failure rate without the fraction.
+ */
+std::string FormatRate(const double rate)
+{
+    std::array<char, 32> arrRate { };
+    std::snprintf(arrRate.data(), arrRate.size(), "%.0f", rate);
+    return arrRate.data();
+}
+}  // unnamed namespace
+
+CCircuitBreaker::CCircuitBreaker(
+        const double threshold, const std::chrono::milliseconds period, std::atomic<std::uint32_t>& tripped)
+        : m_dThreshold { threshold },
+        m_period { period },
+        m_uTripped { tripped },
+        m_lastTime { std::chrono::steady_clock::now() },
+        m_uLastFailures { countFailures().first },
+        m_uTripFailures { 0 }
+{
+    m_worker = std::jthread { [this](std::stop_token stopToken) { workerLoop(std::move(stopToken)); } };
+}
+
+CCircuitBreaker::~CCircuitBreaker()
+{
+    m_worker.request_stop();
+    m_worker.join();
+    m_uTripped.store(0, std::memory_order_relaxed);
+}
+
+void CCircuitBreaker::Evaluate()
+{
+    std::lock_guard lock { m_mtxEvaluate };
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto [uFailures, uNonFatalFailures] = countFailures();
+    const auto dSeconds = std::chrono::duration<double> { now - m_lastTime }.count();
+    const auto dRate = (dSeconds > 0.0) ? static_cast<double>(uFailures - m_uLastFailures) / dSeconds : 0.0;
+    m_lastTime = now;
+    m_uLastFailures = uFailures;
+
+    if (! IsTripped() && dRate > m_dThreshold)
+    {
+        m_uTripFailures = uNonFatalFailures;
+        m_uTripped.store(s_uStoppedLevels, std::memory_order_relaxed);
+        report("The assertion storm: " + FormatRate(dRate) + " failures per second over the threshold "
+               + FormatRate(m_dThreshold) + ", the non-fatal failures are counted only.");
+    }
+    else if (IsTripped() && dRate < m_dThreshold / 2)
+    {
+        m_uTripped.store(0, std::memory_order_relaxed);
+        report("The assertion storm is over: " + FormatRate(dRate) + " failures per second, "
+               + std::to_string(uNonFatalFailures - m_uTripFailures) + " non-fatal failures were not reported.");
+    }
+}
+
+bool CCircuitBreaker::IsTripped() const noexcept
+{
+    return 0 != m_uTripped.load(std::memory_order_relaxed);
+}
+
+void CCircuitBreaker::workerLoop(std::stop_token stopToken)
+{
+    std::mutex mtxWait;
+    std::unique_lock lock { mtxWait };
+    while (! m_cvWorker.wait_for(lock, stopToken, m_period, [] { return false; }))
+    {
+        if (stopToken.stop_requested())
+        {
+            return;
+        }
+        Evaluate();
+    }
+}
+
+void CCircuitBreaker::report(const std::string& message) noexcept
+{
+    try
+    {
+        auto& config = CAssertConfig::Get();
+        config.GetExecutor()->HandleWarning(CReportFormatter::Format(
+                config.GetReportFormat(), CCaptureClock::Capture(), EAssertLevel::Warning, message, "", "", 0, ""));
+    }
+    catch (...)
+    {
+        // The summary is best effort, the executor which throws loses it.
+    }
+}
+
+std::pair<std::uint64_t, std::uint64_t> CCircuitBreaker::countFailures() noexcept
+{
+    std::uint64_t uFailures = 0;
+    std::uint64_t uNonFatalFailures = 0;
+    CAssertSiteRegistry::ForEach([&uFailures, &uNonFatalFailures](const SAssertSite& site)
+    {
+        const auto uSiteFailures = site.failures.load(std::memory_order_relaxed);
+        uFailures += uSiteFailures;
+        uNonFatalFailures += (EAssertLevel::Fatal != site.level) ? uSiteFailures : 0;
+    });
+    return { uFailures, uNonFatalFailures };
+}
+
+} // namespace dbgh::impl
@@ -0,0 +1,156 @@
+/**
+ * @file        CCircuitBreaker.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CCircuitBreaker class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace dbgh::impl
+{
+
+/**
+ * @internal
+ * @class      CCircuitBreaker
+ * @brief      Stops the non-fatal reports of the process while the aggregate failure rate is over the threshold.
+ *
+ * @details    Every period the breaker sums the failure counts of all sites (see \ref SAssertSite::failures), the
+ *              asserting threads count nothing more. The breaker trips when the failure rate of the period exceeds
+ *              the threshold and recovers when the rate falls under the half of the threshold, the gap avoids the
+ *              oscillation. While it is tripped the failures of the warning, debug and error levels are only
+ *              counted (see \ref CAssertConfig::ShouldReport), the fatal failures are reported.
+ *             One summary report is passed to \ref CHandlerExecutor::HandleWarning on each transition: the rate and
+ *              the threshold when it trips, the count of the failures which were not reported when it recovers.
+ */
+class CCircuitBreaker
+{
+public:
+
+    /**
+     * @internal
+     * @brief      Starts the periodic evaluation.
+     *
+     * @param[in]  threshold  The failure rate which trips the breaker, in failures per second.
+     * @param[in]  period     The period of the evaluation.
+     * @param[in]  tripped    The mask of the levels stopped while the breaker is tripped, set by the breaker.
+     */
+    CCircuitBreaker(double threshold, std::chrono::milliseconds period, std::atomic<std::uint32_t>& tripped);
+
+    /**
+     * @internal
+     * @brief      Stops the periodic evaluation and closes the breaker.
+     */
+    ~CCircuitBreaker();
+
+    CCircuitBreaker(CCircuitBreaker&&) = delete;
+
+    CCircuitBreaker(const CCircuitBreaker&) = delete;
+
+    CCircuitBreaker& operator=(CCircuitBreaker&&) = delete;
+
+    CCircuitBreaker& operator=(const CCircuitBreaker&) = delete;
+
+    /**
+     * @internal
+     * @brief      Measures the failure rate since the last evaluation and trips or recovers the breaker.
+     */
+    void Evaluate();
+
+    /**
+     * @internal
+     * @brief      Determines whether the breaker is tripped.
+     *
+     * @return     True if the non-fatal reports are stopped, False otherwise.
+     */
+    [[nodiscard]] bool IsTripped() const noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The loop of the background thread.
+     */
+    void workerLoop(std::stop_token stopToken);
+
+    /**
+     * @internal
+     * @brief      Passes the summary of the transition to the executor.
+     */
+    static void report(const std::string& message) noexcept;
+
+    /**
+     * @internal
+     * @brief      Gets the sum of the failure counts of all sites, and of the non-fatal sites.
+     */
+    static std::pair<std::uint64_t, std::uint64_t> countFailures() noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The failure rate which trips the breaker, in failures per second.
+     */
+    const double m_dThreshold;
+
+    /**
+     * @internal
+     * @brief      The period of the evaluation.
+     */
+    const std::chrono::milliseconds m_period;
+
+    /**
+     * @internal
+     * @brief      The mask of the levels stopped while the breaker is tripped.
+     */
+    std::atomic<std::uint32_t>& m_uTripped;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the state of the evaluation.
+     */
+    std::mutex m_mtxEvaluate;
+
+    /**
+     * @internal
+     * @brief      The time of the last evaluation.
+     */
+    std::chrono::steady_clock::time_point m_lastTime;
+
+    /**
+     * @internal
+     * @brief      The sum of the failure counts at the last evaluation.
+     */
+    std::uint64_t m_uLastFailures;
+
+    /**
+     * @internal
+     * @brief      The sum of the failure counts of the non-fatal sites when the breaker tripped.
+     */
+    std::uint64_t m_uTripFailures;
+
+    /**
+     * @internal
+     * @brief      Wakes the background thread on stop.
+     */
+    std::condition_variable_any m_cvWorker;
+
+    /**
+     * @internal
+     * @brief      The background thread, declared last to be stopped before the other members are destroyed.
+     */
+    std::jthread m_worker;
+
+}; // class CCircuitBreaker
+
+} // namespace dbgh::impl
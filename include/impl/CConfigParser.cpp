@@ -0,0 +1,446 @@
+/**
+ * @file        CConfigParser.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CConfigParser class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <stdexcept>
+
+#include "CConfigParser.h"
+#include "CReportFormatter.h"
+
+namespace dbgh
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The maximum log2 of the sampling rate of the rules.
+ */
+constexpr std::uint32_t s_uMaxRateShift = 30;
+
+/**
+ * @internal
+ * @brief      Removes the leading and the trailing whitespaces.
+ */
+std::string_view Trim(std::string_view text) noexcept
+{
+    constexpr std::string_view whitespaces { " \t\r\n" };
+    const auto uBegin = text.find_first_not_of(whitespaces);
+    if (std::string_view::npos == uBegin)
+    {
+        return { };
+    }
+    return text.substr(uBegin, text.find_last_not_of(whitespaces) - uBegin + 1);
+}
+
+/**
+ * @internal
+ * @brief      Compares the strings ignoring the case of the ASCII letters.
+ */
+bool EqualsIgnoreCase(const std::string_view lhs, const std::string_view rhs) noexcept
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const char left, const char right)
+    {
+        const auto lower = [](const char symbol)
+        {
+            return ('A' <= symbol && symbol <= 'Z') ? static_cast<char>(symbol - 'A' + 'a') : symbol;
+        };
+        return lower(left) == lower(right);
+    });
+}
+
+/**
+ * @internal
+ * @brief      Throws the error about the entry.
+ */
+[[noreturn]] void ThrowInvalid(const std::string_view reason, const std::string_view entry)
+{
+    throw std::invalid_argument { std::string { reason } + ": '" + std::string { entry } + "'." };
+}
+
+/**
+ * @internal
+ * @brief      Parses the level name.
+ */
+EAssertLevel ParseLevel(const std::string_view name, const std::string_view entry)
+{
+    constexpr std::pair<std::string_view, EAssertLevel> arrLevels[] = {
+            { "warning", EAssertLevel::Warning },
+            { "debug", EAssertLevel::Debug },
+            { "error", EAssertLevel::Error },
+            { "fatal", EAssertLevel::Fatal } };
+    for (const auto& [levelName, level] : arrLevels)
+    {
+        if (EqualsIgnoreCase(name, levelName))
+        {
+            return level;
+        }
+    }
+    ThrowInvalid("Unknown assert level", entry);
+}
+
+/**
+ * @internal
+ * @brief      Parses the list of the levels into the level mask, "none" is the empty list.
+ */
+std::uint32_t ParseLevels(const std::string_view value, const std::string_view entry)
+{
+    std::uint32_t uMask = 0;
+    for (auto rest = EqualsIgnoreCase(value, "none") ? std::string_view { } : value; ! rest.empty(); )
+    {
+        const auto uComma = rest.find(',');
+        uMask |= LevelMask(ParseLevel(Trim(rest.substr(0, uComma)), entry));
+        rest = (std::string_view::npos == uComma) ? std::string_view { } : rest.substr(uComma + 1);
+    }
+    return uMask;
+}
+
+/**
+ * @internal
+ * @brief      Parses the list of the categories into the mask.
+ */
+std::uint32_t ParseCategories(const std::string_view value, const std::string_view entry)
+{
+    if (EqualsIgnoreCase(value, "all"))
+    {
+        return AllCategoriesMask;
+    }
+    std::uint32_t uMask = 0;
+    for (auto rest = EqualsIgnoreCase(value, "none") ? std::string_view { } : value; ! rest.empty(); )
+    {
+        const auto uComma = rest.find(',');
+        const auto uCategory = CCategoryRegistry::Find(Trim(rest.substr(0, uComma)));
+        if (! uCategory.has_value())
+        {
+            ThrowInvalid("Unknown assert category", entry);
+        }
+        uMask |= std::uint32_t { 1 } << *uCategory;
+        rest = (std::string_view::npos == uComma) ? std::string_view { } : rest.substr(uComma + 1);
+    }
+    return uMask;
+}
+
+/**
+ * @internal
+ * @brief      Parses the mode of the rule into the rule.
+ */
+void ParseMode(const std::string_view value, SSiteRule& rule, const std::string_view entry)
+{
+    constexpr std::string_view sampledPrefix { "sampled:" };
+    if (EqualsIgnoreCase(value, "full") || EqualsIgnoreCase(value, "on"))
+    {
+        rule.mode = ESiteMode::Full;
+    }
+    else if (EqualsIgnoreCase(value, "off"))
+    {
+        rule.mode = ESiteMode::Disabled;
+    }
+    else if (EqualsIgnoreCase(value, "sampled"))
+    {
+        rule.mode = ESiteMode::Sampled;
+    }
+    else if (value.size() > sampledPrefix.size() && EqualsIgnoreCase(value.substr(0, sampledPrefix.size()), sampledPrefix))
+    {
+        const auto rate = value.substr(sampledPrefix.size());
+        std::uint64_t uRate = 0;
+        const auto [pEnd, error] = std::from_chars(rate.data(), rate.data() + rate.size(), uRate);
+        if (std::errc { } != error || rate.data() + rate.size() != pEnd || uRate < 2 || ! std::has_single_bit(uRate)
+            || std::uint64_t { 1 } << s_uMaxRateShift < uRate)
+        {
+            ThrowInvalid("The sampling rate must be a power of two from 2 to 2^30", entry);
+        }
+        rule.mode = ESiteMode::Sampled;
+        rule.rateShift = static_cast<std::uint32_t>(std::countr_zero(uRate));
+    }
+    else
+    {
+        ThrowInvalid("Unknown site mode", entry);
+    }
+}
+
+/**
+ * @internal
+ * @brief      Parses one "key=value" entry into the settings.
+ */
+void ParseEntry(const std::string_view entry, SConfigSettings& settings)
+{
+    constexpr std::string_view levelPrefix { "level:" };
+    constexpr std::string_view filePrefix { "file:" };
+    constexpr std::string_view sitePrefix { "site:" };
+    constexpr std::string_view categoriesPrefix { "categories:" };
+
+    // The paths of the rules may contain '=', the value of the rule never does.
+    const auto bRule = entry.starts_with(filePrefix) || entry.starts_with(sitePrefix);
+    const auto uSeparator = bRule ? entry.rfind('=') : entry.find('=');
+    if (std::string_view::npos == uSeparator)
+    {
+        ThrowInvalid("The config entry must be 'key=value'", entry);
+    }
+    const auto key = Trim(entry.substr(0, uSeparator));
+    const auto value = Trim(entry.substr(uSeparator + 1));
+
+    if ("levels" == key)
+    {
+        settings.enableMask = ParseLevels(value, entry);
+    }
+    else if ("backoff" == key)
+    {
+        const auto uMask = ParseLevels(value, entry);
+        if (0 != (uMask & (LevelMask(EAssertLevel::Error) | LevelMask(EAssertLevel::Fatal))))
+        {
+            ThrowInvalid("The report backoff is available for the warning and debug levels only", entry);
+        }
+        settings.backoffMask = uMask;
+    }
+    else if ("categories" == key)
+    {
+        settings.categoryMask = ParseCategories(value, entry);
+    }
+    else if (key.starts_with(categoriesPrefix))
+    {
+        const auto level = ParseLevel(Trim(key.substr(categoriesPrefix.size())), entry);
+        settings.levelCategoryMasks[static_cast<std::size_t>(level)] = ParseCategories(value, entry);
+    }
+    else if ("format" == key)
+    {
+        if (EqualsIgnoreCase(value, "text"))
+        {
+            settings.reportFormat = EReportFormat::Text;
+        }
+        else if (EqualsIgnoreCase(value, "json"))
+        {
+            settings.reportFormat = EReportFormat::JsonLines;
+        }
+        else
+        {
+            ThrowInvalid("Unknown report format", entry);
+        }
+    }
+    else if ("budget" == key)
+    {
+        double dBudget = 0.0;
+        const auto [pEnd, error] = std::from_chars(value.data(), value.data() + value.size(), dBudget);
+        if (std::errc { } != error || value.data() + value.size() != pEnd || dBudget < 0.0 || dBudget > 1.0)
+        {
+            ThrowInvalid("The budget must be a fraction from 0 to 1", entry);
+        }
+        settings.cpuBudget = dBudget;
+    }
+    else if ("breaker" == key)
+    {
+        double dThreshold = 0.0;
+        const auto [pEnd, error] = std::from_chars(value.data(), value.data() + value.size(), dThreshold);
+        if (std::errc { } != error || value.data() + value.size() != pEnd || dThreshold < 0.0)
+        {
+            ThrowInvalid("The breaker threshold must be a non-negative count of failures per second", entry);
+        }
+        settings.breakerThreshold = dThreshold;
+    }
+    else if ("sketches" == key)
+    {
+        if (EqualsIgnoreCase(value, "on"))
+        {
+            settings.messageSketches = true;
+        }
+        else if (EqualsIgnoreCase(value, "off"))
+        {
+            settings.messageSketches = false;
+        }
+        else
+        {
+            ThrowInvalid("The sketches must be 'on' or 'off'", entry);
+        }
+    }
+    else if ("sink" == key)
+    {
+        if (EqualsIgnoreCase(value, "default"))
+        {
+            settings.sink = ESinkChoice::Default;
+        }
+        else if (EqualsIgnoreCase(value, "stderr"))
+        {
+            settings.sink = ESinkChoice::Stderr;
+        }
+        else if (value.starts_with(filePrefix) && value.size() > filePrefix.size())
+        {
+            settings.sink = ESinkChoice::File;
+            settings.sinkPath = value.substr(filePrefix.size());
+        }
+        else
+        {
+            ThrowInvalid("Unknown sink", entry);
+        }
+    }
+    else if (key.starts_with(levelPrefix))
+    {
+        SSiteRule rule;
+        rule.level = ParseLevel(Trim(key.substr(levelPrefix.size())), entry);
+        ParseMode(value, rule, entry);
+        settings.siteRules.push_back(std::move(rule));
+    }
+    else if (key.starts_with(filePrefix) && key.size() > filePrefix.size())
+    {
+        SSiteRule rule;
+        rule.file = key.substr(filePrefix.size());
+        ParseMode(value, rule, entry);
+        settings.siteRules.push_back(std::move(rule));
+    }
+    else if (key.starts_with(sitePrefix))
+    {
+        const auto site = key.substr(sitePrefix.size());
+        const auto uColon = site.rfind(':');
+        TLine line = 0;
+        const auto lineText = (std::string_view::npos == uColon) ? std::string_view { } : site.substr(uColon + 1);
+        const auto [pEnd, error] = std::from_chars(lineText.data(), lineText.data() + lineText.size(), line);
+        if (0 == uColon || std::string_view::npos == uColon || std::errc { } != error
+            || lineText.data() + lineText.size() != pEnd || line <= 0)
+        {
+            ThrowInvalid("The site must be 'site:<path>:<line>'", entry);
+        }
+        SSiteRule rule;
+        rule.file = site.substr(0, uColon);
+        rule.line = line;
+        ParseMode(value, rule, entry);
+        settings.siteRules.push_back(std::move(rule));
+    }
+    else
+    {
+        ThrowInvalid("Unknown config key", entry);
+    }
+}
+}  // unnamed namespace
+
+SConfigSettings CConfigParser::Parse(const std::string_view text)
+{
+    SConfigSettings settings;
+    for (auto rest = text; ! rest.empty(); )
+    {
+        const auto uEnd = rest.find_first_of(";\n");
+        const auto entry = Trim(rest.substr(0, uEnd));
+        rest = (std::string_view::npos == uEnd) ? std::string_view { } : rest.substr(uEnd + 1);
+        if (! entry.empty() && '#' != entry.front())
+        {
+            ParseEntry(entry, settings);
+        }
+    }
+    return settings;
+}
+
+std::string CConfigParser::FormatRule(const SSiteRule& rule)
+{
+    std::string strMode;
+    switch (rule.mode)
+    {
+        case ESiteMode::Sampled:
+            strMode = (0 == rule.rateShift) ? "sampled" : "sampled:" + std::to_string(std::uint64_t { 1 } << rule.rateShift);
+            break;
+        case ESiteMode::Disabled:
+            strMode = "off";
+            break;
+        case ESiteMode::Full:
+            [[fallthrough]];
+        default:
+            strMode = "full";
+            break;
+    }
+
+    std::string strEntry;
+    if (rule.level.has_value())
+    {
+        strEntry.append("level:").append(impl::CReportFormatter::ToString(*rule.level)).append("=").append(strMode);
+    }
+    if (! rule.file.empty())
+    {
+        strEntry.append(strEntry.empty() ? "" : "; ");
+        strEntry.append(0 == rule.line ? "file:" : "site:").append(rule.file);
+        strEntry.append(0 == rule.line ? "" : ":" + std::to_string(rule.line)).append("=").append(strMode);
+    }
+    return strEntry;
+}
+
+std::string CConfigParser::FormatEnableWord(const std::uint64_t word)
+{
+    std::string strLevels;
+    std::string strCategories;
+    for (std::size_t uLevel = 0; uLevel < static_cast<std::size_t>(EAssertLevel::END_ENUM_); ++uLevel)
+    {
+        const auto level = static_cast<EAssertLevel>(uLevel);
+        const auto uMask = CategoriesOf(word, level);
+        if (0 == uMask)
+        {
+            continue;
+        }
+        strLevels.append(strLevels.empty() ? "" : ",").append(impl::CReportFormatter::ToString(level));
+        if (AllCategoriesMask != uMask)
+        {
+            strCategories.append("categories:").append(impl::CReportFormatter::ToString(level)).append("=");
+            for (std::uint32_t uCategory = 0, uCount = 0; uCategory < MaxCategories; ++uCategory)
+            {
+                if (0 != (uMask & (std::uint32_t { 1 } << uCategory)))
+                {
+                    strCategories.append(0 == uCount++ ? "" : ",").append(CCategoryRegistry::Name(uCategory));
+                }
+            }
+            strCategories.append("\n");
+        }
+    }
+    return "levels=" + (strLevels.empty() ? std::string { "none" } : strLevels) + "\n" + strCategories;
+}
+
+std::uint64_t CConfigParser::UpdateEnableWord(const SConfigSettings& settings, std::uint64_t word) noexcept
+{
+    if (settings.enableMask.has_value())
+    {
+        word = EnableWordOf(*settings.enableMask);
+    }
+    for (std::size_t uLevel = 0; uLevel < settings.levelCategoryMasks.size(); ++uLevel)
+    {
+        const auto level = static_cast<EAssertLevel>(uLevel);
+        if (settings.categoryMask.has_value() && 0 != CategoriesOf(word, level))
+        {
+            word = (word & ~LevelBits(level)) | LevelBits(level, *settings.categoryMask);
+        }
+        if (settings.levelCategoryMasks[uLevel].has_value())
+        {
+            word = (word & ~LevelBits(level)) | LevelBits(level, *settings.levelCategoryMasks[uLevel]);
+        }
+    }
+    return word;
+}
+
+void CConfigParser::ResetOmitted(SConfigSettings& settings) noexcept
+{
+    if (! settings.enableMask.has_value())
+    {
+        settings.enableMask = DefaultLevels;
+    }
+    if (! settings.reportFormat.has_value())
+    {
+        settings.reportFormat = EReportFormat::Text;
+    }
+    if (! settings.cpuBudget.has_value())
+    {
+        settings.cpuBudget = 0.0;
+    }
+    if (! settings.backoffMask.has_value())
+    {
+        settings.backoffMask = 0;
+    }
+    if (! settings.breakerThreshold.has_value())
+    {
+        settings.breakerThreshold = 0.0;
+    }
+    if (! settings.messageSketches.has_value())
+    {
+        settings.messageSketches = false;
+    }
+}
+
+} // namespace dbgh
@@ -0,0 +1,210 @@
+/**
+ * @file        CConfigParser.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for ESinkChoice enum, SConfigSettings struct and CConfigParser class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CAssertCategory.h"
+#include "CReportFormatter.h"
+#include "CSiteRules.h"
+
+namespace dbgh
+{
+
+/**
+ * @enum       ESinkChoice
+ * @brief      The destination of the assertion reports chosen by the configuration.
+ */
+enum class ESinkChoice
+{
+    /**
+     * @brief   The default \ref CHandlerExecutor.
+     */
+    Default,
+
+    /**
+     * @brief   The batched \ref CWritevSink on the standard error, for all levels.
+     */
+    Stderr,
+
+    /**
+     * @brief   The \ref CRotatingFileSink with the given path, for all levels.
+     */
+    File
+};
+
+
+/**
+ * @struct     SConfigSettings
+ * @brief      The parsed configuration, the unset fields keep the current state.
+ */
+struct SConfigSettings
+{
+    /**
+     * @brief      The mask of the enabled levels, see \ref LevelMask.
+     */
+    std::optional<std::uint32_t> enableMask;
+
+    /**
+     * @brief      The mask of the enabled categories of all enabled levels, see \ref SAssertCategory.
+     */
+    std::optional<std::uint32_t> categoryMask;
+
+    /**
+     * @brief      The masks of the enabled categories of the levels, indexed by the level.
+     */
+    std::array<std::optional<std::uint32_t>, static_cast<std::size_t>(EAssertLevel::END_ENUM_)> levelCategoryMasks;
+
+    /**
+     * @brief      The output format of the reports.
+     */
+    std::optional<EReportFormat> reportFormat;
+
+    /**
+     * @brief      The CPU budget, as a fraction of the process CPU time.
+     */
+    std::optional<double> cpuBudget;
+
+    /**
+     * @brief      The mask of the levels with the report backoff, see \ref CAssertConfig::SetReportBackoff.
+     */
+    std::optional<std::uint32_t> backoffMask;
+
+    /**
+     * @brief      The failure rate which trips the circuit breaker, see \ref CAssertConfig::SetCircuitBreaker.
+     */
+    std::optional<double> breakerThreshold;
+
+    /**
+     * @brief      True to observe the failure messages, see \ref CMessageSketches.
+     */
+    std::optional<bool> messageSketches;
+
+    /**
+     * @brief      The destination of the reports.
+     */
+    std::optional<ESinkChoice> sink;
+
+    /**
+     * @brief      The path of the \ref ESinkChoice::File sink.
+     */
+    std::string sinkPath;
+
+    /**
+     * @brief      The site rules, in the order of the declaration.
+     */
+    std::vector<SSiteRule> siteRules;
+};
+
+
+/**
+ * @class      CConfigParser
+ * @brief      Parses the text configuration of the asserts.
+ *
+ * @details    The configuration is a list of "key=value" entries separated by ';' or new lines, the entries
+ *              starting with '#' are comments. The keys:
+ *              > levels=warning,debug,error,fatal  The enabled levels with all categories, "none" disables all levels.
+ *              > categories=<list>                 The enabled categories of the enabled levels.
+ *              > categories:<level>=<list>         The enabled categories of the level, enables or disables the level.
+ *              > format=text|json                  The output format of the reports.
+ *              > budget=<fraction>                 The CPU budget, 0 disables it.
+ *              > backoff=warning,debug             The levels with the report backoff, "none" disables it.
+ *              > breaker=<failures per second>     The threshold of the circuit breaker, 0 disables it.
+ *              > sketches=on|off                   The sketches of the failure messages, see \ref CMessageSketches.
+ *              > sink=default|stderr|file:<path>   The destination of the reports.
+ *              > level:<level>=<mode>              The mode of all sites of the level.
+ *              > file:<path>=<mode>                The mode of all sites of the file or the directory ("net/").
+ *              > site:<path>:<line>=<mode>         The mode of one site.
+ *             The mode is "full", "sampled", "sampled:<n>" (one of n passes, n is a power of two) or "off".
+ *             The list of the categories contains the names (see \ref DBGH_ASSERT_CATEGORY) or the indexes separated by
+ *              ',', "all" or "none". The untagged asserts are of the category "default". The names are known after the
+ *              static initialization of their declaring translation units, the indexes are known always.
+ *             The level names and the modes are case-insensitive.
+ *
+ * @example    levels=warning,error,fatal; format=json; file:net/=sampled:256; site:db/pool.cpp:120=off
+ *             categories=default,Storage; categories:debug=all
+ */
+class CConfigParser
+{
+public:
+
+    CConfigParser() = delete;
+
+    /**
+     * @brief      The levels enabled by default, Fatal is disabled.
+     */
+    static constexpr std::uint32_t DefaultLevels =
+            LevelMask(EAssertLevel::Warning) | LevelMask(EAssertLevel::Debug) | LevelMask(EAssertLevel::Error);
+
+    /**
+     * @brief      Parses the configuration.
+     *
+     * @throw      std::invalid_argument exception if an entry is malformed, the message names the entry.
+     *
+     * @param[in]  text  The configuration.
+     *
+     * @return     The settings.
+     */
+    [[nodiscard]] static SConfigSettings Parse(std::string_view text);
+
+    /**
+     * @brief      Formats the site rule as the configuration entry, see \ref Parse.
+     *
+     * @details    The rule which has both the level and the file has no entry, it is formatted as two entries
+     *              separated by "; " for the reading only.
+     *
+     * @param[in]  rule  The rule.
+     *
+     * @return     The entry, for example "site:db/pool.cpp:120=sampled:4".
+     */
+    [[nodiscard]] static std::string FormatRule(const SSiteRule& rule);
+
+    /**
+     * @brief      Formats the enable word as the configuration entries, one per line.
+     *
+     * @details    The "levels" entry lists the levels with any enabled category, the "categories:<level>" entries
+     *              follow for the levels with not all categories enabled.
+     *
+     * @param[in]  word  The enable word, see \ref EnableBit.
+     *
+     * @return     The entries, for example "levels=WARNING,DEBUG\ncategories:DEBUG=default,Storage\n".
+     */
+    [[nodiscard]] static std::string FormatEnableWord(std::uint64_t word);
+
+    /**
+     * @brief      Applies the levels and the categories of the settings to the enable word.
+     *
+     * @details    The levels are applied first, then the categories of all levels, then the categories of each level.
+     *
+     * @param[in]  settings  The settings.
+     * @param[in]  word      The current enable word, see \ref EnableBit.
+     *
+     * @return     The new enable word, the current one if the settings have neither levels nor categories.
+     */
+    [[nodiscard]] static std::uint64_t UpdateEnableWord(const SConfigSettings& settings, std::uint64_t word) noexcept;
+
+    /**
+     * @brief      Sets the omitted keys of the settings to their defaults, except the sink.
+     *
+     * @details    Used for the configuration file, which describes the whole state: the key removed from the file
+     *              returns to its default. The omitted levels are \ref DefaultLevels, the categories are applied to
+     *              them.
+     *
+     * @param[in,out]  settings  The settings.
+     */
+    static void ResetOmitted(SConfigSettings& settings) noexcept;
+
+}; // class CConfigParser
+
+} // namespace dbgh
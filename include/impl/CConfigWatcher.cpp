@@ -0,0 +1,141 @@
+/**
+ * @file        CConfigWatcher.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CConfigWatcher class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <array>
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "CConfigWatcher.h"
+
+namespace dbgh::impl
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      Reads the whole file, returns false if it cannot be read.
+ */
+bool ReadFile(const std::string& path, std::string& content)
+{
+    std::ifstream file { path };
+    if (! file)
+    {
+        return false;
+    }
+    std::stringstream stream;
+    stream << file.rdbuf();
+    content = stream.str();
+    return true;
+}
+}  // unnamed namespace
+
+CConfigWatcher::CConfigWatcher(
+        std::string path,
+        std::string content,
+        std::function<void(const std::string&)> onChange)
+        : m_strPath { std::move(path) },
+        m_strContent { std::move(content) },
+        m_fnOnChange { std::move(onChange) },
+        m_iInotifyFd { inotify_init1(IN_NONBLOCK | IN_CLOEXEC) },
+        m_iStopFd { eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) }
+{
+    const std::filesystem::path file { m_strPath };
+    const auto directory = file.has_parent_path() ? file.parent_path() : std::filesystem::path { "." };
+    if (-1 == m_iInotifyFd || -1 == m_iStopFd
+        || -1 == inotify_add_watch(m_iInotifyFd, directory.c_str(),
+                                   IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_ATTRIB))
+    {
+        const auto iError = errno;
+        if (-1 != m_iInotifyFd)
+        {
+            close(m_iInotifyFd);
+        }
+        if (-1 != m_iStopFd)
+        {
+            close(m_iStopFd);
+        }
+        throw std::system_error { iError, std::generic_category(), "Cannot watch the config file." };
+    }
+    m_worker = std::jthread { [this](std::stop_token stopToken) { workerLoop(std::move(stopToken)); } };
+}
+
+CConfigWatcher::~CConfigWatcher()
+{
+    m_worker.request_stop();
+    m_worker.join();
+    close(m_iInotifyFd);
+    close(m_iStopFd);
+}
+
+void CConfigWatcher::workerLoop(std::stop_token stopToken)
+{
+    const std::stop_callback wakeOnStop { stopToken, [this]
+    {
+        const std::uint64_t uValue = 1;
+        [[maybe_unused]] const auto iWritten = write(m_iStopFd, &uValue, sizeof(uValue));
+    } };
+
+    std::array<pollfd, 2> arrPoll { pollfd { m_iInotifyFd, POLLIN, 0 }, pollfd { m_iStopFd, POLLIN, 0 } };
+    while (! stopToken.stop_requested())
+    {
+        if (-1 == poll(arrPoll.data(), arrPoll.size(), -1))
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return;
+        }
+        if (0 != (arrPoll[1].revents & POLLIN) || ! drainEvents())
+        {
+            return;
+        }
+
+        // The writers touch the directory in several steps, the file is read when they are done.
+        pollfd quiet { m_iInotifyFd, POLLIN, 0 };
+        while (0 < poll(&quiet, 1, QuietPeriodMs))
+        {
+            if (! drainEvents())
+            {
+                return;
+            }
+        }
+
+        std::string strContent;
+        if (! stopToken.stop_requested() && ReadFile(m_strPath, strContent) && strContent != m_strContent)
+        {
+            m_strContent = std::move(strContent);
+            m_fnOnChange(m_strContent);
+        }
+    }
+}
+
+bool CConfigWatcher::drainEvents() noexcept
+{
+    alignas(inotify_event) std::array<char, 4096> arrBuffer { };
+    while (true)
+    {
+        const auto iRead = read(m_iInotifyFd, arrBuffer.data(), arrBuffer.size());
+        if (0 < iRead)
+        {
+            continue;
+        }
+        return -1 == iRead && (EAGAIN == errno || EWOULDBLOCK == errno || EINTR == errno);
+    }
+}
+
+} // namespace dbgh::impl
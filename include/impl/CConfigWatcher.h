@@ -0,0 +1,121 @@
+/**
+ * @file        CConfigWatcher.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CConfigWatcher class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace dbgh::impl
+{
+
+/**
+ * @internal
+ * @class      CConfigWatcher
+ * @brief      Watches the configuration file with inotify and passes its new content to the callback.
+ *
+ * @details    The directory of the file is watched, so the file replaced by rename (editors, configuration
+ *              managers, symlink swaps) is noticed as well as the file written in place. The events are collected
+ *              until the directory is quiet for \ref QuietPeriodMs, then the file is read and the callback is called
+ *              only if the content differs from the last one. The unreadable file is skipped until the next event.
+ *             The callback runs in the background thread of the watcher.
+ *
+ * @note       Available on Linux.
+ */
+class CConfigWatcher
+{
+public:
+
+    /**
+     * @internal
+     * @brief      The period without events after which the file is read.
+     */
+    static constexpr int QuietPeriodMs = 50;
+
+    /**
+     * @internal
+     * @brief      Starts watching.
+     *
+     * @throw      std::system_error exception if the directory cannot be watched.
+     *
+     * @param[in]  path      The path of the file.
+     * @param[in]  content   The current content of the file, the callback is not called for it.
+     * @param[in]  onChange  The callback, takes the new content.
+     */
+    CConfigWatcher(std::string path, std::string content, std::function<void(const std::string&)> onChange);
+
+    /**
+     * @internal
+     * @brief      Stops watching, waits for the running callback.
+     */
+    ~CConfigWatcher();
+
+    CConfigWatcher(CConfigWatcher&&) = delete;
+
+    CConfigWatcher(const CConfigWatcher&) = delete;
+
+    CConfigWatcher& operator=(CConfigWatcher&&) = delete;
+
+    CConfigWatcher& operator=(const CConfigWatcher&) = delete;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The loop of the background thread.
+     */
+    void workerLoop(std::stop_token stopToken);
+
+    /**
+     * @internal
+     * @brief      Reads all pending events, returns false if the watcher is stopped.
+     */
+    bool drainEvents() noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The path of the file.
+     */
+    const std::string m_strPath;
+
+    /**
+     * @internal
+     * @brief      The last content passed to the callback.
+     */
+    std::string m_strContent;
+
+    /**
+     * @internal
+     * @brief      The callback.
+     */
+    const std::function<void(const std::string&)> m_fnOnChange;
+
+    /**
+     * @internal
+     * @brief      The inotify descriptor.
+     */
+    int m_iInotifyFd;
+
+    /**
+     * @internal
+     * @brief      The eventfd which wakes the background thread on stop.
+     */
+    int m_iStopFd;
+
+    /**
+     * @internal
+     * @brief      The background thread, declared last to be stopped before the other members are destroyed.
+     */
+    std::jthread m_worker;
+
+}; // class CConfigWatcher
+
+} // namespace dbgh::impl
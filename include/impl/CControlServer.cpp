@@ -0,0 +1,338 @@
+/**
+ * @file        CControlServer.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CControlServer class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "CAssertConfig.h"
+#include "CConfigParser.h"
+#include "CControlServer.h"
+#include "CMessageSketches.h"
+#include "CSiteRules.h"
+
+namespace dbgh::impl
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The response to the help request.
+ */
+constexpr std::string_view s_strHelp =
+        "list [<path>]     the sites, optionally of the file or the directory\n"
+        "                  (a site is listed once it is reached, with its level enabled or by a site rule)\n"
+        "status            the enabled levels and categories, the report format and the CPU budget usage\n"
+        "metrics           the assertion counters in the Prometheus text format\n"
+        "sketches [<path>] the frequent and the distinct failure messages of the sites\n"
+        "rules             the site rules\n"
+        "set <config>      applies the configuration and appends its rules\n"
+        "config <config>   applies the configuration and replaces the rules\n"
+        "                  (a site:<path>:<line> rule enables the site also if its level is disabled)\n";
+
+/**
+ * @internal
+ * @brief      Removes the leading and the trailing whitespaces.
+ */
+std::string_view Trim(std::string_view text) noexcept
+{
+    constexpr std::string_view whitespaces { " \t\r\n" };
+    const auto uBegin = text.find_first_not_of(whitespaces);
+    if (std::string_view::npos == uBegin)
+    {
+        return { };
+    }
+    return text.substr(uBegin, text.find_last_not_of(whitespaces) - uBegin + 1);
+}
+
+/**
+ * @internal
+ * @brief      Gets the name of the mode of the site, in the syntax of the configuration.
+ */
+std::string ModeName(const SAssertSite& site)
+{
+    switch (CAssertConfig::GetSiteMode(site))
+    {
+        case ESiteMode::Sampled:
+        {
+            const auto uShift = (CAssertProbe::GetRule(site) & SAssertSite::RuleRateMask) >> SAssertSite::RuleRateShift;
+            return (0 == uShift) ? "sampled" : "sampled:" + std::to_string(std::uint64_t { 1 } << uShift);
+        }
+        case ESiteMode::Disabled:
+            return "off";
+        case ESiteMode::Full:
+            [[fallthrough]];
+        default:
+            return "full";
+    }
+}
+
+/**
+ * @internal
+ * @brief      Writes the whole buffer to the socket, returns false on error.
+ */
+bool SendAll(const int fd, std::string_view buffer) noexcept
+{
+#if defined(MSG_NOSIGNAL)
+    constexpr int iFlags = MSG_NOSIGNAL;
+#else
+    constexpr int iFlags = 0;
+#endif
+    while (! buffer.empty())
+    {
+        const auto iSent = send(fd, buffer.data(), buffer.size(), iFlags);
+        if (iSent < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        if (iSent <= 0)
+        {
+            return false;
+        }
+        buffer.remove_prefix(static_cast<std::size_t>(iSent));
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief      Closes the descriptor if it is open.
+ */
+void CloseFd(const int fd) noexcept
+{
+    if (-1 != fd)
+    {
+        close(fd);
+    }
+}
+}  // unnamed namespace
+
+CControlServer::CControlServer(std::string path)
+        : m_strPath { std::move(path) },
+        m_iListenFd { -1 },
+        m_arrStopPipe { -1, -1 }
+{
+    sockaddr_un address { };
+    address.sun_family = AF_UNIX;
+    if (m_strPath.empty() || m_strPath.size() >= sizeof(address.sun_path))
+    {
+        throw std::invalid_argument { "The control socket path is empty or too long: '" + m_strPath + "'." };
+    }
+    std::memcpy(address.sun_path, m_strPath.c_str(), m_strPath.size() + 1);
+
+    // The socket left by the crashed process is replaced, the other files are not touched.
+    struct stat status { };
+    if (0 == lstat(m_strPath.c_str(), &status) && S_ISSOCK(status.st_mode))
+    {
+        unlink(m_strPath.c_str());
+    }
+
+    m_iListenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    // The connections are refused until the listen, so the permissions set between the bind and the listen are
+    // never bypassed, and the umask of the process is not touched.
+    if (-1 == m_iListenFd
+        || -1 == fcntl(m_iListenFd, F_SETFD, FD_CLOEXEC)
+        || -1 == bind(m_iListenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address))
+        || -1 == fchmodat(AT_FDCWD, m_strPath.c_str(), S_IRUSR | S_IWUSR, 0)
+        || -1 == listen(m_iListenFd, SOMAXCONN)
+        || -1 == pipe(m_arrStopPipe)
+        || -1 == fcntl(m_arrStopPipe[0], F_SETFD, FD_CLOEXEC)
+        || -1 == fcntl(m_arrStopPipe[1], F_SETFD, FD_CLOEXEC))
+    {
+        const auto iError = errno;
+        CloseFd(m_iListenFd);
+        CloseFd(m_arrStopPipe[0]);
+        CloseFd(m_arrStopPipe[1]);
+        throw std::system_error { iError, std::generic_category(), "Cannot create the control socket: " + m_strPath };
+    }
+    m_worker = std::jthread { [this](std::stop_token stopToken) { serverLoop(std::move(stopToken)); } };
+}
+
+CControlServer::~CControlServer()
+{
+    m_worker.request_stop();
+    m_worker.join();
+    close(m_iListenFd);
+    close(m_arrStopPipe[0]);
+    close(m_arrStopPipe[1]);
+    unlink(m_strPath.c_str());
+}
+
+std::string CControlServer::Execute(const std::string_view request)
+{
+    const auto line = Trim(request);
+    const auto uSpace = line.find_first_of(" \t");
+    const auto command = line.substr(0, uSpace);
+    const auto argument = (std::string_view::npos == uSpace) ? std::string_view { } : Trim(line.substr(uSpace));
+
+    std::string strResponse;
+    try
+    {
+        auto& config = CAssertConfig::Get();
+        if ("list" == command)
+        {
+            CAssertSiteRegistry::ForEach([&strResponse, argument](const SAssertSite& site)
+            {
+                if (argument.empty() || CSiteRules::MatchesPath(site.file, argument))
+                {
+                    strResponse.append(std::to_string(site.id)).append("\t")
+                               .append(CReportFormatter::ToString(site.level)).append("\t")
+                               .append(site.file).append(":").append(std::to_string(site.line)).append("\t")
+                               .append(ModeName(site)).append("\t")
+                               .append(std::to_string(site.failures.load(std::memory_order_relaxed))).append("\t")
+                               .append(site.expression).append("\n");
+                }
+            });
+        }
+        else if ("status" == command)
+        {
+            std::size_t uSites = 0;
+            CAssertSiteRegistry::ForEach([&uSites](const SAssertSite&) { ++uSites; });
+            std::array<char, 32> arrUsage { };
+            std::snprintf(arrUsage.data(), arrUsage.size(), "%.6f", config.GetCpuBudgetUsage());
+            strResponse.append(CConfigParser::FormatEnableWord(config.GetEnableWord()))
+                       .append("format=").append(EReportFormat::JsonLines == config.GetReportFormat() ? "json" : "text").append("\n")
+                       .append("budget_usage=").append(arrUsage.data()).append("\n")
+                       .append("breaker=").append(config.IsCircuitBreakerTripped() ? "tripped" : "closed").append("\n")
+                       .append("sites=").append(std::to_string(uSites)).append("\n")
+                       .append("rules=").append(std::to_string(CSiteRules::Get().size())).append("\n");
+        }
+        else if ("metrics" == command)
+        {
+            strResponse.append(config.RenderMetrics());
+        }
+        else if ("sketches" == command)
+        {
+            for (const auto& sketch : CMessageSketches::Collect())
+            {
+                if (argument.empty() || CSiteRules::MatchesPath(sketch.pSite->file, argument))
+                {
+                    strResponse.append(CMessageSketches::Format(sketch));
+                }
+            }
+        }
+        else if ("rules" == command)
+        {
+            for (const auto& rule : CSiteRules::Get())
+            {
+                strResponse.append(CConfigParser::FormatRule(rule)).append("\n");
+            }
+        }
+        else if ("set" == command)
+        {
+            config.Amend(argument);
+        }
+        else if ("config" == command)
+        {
+            config.Configure(argument);
+        }
+        else if ("help" == command)
+        {
+            strResponse.append(s_strHelp);
+        }
+        else
+        {
+            throw std::invalid_argument { "Unknown request: '" + std::string { command } + "', see 'help'." };
+        }
+    }
+    catch (const std::exception& e)
+    {
+        return std::string { "error: " } + e.what() + "\n";
+    }
+    return strResponse.append("ok\n");
+}
+
+void CControlServer::serverLoop(std::stop_token stopToken) noexcept
+{
+    const std::stop_callback wakeOnStop { stopToken, [this]
+    {
+        const char chStop = 0;
+        [[maybe_unused]] const auto iWritten = write(m_arrStopPipe[1], &chStop, 1);
+    } };
+
+    std::array<pollfd, 2> arrPoll { pollfd { m_iListenFd, POLLIN, 0 }, pollfd { m_arrStopPipe[0], POLLIN, 0 } };
+    while (! stopToken.stop_requested())
+    {
+        if (-1 == poll(arrPoll.data(), arrPoll.size(), -1))
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return;
+        }
+        if (0 != arrPoll[1].revents)
+        {
+            return;
+        }
+        if (0 != (arrPoll[0].revents & POLLIN))
+        {
+            const auto iClientFd = accept(m_iListenFd, nullptr, nullptr);
+            if (-1 != iClientFd)
+            {
+                serveClient(iClientFd);
+                close(iClientFd);
+            }
+        }
+    }
+}
+
+void CControlServer::serveClient(const int fd) noexcept
+{
+    // The slow or stuck client does not hold the server longer than the timeout.
+    const timeval timeout { ClientTimeoutMs / 1000, (ClientTimeoutMs % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#if defined(SO_NOSIGPIPE)
+    const int iNoSigPipe = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &iNoSigPipe, sizeof(iNoSigPipe));
+#endif
+
+    try
+    {
+        std::string strRequest;
+        std::array<char, 4096> arrBuffer { };
+        while (std::string::npos == strRequest.find('\n'))
+        {
+            const auto iRead = recv(fd, arrBuffer.data(), arrBuffer.size(), 0);
+            if (iRead < 0 && EINTR == errno)
+            {
+                continue;
+            }
+            if (iRead <= 0)
+            {
+                break;
+            }
+            strRequest.append(arrBuffer.data(), static_cast<std::size_t>(iRead));
+            if (strRequest.size() > MaxRequestSize)
+            {
+                SendAll(fd, "error: The request is too long.\n");
+                return;
+            }
+        }
+        SendAll(fd, Execute(strRequest.substr(0, strRequest.find('\n'))));
+    }
+    catch (...)
+    {
+        // Out of memory, the client gets the closed connection.
+    }
+}
+
+} // namespace dbgh::impl
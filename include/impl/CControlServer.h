@@ -0,0 +1,143 @@
+/**
+ * @file        CControlServer.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CControlServer class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace dbgh::impl
+{
+
+/**
+ * @internal
+ * @class      CControlServer
+ * @brief      Serves the control requests of the asserts on the Unix domain socket.
+ *
+ * @details    The client connects, sends one request line and reads the response until the server closes the
+ *              connection. The response lines are followed by the status line, "ok" or "error: <reason>".
+ *              The requests:
+ *              > list [<path>]     The sites, optionally of the file or the directory ("net/"), one per line:
+ *                                  id, level, file:line, mode, failures and expression separated by tabs.
+ *              > status            The enabled levels, the report format, the CPU budget usage, the state of the
+ *                                  circuit breaker, the counts.
+ *              > metrics           The assertion counters in the Prometheus text format, see \ref CMetricsExporter.
+ *              > sketches [<path>] The frequent and the distinct failure messages of the sites, optionally of the
+ *                                  file or the directory, see \ref CMessageSketches::Format.
+ *              > rules             The site rules, one entry per line.
+ *              > set <config>      Applies the configuration and appends its rules, see \ref CAssertConfig::Amend.
+ *              > config <config>   Applies the configuration and replaces the rules, see \ref CAssertConfig::Configure.
+ *              > help              The list of the requests.
+ *             The clients are served one by one in the background thread, the asserting threads are never involved.
+ *             The site is registered when it is reached, so list shows the sites reached with their level enabled
+ *              and, while a site rule ("site:db/pool.cpp:120=full") is set, the sites of its disabled level, see
+ *              \ref CSiteRules::Enables. The rule enables its site and leaves the other sites of the level disabled.
+ *             The socket file is restricted to the owner between the bind and the listen, before any client can
+ *              connect; the umask of the process is not changed.
+ *
+ * @example    dbgh-ctl /tmp/server.asserts set "file:net/=off; level:warning=sampled:64"
+ *
+ * @note       Available on POSIX platforms.
+ */
+class CControlServer
+{
+public:
+
+    /**
+     * @internal
+     * @brief      The maximum length of the request line.
+     */
+    static constexpr std::size_t MaxRequestSize = 64 * 1024;
+
+    /**
+     * @internal
+     * @brief      The timeout of the reading and the writing of one client.
+     */
+    static constexpr int ClientTimeoutMs = 1000;
+
+    /**
+     * @internal
+     * @brief      Creates the socket and starts serving.
+     *
+     * @details    The stale socket file of the path is replaced.
+     *
+     * @throw      std::system_error exception if the socket cannot be created.
+     * @throw      std::invalid_argument exception if the path is too long for the socket address.
+     *
+     * @param[in]  path  The path of the socket.
+     */
+    explicit CControlServer(std::string path);
+
+    /**
+     * @internal
+     * @brief      Stops serving and removes the socket file.
+     */
+    ~CControlServer();
+
+    CControlServer(CControlServer&&) = delete;
+
+    CControlServer(const CControlServer&) = delete;
+
+    CControlServer& operator=(CControlServer&&) = delete;
+
+    CControlServer& operator=(const CControlServer&) = delete;
+
+    /**
+     * @internal
+     * @brief      Executes the request.
+     *
+     * @param[in]  request  The request line.
+     *
+     * @return     The response, ending with the status line.
+     */
+    [[nodiscard]] static std::string Execute(std::string_view request);
+
+private:
+
+    /**
+     * @internal
+     * @brief      The loop of the background thread.
+     */
+    void serverLoop(std::stop_token stopToken) noexcept;
+
+    /**
+     * @internal
+     * @brief      Reads the request of the client and writes the response.
+     */
+    static void serveClient(int fd) noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The path of the socket.
+     */
+    const std::string m_strPath;
+
+    /**
+     * @internal
+     * @brief      The listening socket.
+     */
+    int m_iListenFd;
+
+    /**
+     * @internal
+     * @brief      The pipe which wakes the background thread on stop: the read end and the write end.
+     */
+    int m_arrStopPipe[2];
+
+    /**
+     * @internal
+     * @brief      The background thread, declared last to be stopped before the other members are destroyed.
+     */
+    std::jthread m_worker;
+
+}; // class CControlServer
+
+} // namespace dbgh::impl
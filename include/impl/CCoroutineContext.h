@@ -0,0 +1,540 @@
+/**
+ * @file        CCoroutineContext.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for the coroutine integration of the per-thread assert state.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "CRequestSampling.h"
+#include "CScopedContext.h"
+
+namespace dbgh
+{
+
+/**
+ * @struct     SAssertThreadState
+ * @brief      The per-thread assert state: the \ref CScopedContext stack and the \ref CRequestSampling level mask.
+ */
+struct SAssertThreadState
+{
+    /**
+     * @brief      The innermost context frame.
+     */
+    const SContextFrame* pContext;
+
+    /**
+     * @brief      The level mask.
+     */
+    std::uint32_t levelMask;
+
+    /**
+     * @brief      Gets the state of the current thread.
+     *
+     * @return     The state.
+     */
+    [[nodiscard]] static SAssertThreadState Current() noexcept
+    {
+        return SAssertThreadState { CScopedContext::Top(), CRequestSampling::ThreadMask() };
+    }
+
+    /**
+     * @brief      Makes this state the state of the current thread.
+     */
+    void Install() const noexcept
+    {
+        CScopedContext::SetTop(pContext);
+        CRequestSampling::SetThreadMask(levelMask);
+    }
+};
+
+
+/**
+ * @class      CAssertTaskContext
+ * @brief      The assert state of one coroutine, switched in and out of the thread at the suspension points.
+ *
+ * @details    The task starts with a copy of the state of the thread which creates it: the context frames are
+ *              rendered into the storage of this object, so the task does not reference the frames (and the values)
+ *              of the creator, which may return before the task is finished. At suspension the state of the task is
+ *              saved and the state of the thread which resumed the task is restored, at resumption it is the other
+ *              way round.
+ *             The copies live in the fixed storage of this object, in the promise of the task, so the task start
+ *              allocates no memory: the outermost \ref MaxFrames frames of the creator are copied and the deeper ones
+ *              are dropped, the values share \ref MaxTextLength bytes and the value past them is cut. The values are
+ *              rendered through a per-thread buffer which keeps its capacity.
+ */
+class CAssertTaskContext
+{
+public:
+
+    /**
+     * @brief      The maximum count of the copied context frames of the creator.
+     */
+    static constexpr std::size_t MaxFrames = 8;
+
+    /**
+     * @brief      The maximum total length of the rendered values of the copied frames.
+     */
+    static constexpr std::size_t MaxTextLength = 256;
+
+    /**
+     * @brief      Captures the state of the current thread as the initial state of the task.
+     */
+    CAssertTaskContext()
+            : m_arrValues { },
+            m_arrFrames { },
+            m_arrText { },
+            m_task { nullptr, CRequestSampling::ThreadMask() },
+            m_resumer { m_task }
+    {
+        copyFrames(CScopedContext::Top());
+    }
+
+    CAssertTaskContext(CAssertTaskContext&&) = delete;
+
+    CAssertTaskContext(const CAssertTaskContext&) = delete;
+
+    CAssertTaskContext& operator=(CAssertTaskContext&&) = delete;
+
+    CAssertTaskContext& operator=(const CAssertTaskContext&) = delete;
+
+    /**
+     * @brief      Saves the state of the task and restores the state of the resuming thread.
+     */
+    void Suspend() noexcept
+    {
+        m_task = SAssertThreadState::Current();
+        m_resumer.Install();
+    }
+
+    /**
+     * @brief      Saves the state of the resuming thread and installs the state of the task.
+     */
+    void Resume() noexcept
+    {
+        m_resumer = SAssertThreadState::Current();
+        m_task.Install();
+    }
+
+    /**
+     * @brief      Restores the state of the resuming thread when the task body is finished.
+     */
+    void Finish() noexcept
+    {
+        m_resumer.Install();
+    }
+
+    /**
+     * @brief      Gets the saved state of the task, for example to set the per-task level mask before the start.
+     *
+     * @return     The reference to the state.
+     */
+    [[nodiscard]] SAssertThreadState& TaskState() noexcept
+    {
+        return m_task;
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      Renders the values of the outermost frames and links the copies in the same order.
+     */
+    void copyFrames(const SContextFrame* pTop)
+    {
+        std::size_t uDepth = 0;
+        for (auto pFrame = pTop; nullptr != pFrame; pFrame = pFrame->parent)
+        {
+            ++uDepth;
+        }
+        std::array<const SContextFrame*, MaxFrames> arrSources { };
+        auto uIndex = uDepth;
+        for (auto pFrame = pTop; nullptr != pFrame; pFrame = pFrame->parent)
+        {
+            if (--uIndex < MaxFrames)
+            {
+                arrSources[uIndex] = pFrame;
+            }
+        }
+
+        // The outer values are rendered first, so the text cut at the capacity is the innermost one.
+        thread_local std::string t_strValue;
+        const auto uCount = std::min(uDepth, MaxFrames);
+        std::size_t uLength = 0;
+        for (uIndex = 0; uIndex < uCount; ++uIndex)
+        {
+            const auto& source = *arrSources[uIndex];
+            t_strValue.clear();
+            source.format(t_strValue, source.value);
+            const auto uCopied = std::min(t_strValue.size(), MaxTextLength - uLength);
+            std::copy_n(t_strValue.data(), uCopied, m_arrText.data() + uLength);
+            m_arrValues[uIndex] = std::string_view { m_arrText.data() + uLength, uCopied };
+            uLength += uCopied;
+            m_arrFrames[uIndex] = SContextFrame { source.name, &m_arrValues[uIndex], &formatCopy,
+                                                  (0 == uIndex) ? nullptr : &m_arrFrames[uIndex - 1] };
+        }
+        m_task.pContext = (0 == uCount) ? nullptr : &m_arrFrames[uCount - 1];
+    }
+
+    /**
+     * @internal
+     * @brief      Appends the rendered value of the copied frame.
+     */
+    static void formatCopy(std::string& buffer, const void* value)
+    {
+        buffer += *static_cast<const std::string_view*>(value);
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      The rendered values of the copied frames in \ref m_arrText, from the outermost to the innermost.
+     */
+    std::array<std::string_view, MaxFrames> m_arrValues;
+
+    /**
+     * @internal
+     * @brief      The copies of the creator frames, in the order of \ref m_arrValues.
+     */
+    std::array<SContextFrame, MaxFrames> m_arrFrames;
+
+    /**
+     * @internal
+     * @brief      The text of the rendered values.
+     */
+    std::array<char, MaxTextLength> m_arrText;
+
+    /**
+     * @internal
+     * @brief      The state of the task while it is suspended.
+     */
+    SAssertThreadState m_task;
+
+    /**
+     * @internal
+     * @brief      The state of the thread which resumed the task, while the task runs.
+     */
+    SAssertThreadState m_resumer;
+
+}; // class CAssertTaskContext
+
+
+namespace impl
+{
+/**
+ * @internal
+ * @brief      Gets the awaiter of the awaitable, applying the member or the free operator co_await.
+ */
+template<class TAwaitable>
+decltype(auto) GetAwaiter(TAwaitable&& awaitable)
+{
+    if constexpr (requires { std::forward<TAwaitable>(awaitable).operator co_await(); })
+    {
+        return std::forward<TAwaitable>(awaitable).operator co_await();
+    }
+    else if constexpr (requires { operator co_await(std::forward<TAwaitable>(awaitable)); })
+    {
+        return operator co_await(std::forward<TAwaitable>(awaitable));
+    }
+    else
+    {
+        return std::forward<TAwaitable>(awaitable);
+    }
+}
+} // namespace impl
+
+
+/**
+ * @class      CAssertContextAwaiter
+ * @brief      Wraps the awaiter and switches the assert state of the task around its suspension.
+ *
+ * @tparam     TAwaiter  The wrapped awaiter, a reference if the awaiter is an lvalue.
+ */
+template<class TAwaiter>
+class CAssertContextAwaiter
+{
+public:
+
+    /**
+     * @brief      Constructs the wrapper.
+     *
+     * @param[in]  awaiter  The wrapped awaiter.
+     * @param[in]  context  The assert state of the awaiting task.
+     */
+    CAssertContextAwaiter(TAwaiter&& awaiter, CAssertTaskContext& context) noexcept
+            : m_awaiter { std::forward<TAwaiter>(awaiter) },
+            m_context { context },
+            m_bSuspended { false }
+    { }
+
+    bool await_ready() noexcept(noexcept(std::declval<TAwaiter&>().await_ready()))
+    {
+        return m_awaiter.await_ready();
+    }
+
+    template<class TPromise>
+    decltype(auto) await_suspend(std::coroutine_handle<TPromise> handle)
+            noexcept(noexcept(std::declval<TAwaiter&>().await_suspend(handle)))
+    {
+        // The task may be resumed on another thread before the wrapped await_suspend returns, the members are not
+        // touched after the call.
+        m_bSuspended = true;
+        m_context.Suspend();
+        return m_awaiter.await_suspend(handle);
+    }
+
+    decltype(auto) await_resume() noexcept(noexcept(std::declval<TAwaiter&>().await_resume()))
+    {
+        if (m_bSuspended)
+        {
+            m_context.Resume();
+        }
+        return m_awaiter.await_resume();
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      The wrapped awaiter.
+     */
+    TAwaiter m_awaiter;
+
+    /**
+     * @internal
+     * @brief      The assert state of the awaiting task.
+     */
+    CAssertTaskContext& m_context;
+
+    /**
+     * @internal
+     * @brief      True if the task was suspended, the state is switched back only in this case.
+     */
+    bool m_bSuspended;
+
+}; // class CAssertContextAwaiter
+
+
+/**
+ * @class      CAssertStartAwaiter
+ * @brief      Wraps the awaiter of the initial suspension point and installs the assert state of the task when the
+ *              body starts, on the thread which starts it.
+ *
+ * @tparam     TAwaiter  The wrapped awaiter.
+ */
+template<class TAwaiter>
+class CAssertStartAwaiter
+{
+public:
+
+    /**
+     * @brief      Constructs the wrapper.
+     *
+     * @param[in]  awaiter  The wrapped awaiter.
+     * @param[in]  context  The assert state of the task.
+     */
+    CAssertStartAwaiter(TAwaiter&& awaiter, CAssertTaskContext& context) noexcept
+            : m_awaiter { std::forward<TAwaiter>(awaiter) },
+            m_context { context }
+    { }
+
+    bool await_ready() noexcept(noexcept(std::declval<TAwaiter&>().await_ready()))
+    {
+        return m_awaiter.await_ready();
+    }
+
+    template<class TPromise>
+    decltype(auto) await_suspend(std::coroutine_handle<TPromise> handle)
+            noexcept(noexcept(std::declval<TAwaiter&>().await_suspend(handle)))
+    {
+        return m_awaiter.await_suspend(handle);
+    }
+
+    decltype(auto) await_resume() noexcept(noexcept(std::declval<TAwaiter&>().await_resume()))
+    {
+        m_context.Resume();
+        return m_awaiter.await_resume();
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      The wrapped awaiter.
+     */
+    TAwaiter m_awaiter;
+
+    /**
+     * @internal
+     * @brief      The assert state of the task.
+     */
+    CAssertTaskContext& m_context;
+
+}; // class CAssertStartAwaiter
+
+
+/**
+ * @class      CAssertFinishAwaiter
+ * @brief      Wraps the awaiter of the final suspension point and gives the thread which finished the task its own
+ *              assert state back, whether the coroutine suspends there or not.
+ *
+ * @tparam     TAwaiter  The wrapped awaiter.
+ */
+template<class TAwaiter>
+class CAssertFinishAwaiter
+{
+public:
+
+    /**
+     * @brief      Constructs the wrapper.
+     *
+     * @param[in]  awaiter  The wrapped awaiter.
+     * @param[in]  context  The assert state of the task.
+     */
+    CAssertFinishAwaiter(TAwaiter&& awaiter, CAssertTaskContext& context) noexcept
+            : m_awaiter { std::forward<TAwaiter>(awaiter) },
+            m_context { context }
+    { }
+
+    bool await_ready() noexcept(noexcept(std::declval<TAwaiter&>().await_ready()))
+    {
+        // The frame may be destroyed right after the suspension, the state is restored before.
+        m_context.Finish();
+        return m_awaiter.await_ready();
+    }
+
+    template<class TPromise>
+    decltype(auto) await_suspend(std::coroutine_handle<TPromise> handle)
+            noexcept(noexcept(std::declval<TAwaiter&>().await_suspend(handle)))
+    {
+        return m_awaiter.await_suspend(handle);
+    }
+
+    decltype(auto) await_resume() noexcept(noexcept(std::declval<TAwaiter&>().await_resume()))
+    {
+        return m_awaiter.await_resume();
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      The wrapped awaiter.
+     */
+    TAwaiter m_awaiter;
+
+    /**
+     * @internal
+     * @brief      The assert state of the task.
+     */
+    CAssertTaskContext& m_context;
+
+}; // class CAssertFinishAwaiter
+
+
+/**
+ * @class      CAssertContextPromise
+ * @brief      The mixin for the coroutine promise types which carries the assert state across co_await.
+ *
+ * @details    Every co_await in the coroutine body is wrapped in \ref CAssertContextAwaiter, so the reports of the
+ *              assertions failed in the task carry the \ref CScopedContext values of the task and obey its
+ *              \ref CRequestSampling mask, whichever thread resumes it. The thread gets its own state back when the
+ *              task suspends.
+ *             The initial and the final suspension points are not passed through await_transform, the promise
+ *              wraps them with \ref InitialSuspend and \ref FinalSuspend: the task state is installed when the body
+ *              starts and the state of the thread is restored when the body ends, also if the task never suspends
+ *              between. Without them the task runs on the stack of the creator and leaves its state to the thread
+ *              which finishes it.
+ *
+ * @note       If the promise defines its own await_transform, it wraps the result in \ref CAssertContextAwaiter.
+ *
+ * @example     struct STask::promise_type : dbgh::CAssertContextPromise
+ *              {
+ *                  auto initial_suspend() noexcept { return InitialSuspend(std::suspend_always { }); }
+ *                  auto final_suspend() noexcept { return FinalSuspend(SFinalAwaiter { }); }
+ *                  ...
+ *              };
+ */
+class CAssertContextPromise
+{
+public:
+
+    /**
+     * @brief      Wraps the awaitable of the co_await expression.
+     *
+     * @param[in]  awaitable  The awaitable.
+     *
+     * @return     The wrapping awaiter.
+     */
+    template<class TAwaitable>
+    auto await_transform(TAwaitable&& awaitable)
+    {
+        using TAwaiter = decltype(impl::GetAwaiter(std::forward<TAwaitable>(awaitable)));
+        return CAssertContextAwaiter<TAwaiter> {
+                impl::GetAwaiter(std::forward<TAwaitable>(awaitable)), m_assertContext };
+    }
+
+    /**
+     * @brief      Wraps the awaitable of the initial suspension point.
+     *
+     * @param[in]  awaitable  The awaitable, for example std::suspend_always for a lazy task.
+     *
+     * @return     The wrapping awaiter.
+     */
+    template<class TAwaitable>
+    auto InitialSuspend(TAwaitable&& awaitable) noexcept
+    {
+        using TAwaiter = decltype(impl::GetAwaiter(std::forward<TAwaitable>(awaitable)));
+        return CAssertStartAwaiter<TAwaiter> {
+                impl::GetAwaiter(std::forward<TAwaitable>(awaitable)), m_assertContext };
+    }
+
+    /**
+     * @brief      Wraps the awaitable of the final suspension point.
+     *
+     * @param[in]  awaitable  The awaitable, for example the awaiter which resumes the continuation.
+     *
+     * @return     The wrapping awaiter.
+     */
+    template<class TAwaitable>
+    auto FinalSuspend(TAwaitable&& awaitable) noexcept
+    {
+        using TAwaiter = decltype(impl::GetAwaiter(std::forward<TAwaitable>(awaitable)));
+        return CAssertFinishAwaiter<TAwaiter> {
+                impl::GetAwaiter(std::forward<TAwaitable>(awaitable)), m_assertContext };
+    }
+
+    /**
+     * @brief      Gets the assert state of the task.
+     *
+     * @return     The reference to the state.
+     */
+    [[nodiscard]] CAssertTaskContext& AssertContext() noexcept
+    {
+        return m_assertContext;
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      The assert state of the task.
+     */
+    CAssertTaskContext m_assertContext;
+
+}; // class CAssertContextPromise
+
+} // namespace dbgh
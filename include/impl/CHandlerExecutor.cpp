@@ -54,4 +54,14 @@ void CHandlerExecutor::DebugPreCall()
 {
 }
 
+bool CHandlerExecutor::IsReported([[maybe_unused]] const EAssertLevel level) const noexcept
+{
+    return true;
+}
+
+void CHandlerExecutor::ShowReport([[maybe_unused]] const EAssertLevel level, std::string_view report)
+{
+    ShowMessage(report);
+}
+
 } // namespace dbgh
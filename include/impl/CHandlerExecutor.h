@@ -11,6 +11,7 @@
 #include <string_view>
 
 #include "CAssertException.h"
+#include "EAssertLevel.h"
 
 namespace dbgh
 {
@@ -182,6 +183,30 @@ public:
      */
     virtual void DebugPreCall();
 
+    /**
+     * @brief      Determines whether the reports of the level are used by the executor.
+     *
+     * @details    By default true. The report of the unused level is not formatted: the Warning assert is skipped,
+     *              HandleError and Terminate get the empty message and keep their control flow. The assert macros do
+     *              not format the message of the unused Warning and Fatal levels either, the message of the Error
+     *              level is formatted for the exception.
+     *
+     * @param[in]  level  The level of the failed assertion.
+     *
+     * @return     True if the report of the level is used, False otherwise.
+     */
+    [[nodiscard]] virtual bool IsReported(EAssertLevel level) const noexcept;
+
+    /**
+     * @brief      Shows the report of the failed assertion to the user before the action is asked.
+     *
+     * @details    By default calls \ref CHandlerExecutor::ShowMessage. Called for ASSERT_DEBUG only.
+     *
+     * @param[in]  level   The level of the failed assertion.
+     * @param[in]  report  The formatted report.
+     */
+    virtual void ShowReport(EAssertLevel level, std::string_view report);
+
 }; // class CHandlerExecutor
 
 } // namespace dbgh
@@ -0,0 +1,581 @@
+/**
+ * @file        CIoUringSink.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CIoUringSink class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "CIoUringSink.h"
+
+namespace dbgh
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The io_uring_setup(2) system call, liburing is not required.
+ */
+int IoUringSetup(const unsigned entries, io_uring_params* pParams) noexcept
+{
+#ifdef __NR_io_uring_setup
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, pParams));
+#else
+    (void) entries;
+    (void) pParams;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/**
+ * @internal
+ * @brief      The io_uring_enter(2) system call.
+ */
+int IoUringEnter(const int ringFd, const unsigned toSubmit, const unsigned minComplete, const unsigned flags) noexcept
+{
+#ifdef __NR_io_uring_enter
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+#else
+    (void) ringFd;
+    (void) toSubmit;
+    (void) minComplete;
+    (void) flags;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/**
+ * @internal
+ * @brief      The io_uring_register(2) system call.
+ */
+int IoUringRegister(const int ringFd, const unsigned opcode, const void* pArgs, const unsigned count) noexcept
+{
+#ifdef __NR_io_uring_register
+    return static_cast<int>(::syscall(__NR_io_uring_register, ringFd, opcode, pArgs, count));
+#else
+    (void) ringFd;
+    (void) opcode;
+    (void) pArgs;
+    (void) count;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/**
+ * @internal
+ * @brief      The line terminator appended to every report, the same as CHandlerExecutor::Logs does.
+ */
+char s_chLineTerminator = '\n';
+
+/**
+ * @internal
+ * @brief      Gets the field of the mapped ring by the offset reported by the kernel.
+ */
+template<class T>
+T* RingField(void* pRing, const unsigned offset) noexcept
+{
+    return reinterpret_cast<T*>(static_cast<char*>(pRing) + offset);
+}
+
+}  // unnamed namespace
+
+
+struct CIoUringSink::SRing
+{
+    /**
+     * @internal
+     * @brief      One registered buffer.
+     */
+    struct SBuffer
+    {
+        char* pData = nullptr;
+        std::size_t uUsed = 0;
+        std::size_t uSubmitted = 0;
+        std::size_t uPending = 0;
+    };
+
+    /**
+     * @internal
+     * @brief      One submitted write, the index is passed as the user data of the request.
+     */
+    struct SRequest
+    {
+        bool bInUse = false;
+        std::size_t uBuffer = 0;
+        const char* pData = nullptr;
+        std::size_t uSize = 0;
+        std::uint64_t uOffset = 0;
+    };
+
+    ~SRing()
+    {
+        if (nullptr != pSqes)
+        {
+            ::munmap(pSqes, uSqesSize);
+        }
+        if (nullptr != pCqRing && pCqRing != pSqRing)
+        {
+            ::munmap(pCqRing, uCqRingSize);
+        }
+        if (nullptr != pSqRing)
+        {
+            ::munmap(pSqRing, uSqRingSize);
+        }
+        if (iRingFd >= 0)
+        {
+            ::close(iRingFd);
+        }
+    }
+
+    int iRingFd = -1;
+
+    void* pSqRing = nullptr;
+    std::size_t uSqRingSize = 0;
+    void* pCqRing = nullptr;
+    std::size_t uCqRingSize = 0;
+    io_uring_sqe* pSqes = nullptr;
+    std::size_t uSqesSize = 0;
+
+    unsigned* pSqTail = nullptr;
+    unsigned* pSqMask = nullptr;
+    unsigned* pSqArray = nullptr;
+    unsigned* pCqHead = nullptr;
+    unsigned* pCqTail = nullptr;
+    unsigned* pCqMask = nullptr;
+    io_uring_cqe* pCqes = nullptr;
+
+    std::vector<char> vecStorage;
+    std::size_t uBufferSize = 0;
+    std::vector<SBuffer> vecBuffers;
+    std::size_t uCurrent = 0;
+
+    std::vector<SRequest> vecRequests;
+    std::size_t uInFlight = 0;
+    // The entries queued in the submission ring which the kernel has not taken yet.
+    unsigned uUnsubmitted = 0;
+
+    bool bPositional = false;
+    std::uint64_t uOffset = 0;
+};
+
+
+CIoUringSink::CIoUringSink(
+        const int fd,
+        const std::size_t bufferCount,
+        const std::size_t bufferSize,
+        const std::chrono::milliseconds maxAge)
+        : m_iFd { fd },
+        m_maxAge { maxAge },
+        m_oldestReport { },
+        m_uSyscallCount { 0 }
+{
+    auto ring = std::make_unique<SRing>();
+    const auto uBufferCount = std::clamp<std::size_t>(bufferCount, 1, 64);
+    const auto uEntries = static_cast<unsigned>(uBufferCount * 2);
+
+    io_uring_params params {};
+    ring->iRingFd = IoUringSetup(uEntries, &params);
+    if (ring->iRingFd < 0)
+    {
+        return;
+    }
+
+    ring->uSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->uCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (0 != (params.features & IORING_FEAT_SINGLE_MMAP))
+    {
+        ring->uSqRingSize = ring->uCqRingSize = std::max(ring->uSqRingSize, ring->uCqRingSize);
+    }
+
+    void* pSqRing = ::mmap(nullptr, ring->uSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                           ring->iRingFd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == pSqRing)
+    {
+        return;
+    }
+    ring->pSqRing = pSqRing;
+
+    if (0 != (params.features & IORING_FEAT_SINGLE_MMAP))
+    {
+        ring->pCqRing = ring->pSqRing;
+    }
+    else
+    {
+        void* pCqRing = ::mmap(nullptr, ring->uCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                               ring->iRingFd, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == pCqRing)
+        {
+            return;
+        }
+        ring->pCqRing = pCqRing;
+    }
+
+    ring->uSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* pSqes = ::mmap(nullptr, ring->uSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring->iRingFd, IORING_OFF_SQES);
+    if (MAP_FAILED == pSqes)
+    {
+        return;
+    }
+    ring->pSqes = static_cast<io_uring_sqe*>(pSqes);
+
+    ring->pSqTail = RingField<unsigned>(ring->pSqRing, params.sq_off.tail);
+    ring->pSqMask = RingField<unsigned>(ring->pSqRing, params.sq_off.ring_mask);
+    ring->pSqArray = RingField<unsigned>(ring->pSqRing, params.sq_off.array);
+    ring->pCqHead = RingField<unsigned>(ring->pCqRing, params.cq_off.head);
+    ring->pCqTail = RingField<unsigned>(ring->pCqRing, params.cq_off.tail);
+    ring->pCqMask = RingField<unsigned>(ring->pCqRing, params.cq_off.ring_mask);
+    ring->pCqes = RingField<io_uring_cqe>(ring->pCqRing, params.cq_off.cqes);
+
+    ring->uBufferSize = std::max<std::size_t>(bufferSize, 1);
+    ring->vecStorage.resize(ring->uBufferSize * uBufferCount);
+    ring->vecBuffers.resize(uBufferCount);
+    std::vector<iovec> vecIovecs(uBufferCount);
+    for (std::size_t i = 0; i < uBufferCount; ++i)
+    {
+        ring->vecBuffers[i].pData = ring->vecStorage.data() + i * ring->uBufferSize;
+        vecIovecs[i] = iovec { ring->vecBuffers[i].pData, ring->uBufferSize };
+    }
+    if (IoUringRegister(ring->iRingFd, IORING_REGISTER_BUFFERS, vecIovecs.data(),
+                        static_cast<unsigned>(vecIovecs.size())) < 0)
+    {
+        return;
+    }
+    if (IoUringRegister(ring->iRingFd, IORING_REGISTER_FILES, &m_iFd, 1) < 0)
+    {
+        return;
+    }
+    ring->vecRequests.resize(std::min<std::size_t>(params.sq_entries, params.cq_entries));
+
+    struct stat fileStat {};
+    const auto fileFlags = ::fcntl(m_iFd, F_GETFL);
+    if (0 == ::fstat(m_iFd, &fileStat) && S_ISREG(fileStat.st_mode) && fileFlags >= 0 && 0 == (fileFlags & O_APPEND))
+    {
+        const auto offset = ::lseek(m_iFd, 0, SEEK_CUR);
+        if (offset >= 0)
+        {
+            ring->bPositional = true;
+            ring->uOffset = static_cast<std::uint64_t>(offset);
+        }
+    }
+
+    m_pRing = std::move(ring);
+    if (m_maxAge.count() > 0)
+    {
+        m_submitter = std::jthread { [this](std::stop_token stopToken) { submitterLoop(std::move(stopToken)); } };
+    }
+}
+
+CIoUringSink::~CIoUringSink()
+{
+    if (m_submitter.joinable())
+    {
+        m_submitter.request_stop();
+        m_submitter.join();
+    }
+    Flush();
+    if (nullptr != m_pRing && m_pRing->bPositional)
+    {
+        // Keeps the file position consistent for the other users of the descriptor.
+        ::lseek(m_iFd, static_cast<off_t>(m_pRing->uOffset), SEEK_SET);
+    }
+}
+
+void CIoUringSink::Write(const EAssertLevel level, std::string_view report)
+{
+    std::lock_guard lock { m_mtxWrite };
+
+    if (nullptr == m_pRing)
+    {
+        writeDirect(report);
+        return;
+    }
+
+    auto& ring = *m_pRing;
+    const auto uSize = report.size() + 1;
+    if (uSize > ring.uBufferSize)
+    {
+        // Too big for the buffers, written directly after the reports before it.
+        submitCurrent();
+        drain();
+        writeDirect(report);
+        return;
+    }
+
+    if (ring.vecBuffers[ring.uCurrent].uUsed + uSize > ring.uBufferSize)
+    {
+        // Submits the full buffer and switches to the next one, waits if it is still used by the kernel.
+        submitCurrent();
+        ring.uCurrent = (ring.uCurrent + 1) % ring.vecBuffers.size();
+        while (0 != ring.vecBuffers[ring.uCurrent].uPending)
+        {
+            reap(true);
+        }
+        ring.vecBuffers[ring.uCurrent].uUsed = 0;
+        ring.vecBuffers[ring.uCurrent].uSubmitted = 0;
+    }
+
+    auto& buffer = ring.vecBuffers[ring.uCurrent];
+    if (buffer.uSubmitted == buffer.uUsed)
+    {
+        m_oldestReport = std::chrono::steady_clock::now();
+        m_cvBatchStarted.notify_one();
+    }
+    std::memcpy(buffer.pData + buffer.uUsed, report.data(), report.size());
+    buffer.pData[buffer.uUsed + report.size()] = s_chLineTerminator;
+    buffer.uUsed += uSize;
+
+    if (EAssertLevel::Fatal == level)
+    {
+        submitCurrent();
+        drain();
+    }
+}
+
+void CIoUringSink::Flush()
+{
+    std::lock_guard lock { m_mtxWrite };
+    if (nullptr != m_pRing)
+    {
+        submitCurrent();
+        drain();
+    }
+}
+
+bool CIoUringSink::IsUringActive() const noexcept
+{
+    return nullptr != m_pRing;
+}
+
+std::size_t CIoUringSink::SyscallCount() const noexcept
+{
+    return m_uSyscallCount.load(std::memory_order_relaxed);
+}
+
+void CIoUringSink::submitCurrent()
+{
+    auto& ring = *m_pRing;
+    auto& buffer = ring.vecBuffers[ring.uCurrent];
+    if (buffer.uSubmitted == buffer.uUsed)
+    {
+        return;
+    }
+
+    // The stream writes are completed in order only if one of them is in flight.
+    if (! ring.bPositional)
+    {
+        drain();
+    }
+    while (ring.uInFlight == ring.vecRequests.size())
+    {
+        reap(true);
+    }
+
+    const auto requestIter = std::find_if(std::begin(ring.vecRequests), std::end(ring.vecRequests),
+                                          [](const auto& request) { return ! request.bInUse; });
+    auto& request = *requestIter;
+    request.bInUse = true;
+    request.uBuffer = ring.uCurrent;
+    request.pData = buffer.pData + buffer.uSubmitted;
+    request.uSize = buffer.uUsed - buffer.uSubmitted;
+    request.uOffset = ring.bPositional ? ring.uOffset : static_cast<std::uint64_t>(-1);
+
+    const auto uTail = *ring.pSqTail;
+    const auto uIndex = uTail & *ring.pSqMask;
+    auto& sqe = ring.pSqes[uIndex];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_WRITE_FIXED;
+    sqe.flags = IOSQE_FIXED_FILE;
+    sqe.fd = 0;
+    sqe.addr = reinterpret_cast<std::uint64_t>(request.pData);
+    sqe.len = static_cast<std::uint32_t>(request.uSize);
+    sqe.off = request.uOffset;
+    sqe.buf_index = static_cast<std::uint16_t>(ring.uCurrent);
+    sqe.user_data = static_cast<std::uint64_t>(requestIter - std::begin(ring.vecRequests));
+    ring.pSqArray[uIndex] = uIndex;
+    std::atomic_ref<unsigned> { *ring.pSqTail }.store(uTail + 1, std::memory_order_release);
+
+    if (ring.bPositional)
+    {
+        ring.uOffset += request.uSize;
+    }
+    buffer.uSubmitted = buffer.uUsed;
+    ++buffer.uPending;
+    ++ring.uInFlight;
+
+    ++ring.uUnsubmitted;
+
+    // If the submission fails, the entry stays queued and is submitted by the next enter call, also by the wait
+    // in reap.
+    m_uSyscallCount.fetch_add(1, std::memory_order_relaxed);
+    int iSubmitted = 0;
+    while ((iSubmitted = IoUringEnter(ring.iRingFd, ring.uUnsubmitted, 0, 0)) < 0 && EINTR == errno)
+    {
+    }
+    if (iSubmitted > 0)
+    {
+        ring.uUnsubmitted -= std::min(ring.uUnsubmitted, static_cast<unsigned>(iSubmitted));
+    }
+}
+
+void CIoUringSink::reap(const bool bWait)
+{
+    auto& ring = *m_pRing;
+    while (0 != ring.uInFlight)
+    {
+        auto uHead = *ring.pCqHead;
+        const auto uTail = std::atomic_ref<unsigned> { *ring.pCqTail }.load(std::memory_order_acquire);
+        if (uHead == uTail)
+        {
+            if (! bWait)
+            {
+                return;
+            }
+            m_uSyscallCount.fetch_add(1, std::memory_order_relaxed);
+            const auto iSubmitted = IoUringEnter(ring.iRingFd, ring.uUnsubmitted, 1, IORING_ENTER_GETEVENTS);
+            if (iSubmitted > 0)
+            {
+                ring.uUnsubmitted -= std::min(ring.uUnsubmitted, static_cast<unsigned>(iSubmitted));
+            }
+            if (iSubmitted < 0 && EINTR != errno)
+            {
+                // The ring is broken, the pending reports are lost.
+                for (auto& buffer : ring.vecBuffers)
+                {
+                    buffer.uPending = 0;
+                }
+                for (auto& request : ring.vecRequests)
+                {
+                    request.bInUse = false;
+                }
+                ring.uInFlight = 0;
+                return;
+            }
+            continue;
+        }
+
+        for (; uHead != uTail; ++uHead)
+        {
+            const auto& cqe = ring.pCqes[uHead & *ring.pCqMask];
+            auto& request = ring.vecRequests[static_cast<std::size_t>(cqe.user_data)];
+            if (cqe.res >= 0 && static_cast<std::size_t>(cqe.res) < request.uSize)
+            {
+                // Short write, the rest is written synchronously.
+                const auto uWritten = static_cast<std::size_t>(cqe.res);
+                iovec rest { const_cast<char*>(request.pData) + uWritten, request.uSize - uWritten };
+                writeAll(&rest, 1, ring.bPositional ? static_cast<off_t>(request.uOffset + uWritten) : -1);
+            }
+            request.bInUse = false;
+            --ring.vecBuffers[request.uBuffer].uPending;
+            --ring.uInFlight;
+        }
+        std::atomic_ref<unsigned> { *ring.pCqHead }.store(uHead, std::memory_order_release);
+        return;
+    }
+}
+
+void CIoUringSink::drain()
+{
+    while (0 != m_pRing->uInFlight)
+    {
+        reap(true);
+    }
+}
+
+void CIoUringSink::writeDirect(std::string_view report)
+{
+    iovec arrIovecs[2] {
+            { const_cast<char*>(report.data()), report.size() },
+            { &s_chLineTerminator, 1 } };
+    if (nullptr != m_pRing && m_pRing->bPositional)
+    {
+        writeAll(arrIovecs, 2, static_cast<off_t>(m_pRing->uOffset));
+        m_pRing->uOffset += report.size() + 1;
+        return;
+    }
+    writeAll(arrIovecs, 2, -1);
+}
+
+void CIoUringSink::writeAll(iovec* pIovecs, std::size_t count, off_t offset)
+{
+    while (0 != count)
+    {
+        m_uSyscallCount.fetch_add(1, std::memory_order_relaxed);
+        const auto written = (offset < 0)
+                ? ::writev(m_iFd, pIovecs, static_cast<int>(count))
+                : ::pwritev(m_iFd, pIovecs, static_cast<int>(count), offset);
+        if (written < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            // The reports are dropped, there is no better place to report the failure of the assertion log.
+            return;
+        }
+
+        auto uWritten = static_cast<std::size_t>(written);
+        if (offset >= 0)
+        {
+            offset += written;
+        }
+        while (0 != count && uWritten >= pIovecs->iov_len)
+        {
+            uWritten -= pIovecs->iov_len;
+            ++pIovecs;
+            --count;
+        }
+        if (0 != count)
+        {
+            pIovecs->iov_base = static_cast<char*>(pIovecs->iov_base) + uWritten;
+            pIovecs->iov_len -= uWritten;
+        }
+    }
+}
+
+void CIoUringSink::submitterLoop(std::stop_token stopToken)
+{
+    const auto hasBatch = [this]
+    {
+        const auto& buffer = m_pRing->vecBuffers[m_pRing->uCurrent];
+        return buffer.uSubmitted != buffer.uUsed;
+    };
+
+    std::unique_lock lock { m_mtxWrite };
+    while (! stopToken.stop_requested())
+    {
+        if (! hasBatch())
+        {
+            m_cvBatchStarted.wait(lock, stopToken, hasBatch);
+            continue;
+        }
+
+        const auto deadline = m_oldestReport + m_maxAge;
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            submitCurrent();
+            continue;
+        }
+        m_cvBatchStarted.wait_until(lock, stopToken, deadline, [] { return false; });
+    }
+}
+
+} // namespace dbgh
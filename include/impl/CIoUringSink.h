@@ -0,0 +1,209 @@
+/**
+ * @file        CIoUringSink.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CIoUringSink class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include "CAssertSink.h"
+
+namespace dbgh
+{
+
+/**
+ * @class       CIoUringSink
+ * @brief       The sink which submits the reports to the kernel asynchronously using io_uring.
+ *
+ * @details     The reports are copied into a set of buffers registered in the ring, the file descriptor is
+ *               registered as a fixed file. The buffer is submitted with IORING_OP_WRITE_FIXED when it is full,
+ *               when its oldest report reaches the age limit, on Flush and after a Fatal report, so one
+ *               io_uring_enter(2) carries a batch of reports. The completions are reaped only when the buffer or
+ *               the request slot is needed again, the asserting thread waits for the kernel only when all buffers
+ *               are in flight, on Flush and after a Fatal report.
+ *             The writes to a regular file are positional, so several buffers can be in flight at once and the
+ *              order of the reports in the file is kept. For pipes, terminals and O_APPEND files only one buffer
+ *              is in flight at a time, the next buffer is filled meanwhile.
+ *             The age limit is enforced by a background thread, it is not started if the age limit is zero or
+ *              io_uring is not available.
+ *             If io_uring is not available (old kernel, seccomp, ...) the sink falls back to one writev(2) per
+ *              report.
+ *
+ * @note       Available on Linux.
+ *
+ * @example     auto router = std::make_unique<dbgh::CAssertRouter>();
+ *              router->Subscribe(dbgh::EAssertLevel::Warning, std::make_shared<dbgh::CIoUringSink>(logFd));
+ *              dbgh::CAssertConfig::Get().SetExecutor(std::move(router));
+ */
+class CIoUringSink : public CAssertSink
+{
+public:
+
+    /**
+     * @brief      Constructs the sink and sets up the ring.
+     *
+     * @param[in]  fd           The file descriptor, the sink does not own it.
+     * @param[in]  bufferCount  The count of the registered buffers.
+     * @param[in]  bufferSize   The size of every registered buffer, the bigger reports are written with writev(2).
+     * @param[in]  maxAge       The maximum time a report waits in the buffer, zero disables the age limit.
+     */
+    explicit CIoUringSink(
+            int fd,
+            std::size_t bufferCount = 8,
+            std::size_t bufferSize = 64 * 1024,
+            std::chrono::milliseconds maxAge = std::chrono::milliseconds { 100 });
+
+    /**
+     * @brief      Stops the background thread, writes the pending reports and releases the ring.
+     */
+    ~CIoUringSink() override;
+
+    /**
+     * @brief      Appends the report to the current buffer.
+     *
+     * @param[in]  level   The level of the failed assertion, the Fatal report flushes the sink.
+     * @param[in]  report  The formatted report.
+     */
+    void Write(EAssertLevel level, std::string_view report) override;
+
+    /**
+     * @brief      Submits the current buffer and waits until all writes are completed.
+     */
+    void Flush() override;
+
+    /**
+     * @brief      Determines whether the sink uses io_uring or the write(2) fallback.
+     *
+     * @return     True if io_uring is used, False otherwise.
+     */
+    [[nodiscard]] bool IsUringActive() const noexcept;
+
+    /**
+     * @brief      Gets the count of the io_uring_enter and writev calls made by the sink.
+     *
+     * @return     The count of the system calls.
+     */
+    [[nodiscard]] std::size_t SyscallCount() const noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The ring and the registered buffers, defined in the implementation file.
+     */
+    struct SRing;
+
+    /**
+     * @internal
+     * @brief      Submits the current buffer, must be called under m_mtxWrite.
+     */
+    void submitCurrent();
+
+    /**
+     * @internal
+     * @brief      Releases the completed requests, must be called under m_mtxWrite.
+     *
+     * @param[in]  bWait  If true, waits for at least one completion when none is available.
+     */
+    void reap(bool bWait);
+
+    /**
+     * @internal
+     * @brief      Waits until all submitted writes are completed, must be called under m_mtxWrite.
+     */
+    void drain();
+
+    /**
+     * @internal
+     * @brief      Writes the report and the line terminator synchronously with one writev(2), at the tracked
+     *              offset for the positional writes.
+     *
+     * @param[in]  report  The report.
+     */
+    void writeDirect(std::string_view report);
+
+    /**
+     * @internal
+     * @brief      Writes all given buffers, with pwritev(2) at the given offset or with writev(2) if the offset is
+     *              negative, retries on partial writes and EINTR.
+     *
+     * @param[in]  pIovecs  The buffers.
+     * @param[in]  count    The count of the buffers.
+     * @param[in]  offset   The offset in the file, negative for the stream writes.
+     */
+    void writeAll(iovec* pIovecs, std::size_t count, off_t offset);
+
+    /**
+     * @internal
+     * @brief      The loop of the background thread which enforces the age limit.
+     *
+     * @param[in]  stopToken  The stop token of the thread.
+     */
+    void submitterLoop(std::stop_token stopToken);
+
+private:
+
+    /**
+     * @internal
+     * @brief      The file descriptor.
+     */
+    const int m_iFd;
+
+    /**
+     * @internal
+     * @brief      The maximum time a report waits in the buffer.
+     */
+    const std::chrono::milliseconds m_maxAge;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the buffers and the ring.
+     */
+    std::mutex m_mtxWrite;
+
+    /**
+     * @internal
+     * @brief      Wakes the background thread when the first report of a batch is added.
+     */
+    std::condition_variable_any m_cvBatchStarted;
+
+    /**
+     * @internal
+     * @brief      The ring, null if io_uring is not available.
+     */
+    std::unique_ptr<SRing> m_pRing;
+
+    /**
+     * @internal
+     * @brief      The time of the oldest report which is not submitted yet.
+     */
+    std::chrono::steady_clock::time_point m_oldestReport;
+
+    /**
+     * @internal
+     * @brief      The count of the io_uring_enter and writev calls.
+     */
+    std::atomic<std::size_t> m_uSyscallCount;
+
+    /**
+     * @internal
+     * @brief      The background thread, declared last to be stopped before the other members are destroyed.
+     */
+    std::jthread m_submitter;
+
+}; // class CIoUringSink
+
+} // namespace dbgh
@@ -0,0 +1,254 @@
+/**
+ * @file        CMessageSketches.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CMessageSketches class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "CMessageSketches.h"
+#include "CReportFormatter.h"
+
+namespace dbgh
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The count of the HyperLogLog registers of one site.
+ */
+constexpr std::size_t s_uRegisterCount = std::size_t { 1 } << CMessageSketches::RegisterBits;
+
+/**
+ * @internal
+ * @brief      Mixes the bits of the string hash, the standard hash is not required to be uniform.
+ */
+std::uint64_t HashMessage(const std::string_view message) noexcept
+{
+    auto uHash = static_cast<std::uint64_t>(std::hash<std::string_view> { }(message));
+    uHash = (uHash ^ (uHash >> 30u)) * 0xbf58476d1ce4e5b9ull;
+    uHash = (uHash ^ (uHash >> 27u)) * 0x94d049bb133111ebull;
+    return uHash ^ (uHash >> 31u);
+}
+
+/**
+ * @internal
+ * @brief      The sketches of one site.
+ */
+struct SSiteState
+{
+    std::mutex mtx;
+    std::uint64_t observed = 0;
+    std::array<std::uint8_t, s_uRegisterCount> registers { };
+    std::vector<CMessageSketches::SHeavyHitter> top;
+
+    /**
+     * @internal
+     * @brief      Adds the message to the HyperLogLog: the register of the low bits keeps the maximum rank of the
+     *              high bits.
+     */
+    void AddDistinct(const std::uint64_t uHash) noexcept
+    {
+        const auto uIndex = uHash & (s_uRegisterCount - 1);
+        const auto uRank = static_cast<std::uint8_t>(
+                std::countl_zero(uHash | (s_uRegisterCount - 1)) + 1);
+        registers[uIndex] = std::max(registers[uIndex], uRank);
+    }
+
+    /**
+     * @internal
+     * @brief      Adds the weight of the message to the Space-Saving top-K: the new message takes over the minimal
+     *              counter.
+     */
+    void AddFrequent(const std::uint64_t uHash, const std::string_view message, const std::uint64_t uWeight)
+    {
+        const auto itCounter = std::find_if(top.begin(), top.end(), [uHash](const auto& counter)
+        {
+            return counter.hash == uHash;
+        });
+        if (top.end() != itCounter)
+        {
+            itCounter->count += uWeight;
+            return;
+        }
+        if (top.size() < CMessageSketches::TopCount)
+        {
+            top.push_back({ uHash, uWeight, 0, std::string { message.substr(0, CMessageSketches::SampleLength) } });
+            return;
+        }
+        auto& minimal = *std::min_element(top.begin(), top.end(), [](const auto& left, const auto& right)
+        {
+            return left.count < right.count;
+        });
+        minimal.hash = uHash;
+        minimal.error = minimal.count;
+        minimal.count += uWeight;
+        minimal.sample.assign(message.substr(0, CMessageSketches::SampleLength));
+    }
+
+    /**
+     * @internal
+     * @brief      Estimates the count of the distinct messages, with the linear counting for the small counts.
+     */
+    [[nodiscard]] double EstimateDistinct() const noexcept
+    {
+        constexpr auto dRegisters = static_cast<double>(s_uRegisterCount);
+        constexpr auto dAlpha = 0.7213 / (1.0 + 1.079 / dRegisters);
+        double dSum = 0.0;
+        std::size_t uZeros = 0;
+        for (const auto uRank : registers)
+        {
+            dSum += std::ldexp(1.0, -static_cast<int>(uRank));
+            uZeros += (0 == uRank) ? 1 : 0;
+        }
+        const auto dEstimate = dAlpha * dRegisters * dRegisters / dSum;
+        if (dEstimate <= 2.5 * dRegisters && 0 != uZeros)
+        {
+            return dRegisters * std::log(dRegisters / static_cast<double>(uZeros));
+        }
+        return dEstimate;
+    }
+};
+
+/**
+ * @internal
+ * @brief      The sketches of all sites, the states are never removed while the storage lock is shared.
+ */
+struct SStorage
+{
+    std::shared_mutex mtx;
+    std::unordered_map<const SAssertSite*, std::unique_ptr<SSiteState>> mapSites;
+};
+
+/**
+ * @internal
+ * @brief      Gets the storage.
+ */
+SStorage& Storage()
+{
+    static SStorage storage;
+    return storage;
+}
+}  // unnamed namespace
+
+std::vector<CMessageSketches::SSiteSketch> CMessageSketches::Collect()
+{
+    auto& storage = Storage();
+    std::shared_lock lock { storage.mtx };
+    std::vector<SSiteSketch> vecSketches;
+    vecSketches.reserve(storage.mapSites.size());
+    for (const auto& [pSite, pState] : storage.mapSites)
+    {
+        std::lock_guard stateLock { pState->mtx };
+        SSiteSketch sketch;
+        sketch.pSite = pSite;
+        sketch.observed = pState->observed;
+        sketch.distinct = pState->EstimateDistinct();
+        sketch.top = pState->top;
+        std::sort(sketch.top.begin(), sketch.top.end(), [](const auto& left, const auto& right)
+        {
+            return left.count > right.count;
+        });
+        vecSketches.push_back(std::move(sketch));
+    }
+    std::sort(vecSketches.begin(), vecSketches.end(), [](const auto& left, const auto& right)
+    {
+        return left.observed > right.observed;
+    });
+    return vecSketches;
+}
+
+void CMessageSketches::Reset()
+{
+    auto& storage = Storage();
+    std::unique_lock lock { storage.mtx };
+    storage.mapSites.clear();
+}
+
+std::string CMessageSketches::Format(const SSiteSketch& sketch)
+{
+    std::array<char, 32> arrDistinct { };
+    std::snprintf(arrDistinct.data(), arrDistinct.size(), "%.0f", sketch.distinct);
+    std::string strLines;
+    strLines.append(sketch.pSite->file).append(":").append(std::to_string(sketch.pSite->line)).append("\t")
+            .append(impl::CReportFormatter::ToString(sketch.pSite->level)).append("\t")
+            .append("observed ").append(std::to_string(sketch.observed)).append("\t")
+            .append("distinct ~").append(arrDistinct.data()).append("\n");
+    for (const auto& counter : sketch.top)
+    {
+        strLines.append("\t").append(std::to_string(counter.count)).append("\t")
+                .append("+-").append(std::to_string(counter.error)).append("\t")
+                .append(counter.sample).append("\n");
+    }
+    return strLines;
+}
+
+void CMessageSketches::WriteSnapshot(std::ostream& stream)
+{
+    for (const auto& sketch : Collect())
+    {
+        stream << Format(sketch);
+    }
+    stream.flush();
+}
+
+bool CMessageSketches::sampleSuppressed() noexcept
+{
+    thread_local std::uint32_t t_uState = CCaptureClock::CurrentThreadId() * 2654435761u | 1u;
+    t_uState ^= t_uState << 13u;
+    t_uState ^= t_uState >> 17u;
+    t_uState ^= t_uState << 5u;
+    return 0 == (t_uState & (SuppressedSampleRate - 1));
+}
+
+void CMessageSketches::record(
+    const SAssertSite& site, const std::string_view message, const std::uint64_t weight) noexcept
+{
+    try
+    {
+        auto& storage = Storage();
+        const auto uHash = HashMessage(message);
+        for (;;)
+        {
+            // The shared lock is held for the update, so the state is not dropped by Reset meanwhile.
+            {
+                std::shared_lock lock { storage.mtx };
+                const auto itState = storage.mapSites.find(&site);
+                if (storage.mapSites.end() != itState)
+                {
+                    auto& state = *itState->second;
+                    std::lock_guard stateLock { state.mtx };
+                    state.observed += weight;
+                    state.AddDistinct(uHash);
+                    state.AddFrequent(uHash, message, weight);
+                    return;
+                }
+            }
+            std::unique_lock lock { storage.mtx };
+            auto& pState = storage.mapSites[&site];
+            if (nullptr == pState)
+            {
+                pState = std::make_unique<SSiteState>();
+            }
+        }
+    }
+    catch (...)
+    {
+        // The sketches are best effort, the message is lost if the memory is exhausted.
+    }
+}
+
+} // namespace dbgh
@@ -0,0 +1,247 @@
+/**
+ * @file        CMessageSketches.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CMessageSketches class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CAssertSite.h"
+
+namespace dbgh
+{
+
+/**
+ * @class      CMessageSketches
+ * @brief      The per-site sketches of the failure messages: the most frequent messages and the count of the distinct
+ *              messages, in the bounded memory.
+ *
+ * @details    The sites which embed the identifiers in the messages produce millions of the distinct messages, the
+ *              exact per-message tables are not affordable. When enabled, every reported message is hashed and fed
+ *              to the sketches of its site:
+ *              > The Space-Saving top-K, \ref TopCount counters of the most frequent message hashes. The count of the
+ *                hash is overestimated by at most its error, every message more frequent than 1/K of the observed
+ *                messages of the site is in the top. The counter keeps the first characters of the message as the sample.
+ *              > The HyperLogLog of 2^\ref RegisterBits registers, the count of the distinct messages with the
+ *                standard error about 3%.
+ *             The sketches of the site are created on its first observed message and take about 2 KB. The failures
+ *              which are not reported (the filter, the backoff, the circuit breaker) are sampled: one of
+ *              \ref SuppressedSampleRate of them is formatted for the sketches only and counted with the weight
+ *              SuppressedSampleRate, so the chronic sites under the backoff are sketched by all their failures, not
+ *              by the 1st, 2nd, 4th, 8th... reported one.
+ *
+ * @note       The observed count and the counts of the top-K of the sampled failures are estimates. The distinct count
+ *              sees only the sampled messages, for the suppressed failures it is a lower bound.
+ *
+ * @example    dbgh::CMessageSketches::SetEnabled(true);
+ *             dbgh::CMessageSketches::WriteSnapshot(std::cerr);
+ */
+class CMessageSketches
+{
+public:
+
+    /**
+     * @brief      The count of the counters of the top-K sketch of one site.
+     */
+    static constexpr std::size_t TopCount = 8;
+
+    /**
+     * @brief      The log2 of the count of the HyperLogLog registers of one site.
+     */
+    static constexpr std::uint32_t RegisterBits = 10;
+
+    /**
+     * @brief      The maximum length of the message sample of the top-K counter.
+     */
+    static constexpr std::size_t SampleLength = 120;
+
+    /**
+     * @brief      One of SuppressedSampleRate failures which are not reported is formatted for the sketches, must be a
+     *              power of two.
+     */
+    static constexpr std::uint32_t SuppressedSampleRate = 64;
+
+    /**
+     * @struct     SHeavyHitter
+     * @brief      The counter of one frequent message.
+     */
+    struct SHeavyHitter
+    {
+        /**
+         * @brief      The hash of the message.
+         */
+        std::uint64_t hash = 0;
+
+        /**
+         * @brief      The estimated count of the message, never less than the real count.
+         */
+        std::uint64_t count = 0;
+
+        /**
+         * @brief      The maximum overestimation of the count.
+         */
+        std::uint64_t error = 0;
+
+        /**
+         * @brief      The beginning of the message, at most \ref SampleLength characters.
+         */
+        std::string sample;
+    };
+
+    /**
+     * @struct     SSiteSketch
+     * @brief      The snapshot of the sketches of one site.
+     */
+    struct SSiteSketch
+    {
+        /**
+         * @brief      The site.
+         */
+        const SAssertSite* pSite = nullptr;
+
+        /**
+         * @brief      The count of the observed messages.
+         */
+        std::uint64_t observed = 0;
+
+        /**
+         * @brief      The estimated count of the distinct messages.
+         */
+        double distinct = 0.0;
+
+        /**
+         * @brief      The most frequent messages, in the descending order of the count.
+         */
+        std::vector<SHeavyHitter> top;
+    };
+
+public:
+
+    CMessageSketches() = delete;
+
+    /**
+     * @brief      Enables or disables the observation of the messages, the collected sketches are kept.
+     *
+     * @param[in]  enabled  True to observe the messages.
+     */
+    static void SetEnabled(bool enabled) noexcept
+    {
+        s_bEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief      Determines whether the messages are observed.
+     *
+     * @return     True if the messages are observed, False otherwise.
+     */
+    [[nodiscard]] static bool IsEnabled() noexcept
+    {
+        return s_bEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief      Feeds the message of the failed assertion to the sketches of the site, if enabled.
+     *
+     * @param[in]  site     The site of the failed assertion.
+     * @param[in]  message  The formatted message.
+     *
+     * @return     The message.
+     */
+    [[nodiscard]] static std::string Observe(const SAssertSite& site, std::string message)
+    {
+        if (IsEnabled())
+        {
+            record(site, message);
+        }
+        return message;
+    }
+
+    /**
+     * @brief      Determines whether the failure which is not reported is sampled for the sketches, see
+     *              \ref ObserveSuppressed.
+     *
+     * @return     True for one of \ref SuppressedSampleRate failures while enabled, False otherwise.
+     */
+    [[nodiscard]] static bool ShouldSampleSuppressed() noexcept
+    {
+        return IsEnabled() && sampleSuppressed();
+    }
+
+    /**
+     * @brief      Feeds the message of the sampled failure which is not reported, it is counted with the weight
+     *              \ref SuppressedSampleRate.
+     *
+     * @param[in]  site     The site of the failed assertion.
+     * @param[in]  message  The formatted message.
+     */
+    static void ObserveSuppressed(const SAssertSite& site, const std::string_view message) noexcept
+    {
+        record(site, message, SuppressedSampleRate);
+    }
+
+    /**
+     * @brief      Takes the snapshot of the sketches of all sites.
+     *
+     * @return     The sketches of the sites with at least one observed message.
+     */
+    [[nodiscard]] static std::vector<SSiteSketch> Collect();
+
+    /**
+     * @brief      Drops the sketches of all sites.
+     */
+    static void Reset();
+
+    /**
+     * @brief      Formats the snapshot of the site.
+     *
+     * @details    The header line with tab separated fields: file:line, level, observed count, estimated distinct
+     *              count. Then one line per frequent message, indented with a tab: count, error and sample.
+     *
+     * @param[in]  sketch  The snapshot of the site.
+     *
+     * @return     The lines.
+     */
+    [[nodiscard]] static std::string Format(const SSiteSketch& sketch);
+
+    /**
+     * @brief      Writes the snapshots of all sites, see \ref Format.
+     *
+     * @param[out] stream  The output stream.
+     */
+    static void WriteSnapshot(std::ostream& stream);
+
+private:
+
+    /**
+     * @internal
+     * @brief      Draws one of \ref SuppressedSampleRate from the per-thread generator.
+     */
+    [[nodiscard]] static bool sampleSuppressed() noexcept;
+
+    /**
+     * @internal
+     * @brief      Feeds the message to the sketches of the site, it counts as weight messages.
+     */
+    static void record(const SAssertSite& site, std::string_view message, std::uint64_t weight = 1) noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      True if the messages are observed.
+     */
+    static inline std::atomic<bool> s_bEnabled { false };
+
+}; // class CMessageSketches
+
+} // namespace dbgh
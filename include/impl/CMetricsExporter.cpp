@@ -0,0 +1,238 @@
+/**
+ * @file        CMetricsExporter.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CMetricsExporter class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "CAssertConfig.h"
+#include "CAssertProfiler.h"
+#include "CMetricsExporter.h"
+#include "CReportFormatter.h"
+
+namespace dbgh::impl
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The count of the levels.
+ */
+constexpr std::size_t s_uLevelCount = static_cast<std::size_t>(EAssertLevel::END_ENUM_);
+
+/**
+ * @internal
+ * @brief      The counters of one level or one site.
+ */
+struct SCounters
+{
+    std::uint64_t failures = 0;
+    std::uint64_t suppressed = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t evaluations = 0;
+};
+
+/**
+ * @internal
+ * @brief      The counted metric: the name suffix, the help text and the counter.
+ */
+struct SMetric
+{
+    const char* name;
+    const char* help;
+    std::uint64_t SCounters::* counter;
+};
+
+/**
+ * @internal
+ * @brief      The counted metrics, the evaluations are counted only by the profiling build.
+ */
+constexpr std::array s_arrMetrics {
+        SMetric { "failures_total", "The failed assertions.", &SCounters::failures },
+        SMetric { "suppressed_total", "The failures suppressed by the report backoff or the circuit breaker.",
+                  &SCounters::suppressed },
+        SMetric { "dropped_total", "The failures dropped by the filter.", &SCounters::dropped },
+#if defined(DBGH_ASSERTS_PROFILE)
+        SMetric { "evaluations_total", "The evaluated assert expressions.", &SCounters::evaluations },
+#endif
+};
+
+/**
+ * @internal
+ * @brief      The labels of the per-site series: the file, the line and the level.
+ */
+using TSiteLabels = std::tuple<std::string_view, TLine, EAssertLevel>;
+
+/**
+ * @internal
+ * @brief      Gets the lower case name of the level.
+ */
+std::string LevelLabel(const EAssertLevel level)
+{
+    std::string strName = CReportFormatter::ToString(level);
+    for (auto& chName : strName)
+    {
+        chName = static_cast<char>(std::tolower(static_cast<unsigned char>(chName)));
+    }
+    return strName;
+}
+
+/**
+ * @internal
+ * @brief      Escapes the label value: the backslash, the double quote and the line feed.
+ */
+std::string EscapeLabel(const std::string_view value)
+{
+    std::string strEscaped;
+    strEscaped.reserve(value.size());
+    for (const auto chValue : value)
+    {
+        switch (chValue)
+        {
+            case '\\': strEscaped.append("\\\\"); break;
+            case '"': strEscaped.append("\\\""); break;
+            case '\n': strEscaped.append("\\n"); break;
+            default: strEscaped.push_back(chValue); break;
+        }
+    }
+    return strEscaped;
+}
+
+/**
+ * @internal
+ * @brief      Appends the HELP and TYPE lines of the metric.
+ */
+void AppendHeader(std::string& text, const std::string& name, const char* help, const char* type)
+{
+    text.append("# HELP ").append(name).append(" ").append(help).append("\n")
+        .append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+}  // unnamed namespace
+
+CMetricsExporter::CMetricsExporter(
+        std::string path, const std::chrono::milliseconds period, const CAssertConfig& config)
+        : m_strPath { std::move(path) },
+        m_period { period },
+        m_config { config }
+{
+    WriteFile();
+    m_worker = std::jthread { [this](std::stop_token stopToken) { workerLoop(std::move(stopToken)); } };
+}
+
+CMetricsExporter::~CMetricsExporter()
+{
+    m_worker.request_stop();
+    m_worker.join();
+}
+
+std::string CMetricsExporter::Render(const bool bBreakerTripped)
+{
+    std::unordered_map<const SAssertSite*, std::uint64_t> mapEvaluations;
+#if defined(DBGH_ASSERTS_PROFILE)
+    for (const auto& profile : CAssertProfiler::Collect())
+    {
+        mapEvaluations[profile.pSite] = profile.evaluation.count;
+    }
+#endif
+
+    // The sites with the same labels (the assert of an inline function or a template expanded into many sites) are
+    // summed into one series, the duplicate series are rejected by Prometheus.
+    std::array<SCounters, s_uLevelCount> arrLevels { };
+    std::map<TSiteLabels, SCounters> mapSites;
+    CAssertSiteRegistry::ForEach([&](const SAssertSite& site)
+    {
+        SCounters counters;
+        counters.failures = site.failures.load(std::memory_order_relaxed);
+        counters.suppressed = site.suppressed.load(std::memory_order_relaxed);
+        counters.dropped = site.dropped.load(std::memory_order_relaxed);
+        const auto itEvaluations = mapEvaluations.find(&site);
+        counters.evaluations = (mapEvaluations.end() != itEvaluations) ? itEvaluations->second : 0;
+        auto& level = arrLevels[static_cast<std::size_t>(site.level)];
+        auto& labels = mapSites[TSiteLabels { site.file, site.line, site.level }];
+        for (const auto& metric : s_arrMetrics)
+        {
+            level.*metric.counter += counters.*metric.counter;
+            labels.*metric.counter += counters.*metric.counter;
+        }
+    });
+
+    std::string strText;
+    for (const auto& metric : s_arrMetrics)
+    {
+        const auto strName = std::string { "dbgh_assert_" } + metric.name;
+        AppendHeader(strText, strName, metric.help, "counter");
+        for (std::size_t uLevel = 0; uLevel < s_uLevelCount; ++uLevel)
+        {
+            strText.append(strName).append("{level=\"").append(LevelLabel(static_cast<EAssertLevel>(uLevel)))
+                   .append("\"} ").append(std::to_string(arrLevels[uLevel].*metric.counter)).append("\n");
+        }
+    }
+    for (const auto& metric : s_arrMetrics)
+    {
+        const auto strName = std::string { "dbgh_assert_site_" } + metric.name;
+        AppendHeader(strText, strName, metric.help, "counter");
+        for (const auto& [labels, counters] : mapSites)
+        {
+            const auto& [file, line, level] = labels;
+            strText.append(strName).append("{file=\"").append(EscapeLabel(file))
+                   .append("\",line=\"").append(std::to_string(line))
+                   .append("\",level=\"").append(LevelLabel(level))
+                   .append("\"} ").append(std::to_string(counters.*metric.counter)).append("\n");
+        }
+    }
+    AppendHeader(strText, "dbgh_assert_circuit_breaker_tripped", "1 while the circuit breaker is tripped.", "gauge");
+    strText.append("dbgh_assert_circuit_breaker_tripped ")
+           .append(bBreakerTripped ? "1" : "0").append("\n");
+    return strText;
+}
+
+bool CMetricsExporter::WriteFile() const noexcept
+{
+    try
+    {
+        const auto strTemporary = m_strPath + ".tmp";
+        {
+            std::ofstream file { strTemporary, std::ios::trunc };
+            file << Render(m_config.IsCircuitBreakerTripped());
+            if (! file.flush())
+            {
+                return false;
+            }
+        }
+        return 0 == std::rename(strTemporary.c_str(), m_strPath.c_str());
+    }
+    catch (...)
+    {
+        // The file is refreshed in the next period.
+        return false;
+    }
+}
+
+void CMetricsExporter::workerLoop(std::stop_token stopToken)
+{
+    std::mutex mtxWait;
+    std::unique_lock lock { mtxWait };
+    while (! m_cvWorker.wait_for(lock, stopToken, m_period, [] { return false; }))
+    {
+        if (stopToken.stop_requested())
+        {
+            return;
+        }
+        WriteFile();
+    }
+}
+
+} // namespace dbgh::impl
@@ -0,0 +1,135 @@
+/**
+ * @file        CMetricsExporter.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CMetricsExporter class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace dbgh
+{
+class CAssertConfig;
+} // namespace dbgh
+
+namespace dbgh::impl
+{
+
+/**
+ * @internal
+ * @class      CMetricsExporter
+ * @brief      Renders the assertion counters in the Prometheus text exposition format and refreshes the metrics file.
+ *
+ * @details    The metrics, per level and per site (labels file, line and level):
+ *              > dbgh_assert_failures_total     The failed assertions, see \ref SAssertSite::failures.
+ *              > dbgh_assert_suppressed_total   The failures suppressed by the backoff or the circuit breaker.
+ *              > dbgh_assert_dropped_total      The failures dropped by the filter.
+ *              > dbgh_assert_evaluations_total  The evaluated expressions, rendered with DBGH_ASSERTS_PROFILE only.
+ *             The per-site metrics are named dbgh_assert_site_*, the sites with the same labels (for example, the
+ *              assert of a template instantiated many times) are summed into one series. The gauge
+ *              dbgh_assert_circuit_breaker_tripped is 1 while the circuit breaker is tripped.
+ *             The counters of the sites are read with relaxed loads and the per-thread evaluation counters are
+ *              aggregated by \ref CAssertProfiler::Collect, the asserting threads are not stopped.
+ *             The file is written to "<path>.tmp" and renamed, so the scraper (for example, the textfile collector
+ *              of node_exporter) never reads a partial file.
+ */
+class CMetricsExporter
+{
+public:
+
+    /**
+     * @internal
+     * @brief      Writes the metrics file and starts refreshing it.
+     *
+     * @details    The exporter reads the circuit breaker state from the given config, it does not call
+     *              \ref CAssertConfig::Get, so it can be started while the config is constructed, for example by
+     *              DBGH_ASSERTS_METRICS.
+     *
+     * @param[in]  path    The path of the file.
+     * @param[in]  period  The period of the refresh.
+     * @param[in]  config  The config which owns the exporter.
+     */
+    CMetricsExporter(std::string path, std::chrono::milliseconds period, const CAssertConfig& config);
+
+    /**
+     * @internal
+     * @brief      Stops refreshing the file, the file is kept.
+     */
+    ~CMetricsExporter();
+
+    CMetricsExporter(CMetricsExporter&&) = delete;
+
+    CMetricsExporter(const CMetricsExporter&) = delete;
+
+    CMetricsExporter& operator=(CMetricsExporter&&) = delete;
+
+    CMetricsExporter& operator=(const CMetricsExporter&) = delete;
+
+    /**
+     * @internal
+     * @brief      Renders the metrics of all sites.
+     *
+     * @param[in]  bBreakerTripped  The state of the circuit breaker, see \ref CAssertConfig::IsCircuitBreakerTripped.
+     *
+     * @return     The metrics in the Prometheus text exposition format.
+     */
+    [[nodiscard]] static std::string Render(bool bBreakerTripped);
+
+    /**
+     * @internal
+     * @brief      Writes the metrics file.
+     *
+     * @return     True if the file is written, False otherwise.
+     */
+    bool WriteFile() const noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The loop of the background thread.
+     */
+    void workerLoop(std::stop_token stopToken);
+
+private:
+
+    /**
+     * @internal
+     * @brief      The path of the file.
+     */
+    const std::string m_strPath;
+
+    /**
+     * @internal
+     * @brief      The period of the refresh.
+     */
+    const std::chrono::milliseconds m_period;
+
+    /**
+     * @internal
+     * @brief      The config which owns the exporter.
+     */
+    const CAssertConfig& m_config;
+
+    /**
+     * @internal
+     * @brief      Wakes the background thread on stop.
+     */
+    std::condition_variable_any m_cvWorker;
+
+    /**
+     * @internal
+     * @brief      The background thread, declared last to be stopped before the other members are destroyed.
+     */
+    std::jthread m_worker;
+
+}; // class CMetricsExporter
+
+} // namespace dbgh::impl
@@ -0,0 +1,106 @@
+/**
+ * @file        CReportBackoff.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CReportBackoff class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <algorithm>
+
+#include "CAssertConfig.h"
+#include "CReportBackoff.h"
+#include "CReportFormatter.h"
+
+namespace dbgh::impl
+{
+
+CReportBackoff::CReportBackoff(const std::uint32_t levels, const std::chrono::milliseconds period)
+        : m_uLevels { levels },
+        m_period { period }
+{
+    // The failures counted before the backoff are not summarized.
+    CAssertSiteRegistry::ForEach([this](const SAssertSite& site)
+    {
+        m_mapCounts[&site] = countsOf(site);
+    });
+    m_worker = std::jthread { [this](std::stop_token stopToken) { workerLoop(std::move(stopToken)); } };
+}
+
+CReportBackoff::~CReportBackoff()
+{
+    m_worker.request_stop();
+    m_worker.join();
+}
+
+void CReportBackoff::Summarize()
+{
+    std::lock_guard lock { m_mtxSummarize };
+    auto& config = CAssertConfig::Get();
+    CAssertSiteRegistry::ForEach([this, &config](const SAssertSite& site)
+    {
+        if (0 == (m_uLevels & LevelMask(site.level)))
+        {
+            return;
+        }
+        const auto counts = countsOf(site);
+        auto& lastCounts = m_mapCounts[&site];
+        const auto uPeriodFailures = counts.failures - lastCounts.failures;
+        const auto uPeriodSuppressed = counts.suppressed - lastCounts.suppressed;
+        const auto uPeriodNotReported = uPeriodSuppressed + (counts.dropped - lastCounts.dropped);
+        lastCounts = counts;
+        // The tripped circuit breaker stops the summaries too, it reports the storm itself.
+        if (0 == uPeriodSuppressed || config.IsCircuitBreakerTripped())
+        {
+            return;
+        }
+        const auto uReported = uPeriodFailures - std::min(uPeriodFailures, uPeriodNotReported);
+        try
+        {
+            const auto strMessage = FormatSummary(uPeriodFailures, uReported, m_period);
+            config.GetExecutor()->HandleWarning(CReportFormatter::Format(
+                    config.GetReportFormat(), CCaptureClock::Capture(), site.level, strMessage, site.expression,
+                    site.file, site.line, site.function));
+        }
+        catch (...)
+        {
+            // The summary is best effort, the executor which throws loses it.
+        }
+    });
+}
+
+std::string CReportBackoff::FormatSummary(
+        const std::uint64_t failures, const std::uint64_t reported, const std::chrono::milliseconds period)
+{
+    const auto strPeriod = (0 == period.count() % 1000)
+            ? std::to_string(period.count() / 1000) + "s"
+            : std::to_string(period.count()) + "ms";
+    return "The site failed " + std::to_string(failures) + " times in the last " + strPeriod + ", "
+           + std::to_string(reported) + " of them reported.";
+}
+
+CReportBackoff::SSiteCounts CReportBackoff::countsOf(const SAssertSite& site) noexcept
+{
+    // The failure is counted before it is suppressed or dropped, the failures are loaded last to include them.
+    SSiteCounts counts;
+    counts.suppressed = site.suppressed.load(std::memory_order_relaxed);
+    counts.dropped = site.dropped.load(std::memory_order_relaxed);
+    counts.failures = site.failures.load(std::memory_order_relaxed);
+    return counts;
+}
+
+void CReportBackoff::workerLoop(std::stop_token stopToken)
+{
+    std::mutex mtxWait;
+    std::unique_lock lock { mtxWait };
+    while (! m_cvWorker.wait_for(lock, stopToken, m_period, [] { return false; }))
+    {
+        if (stopToken.stop_requested())
+        {
+            return;
+        }
+        Summarize();
+    }
+}
+
+} // namespace dbgh::impl
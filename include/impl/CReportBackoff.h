@@ -0,0 +1,149 @@
+/**
+ * @file        CReportBackoff.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CReportBackoff class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "CAssertSite.h"
+
+namespace dbgh::impl
+{
+
+/**
+ * @internal
+ * @class      CReportBackoff
+ * @brief      Writes the periodic summaries of the failures suppressed by the exponential backoff of the reports.
+ *
+ * @details    With the backoff the site reports only its 1st, 2nd, 4th, 8th... failure (see
+ *              \ref CAssertConfig::ShouldReport), the other failures are only counted. Every period the summary
+ *              thread compares the counters of the sites with the counters of the last period and writes one
+ *              summary report for every site with suppressed failures: "The site failed 1200000 times in the last
+ *              10s, 2 of them reported.", where the reported failures are neither suppressed nor dropped by the
+ *              filter. The summary is formatted as the report of the site and passed to
+ *              \ref CHandlerExecutor::HandleWarning of the current executor. No summaries are written while the
+ *              circuit breaker is tripped, see \ref CCircuitBreaker.
+ */
+class CReportBackoff
+{
+public:
+
+    /**
+     * @internal
+     * @brief      Starts the periodic summaries.
+     *
+     * @param[in]  levels  The mask of the levels with the backoff, see \ref LevelMask.
+     * @param[in]  period  The period of the summaries.
+     */
+    CReportBackoff(std::uint32_t levels, std::chrono::milliseconds period);
+
+    /**
+     * @internal
+     * @brief      Stops the periodic summaries.
+     */
+    ~CReportBackoff();
+
+    CReportBackoff(CReportBackoff&&) = delete;
+
+    CReportBackoff(const CReportBackoff&) = delete;
+
+    CReportBackoff& operator=(CReportBackoff&&) = delete;
+
+    CReportBackoff& operator=(const CReportBackoff&) = delete;
+
+    /**
+     * @internal
+     * @brief      Writes the summaries of the failures since the last summary.
+     */
+    void Summarize();
+
+    /**
+     * @internal
+     * @brief      Formats the summary message of the site.
+     *
+     * @param[in]  failures  The count of the failures in the period.
+     * @param[in]  reported  The count of the reported failures in the period.
+     * @param[in]  period    The period.
+     *
+     * @return     The message.
+     */
+    [[nodiscard]] static std::string FormatSummary(
+            std::uint64_t failures, std::uint64_t reported, std::chrono::milliseconds period);
+
+private:
+
+    /**
+     * @internal
+     * @brief      The counters of the site.
+     */
+    struct SSiteCounts
+    {
+        std::uint64_t failures = 0;
+        std::uint64_t suppressed = 0;
+        std::uint64_t dropped = 0;
+    };
+
+    /**
+     * @internal
+     * @brief      Loads the counters of the site.
+     */
+    [[nodiscard]] static SSiteCounts countsOf(const SAssertSite& site) noexcept;
+
+    /**
+     * @internal
+     * @brief      The loop of the background thread.
+     */
+    void workerLoop(std::stop_token stopToken);
+
+private:
+
+    /**
+     * @internal
+     * @brief      The mask of the levels with the backoff.
+     */
+    const std::uint32_t m_uLevels;
+
+    /**
+     * @internal
+     * @brief      The period of the summaries.
+     */
+    const std::chrono::milliseconds m_period;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the counters of the sites.
+     */
+    std::mutex m_mtxSummarize;
+
+    /**
+     * @internal
+     * @brief      The counters of the sites at the last summary.
+     */
+    std::unordered_map<const SAssertSite*, SSiteCounts> m_mapCounts;
+
+    /**
+     * @internal
+     * @brief      Wakes the background thread on stop.
+     */
+    std::condition_variable_any m_cvWorker;
+
+    /**
+     * @internal
+     * @brief      The background thread, declared last to be stopped before the other members are destroyed.
+     */
+    std::jthread m_worker;
+
+}; // class CReportBackoff
+
+} // namespace dbgh::impl
@@ -0,0 +1,334 @@
+/**
+ * @file        CReportFormatter.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CReportFormatter class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <charconv>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "CReportFormatter.h"
+#include "CScopedContext.h"
+
+using namespace std::string_view_literals;
+
+namespace dbgh::impl
+{
+
+/**
+ * @internal
+ * @brief      The reusable report buffer of a thread.
+ */
+struct SReportBuffer
+{
+    std::string text;
+    bool bInUse = false;
+};
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The initial capacity of the per-thread report buffer.
+ */
+constexpr std::size_t s_uInitialCapacity = 1024;
+
+/**
+ * @internal
+ * @brief      Takes the first free report buffer of the current thread, the buffer is added if all are used.
+ */
+SReportBuffer& AcquireThreadBuffer()
+{
+    thread_local std::vector<std::unique_ptr<SReportBuffer>> t_vecBuffers;
+    for (const auto& pBuffer : t_vecBuffers)
+    {
+        if (! pBuffer->bInUse)
+        {
+            pBuffer->bInUse = true;
+            return *pBuffer;
+        }
+    }
+    auto& pBuffer = t_vecBuffers.emplace_back(std::make_unique<SReportBuffer>());
+    pBuffer->text.reserve(s_uInitialCapacity);
+    pBuffer->bInUse = true;
+    return *pBuffer;
+}
+
+/**
+ * @internal
+ * @brief      Appends the integer to the buffer without temporary strings.
+ */
+template<class TInteger>
+void AppendInteger(std::string& buffer, const TInteger value)
+{
+    char arrDigits[24] {};
+    const auto [pEnd, error] = std::to_chars(std::begin(arrDigits), std::end(arrDigits), value);
+    (void) error;
+    buffer.append(arrDigits, pEnd);
+}
+
+/**
+ * @internal
+ * @brief      Appends the integer padded with zeros to the given width.
+ */
+template<class TInteger>
+void AppendPadded(std::string& buffer, const TInteger value, const std::size_t width)
+{
+    char arrDigits[24] {};
+    const auto [pEnd, error] = std::to_chars(std::begin(arrDigits), std::end(arrDigits), value);
+    (void) error;
+    const auto uLength = static_cast<std::size_t>(pEnd - std::begin(arrDigits));
+    if (uLength < width)
+    {
+        buffer.append(width - uLength, '0');
+    }
+    buffer.append(arrDigits, pEnd);
+}
+
+/**
+ * @internal
+ * @brief      Appends the time in the ISO 8601 UTC form with nanoseconds, for example 2026-10-16T09:30:00.000000001Z.
+ */
+void AppendIsoTime(std::string& buffer, const std::chrono::system_clock::time_point time)
+{
+    using namespace std::chrono;
+
+    const auto nanosecondsSinceEpoch = duration_cast<nanoseconds>(time.time_since_epoch());
+    const auto days = floor<std::chrono::days>(nanosecondsSinceEpoch);
+    const year_month_day date { sys_days { days } };
+    const hh_mm_ss timeOfDay { nanosecondsSinceEpoch - days };
+
+    AppendPadded(buffer, static_cast<int>(date.year()), 4);
+    buffer += '-';
+    AppendPadded(buffer, static_cast<unsigned>(date.month()), 2);
+    buffer += '-';
+    AppendPadded(buffer, static_cast<unsigned>(date.day()), 2);
+    buffer += 'T';
+    AppendPadded(buffer, timeOfDay.hours().count(), 2);
+    buffer += ':';
+    AppendPadded(buffer, timeOfDay.minutes().count(), 2);
+    buffer += ':';
+    AppendPadded(buffer, timeOfDay.seconds().count(), 2);
+    buffer += '.';
+    AppendPadded(buffer, timeOfDay.subseconds().count(), 9);
+    buffer += 'Z';
+}
+
+/**
+ * @internal
+ * @brief      Calls the function for each context frame of the current thread, from the outermost to the innermost.
+ */
+template<class TFunction>
+void ForEachContextFrame(const SContextFrame* pFrame, TFunction&& function)
+{
+    if (nullptr == pFrame)
+    {
+        return;
+    }
+    ForEachContextFrame(pFrame->parent, function);
+    function(*pFrame);
+}
+}  // unnamed namespace
+
+CFormattedReport::CFormattedReport(SReportBuffer* pBuffer) noexcept
+        : m_pBuffer { pBuffer }
+{
+}
+
+CFormattedReport::CFormattedReport(CFormattedReport&& other) noexcept
+        : m_pBuffer { std::exchange(other.m_pBuffer, nullptr) }
+{
+}
+
+CFormattedReport::~CFormattedReport()
+{
+    if (nullptr != m_pBuffer)
+    {
+        m_pBuffer->bInUse = false;
+    }
+}
+
+CFormattedReport::operator std::string_view() const noexcept
+{
+    return (nullptr != m_pBuffer) ? std::string_view { m_pBuffer->text } : std::string_view { };
+}
+
+CFormattedReport CReportFormatter::Format(
+        const EReportFormat format, const SCaptureStamp& stamp, const EAssertLevel level, std::string_view message, const char* expression,
+        const char* file, const TLine line, const char* function)
+{
+    auto& reportBuffer = AcquireThreadBuffer();
+    CFormattedReport report { &reportBuffer };
+    auto& buffer = reportBuffer.text;
+    buffer.clear();
+    switch (format)
+    {
+        case EReportFormat::JsonLines:
+            formatJson(buffer, stamp, level, message, expression, file, line, function);
+            break;
+        case EReportFormat::Text:
+            [[fallthrough]];
+        default:
+            formatText(buffer, stamp, level, message, expression, file, line, function);
+            break;
+    }
+    return report;
+}
+
+void CReportFormatter::AppendJsonString(std::string& buffer, std::string_view value)
+{
+    constexpr auto hexDigits = "0123456789abcdef"sv;
+
+    buffer += '"';
+    auto chunkBegin = value.begin();
+    for (auto iter = value.begin(); iter != value.end(); ++iter)
+    {
+        const auto ch = static_cast<unsigned char>(*iter);
+        if (ch >= 0x20 && '"' != ch && '\\' != ch)
+        {
+            continue;
+        }
+
+        buffer.append(chunkBegin, iter);
+        chunkBegin = iter + 1;
+        switch (ch)
+        {
+            case '"':
+                buffer += "\\\""sv;
+                break;
+            case '\\':
+                buffer += "\\\\"sv;
+                break;
+            case '\n':
+                buffer += "\\n"sv;
+                break;
+            case '\r':
+                buffer += "\\r"sv;
+                break;
+            case '\t':
+                buffer += "\\t"sv;
+                break;
+            default:
+                buffer += "\\u00"sv;
+                buffer += hexDigits[ch >> 4u];
+                buffer += hexDigits[ch & 0x0Fu];
+                break;
+        }
+    }
+    buffer.append(chunkBegin, value.end());
+    buffer += '"';
+}
+
+const char* CReportFormatter::ToString(const EAssertLevel level) noexcept
+{
+    switch (level)
+    {
+        case EAssertLevel::Warning:
+            return "WARNING";
+        case EAssertLevel::Error:
+            return "ERROR";
+        case EAssertLevel::Debug:
+            return "DEBUG";
+        case EAssertLevel::Fatal:
+            return "FATAL";
+        case EAssertLevel::END_ENUM_:
+            [[fallthrough]];
+        default:
+            return "[Unknown asset level]";
+    }
+}
+
+void CReportFormatter::formatText(
+        std::string& buffer, const SCaptureStamp& stamp, const EAssertLevel level, std::string_view message, const char* expression,
+        const char* file, const TLine line, const char* function)
+{
+    buffer += ToString(level);
+    buffer += " ASSERT:\n"sv;
+    buffer += "  [uncaught exc]: "sv;
+    AppendInteger(buffer, std::uncaught_exceptions());
+    buffer += "\n  [time]:         "sv;
+    AppendIsoTime(buffer, CCaptureClock::ToSystemTime(stamp.ticks));
+    buffer += "\n  [thread]:       "sv;
+    AppendInteger(buffer, stamp.threadId);
+    buffer += "\n  [cpu]:          "sv;
+    AppendInteger(buffer, stamp.cpu);
+    buffer += "\n  [file]:         "sv;
+    buffer += file;
+    buffer += "\n  [line]:         "sv;
+    AppendInteger(buffer, line);
+    buffer += "\n  [function]:     "sv;
+    buffer += function;
+    buffer += "\n  [expression]:   "sv;
+    buffer += expression;
+    if (const auto* pContext = CScopedContext::Top(); nullptr != pContext)
+    {
+        buffer += "\n  [context]:     "sv;
+        ForEachContextFrame(pContext, [&buffer](const SContextFrame& frame)
+        {
+            buffer += ' ';
+            buffer += frame.name;
+            buffer += '=';
+            frame.format(buffer, frame.value);
+        });
+    }
+    buffer += "\n  [what]:         "sv;
+    buffer += message;
+    buffer += "\n\n"sv;
+}
+
+void CReportFormatter::formatJson(
+        std::string& buffer, const SCaptureStamp& stamp, const EAssertLevel level, std::string_view message, const char* expression,
+        const char* file, const TLine line, const char* function)
+{
+    const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            CCaptureClock::ToSystemTime(stamp.ticks).time_since_epoch()).count();
+
+    buffer += R"({"level":")"sv;
+    buffer += ToString(level);
+    buffer += R"(","timestamp":)"sv;
+    AppendInteger(buffer, timestamp);
+    buffer += R"(,"ticks":)"sv;
+    AppendInteger(buffer, stamp.ticks);
+    buffer += R"(,"thread":)"sv;
+    AppendInteger(buffer, stamp.threadId);
+    buffer += R"(,"cpu":)"sv;
+    AppendInteger(buffer, stamp.cpu);
+    buffer += R"(,"file":)"sv;
+    AppendJsonString(buffer, file);
+    buffer += R"(,"line":)"sv;
+    AppendInteger(buffer, line);
+    buffer += R"(,"function":)"sv;
+    AppendJsonString(buffer, function);
+    buffer += R"(,"expression":)"sv;
+    AppendJsonString(buffer, expression);
+    buffer += R"(,"uncaught":)"sv;
+    AppendInteger(buffer, std::uncaught_exceptions());
+    if (const auto* pContext = CScopedContext::Top(); nullptr != pContext)
+    {
+        thread_local std::string t_strValue;
+        char chSeparator = '{';
+        buffer += R"(,"context":)"sv;
+        ForEachContextFrame(pContext, [&buffer, &chSeparator](const SContextFrame& frame)
+        {
+            buffer += chSeparator;
+            chSeparator = ',';
+            AppendJsonString(buffer, frame.name);
+            buffer += ':';
+            t_strValue.clear();
+            frame.format(t_strValue, frame.value);
+            AppendJsonString(buffer, t_strValue);
+        });
+        buffer += '}';
+    }
+    buffer += R"(,"message":)"sv;
+    AppendJsonString(buffer, message);
+    buffer += '}';
+}
+
+} // namespace dbgh::impl
@@ -0,0 +1,184 @@
+/**
+ * @file        CReportFormatter.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CReportFormatter class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "CAssertException.h"
+#include "CCaptureClock.h"
+#include "EAssertLevel.h"
+
+namespace dbgh
+{
+
+/**
+ * @enum       EReportFormat
+ * @brief      The output formats of the assertion reports.
+ */
+enum class EReportFormat
+{
+    /**
+     * @brief   The multi-line human-oriented text block.
+     */
+    Text,
+
+    /**
+     * @brief   One JSON object per report in a single line (JSON Lines).
+     */
+    JsonLines
+};
+
+} // namespace dbgh
+
+namespace dbgh::impl
+{
+
+/**
+ * @internal
+ * @struct     SReportBuffer
+ * @brief      The reusable report buffer of a thread, defined in CReportFormatter.cpp.
+ */
+struct SReportBuffer;
+
+/**
+ * @internal
+ * @class      CFormattedReport
+ * @brief      The formatted report, holds the report buffer of the thread until it is destroyed.
+ *
+ * @details    The report formatted while another one is alive in the same thread (for example, by the executor
+ *              which asserts or reports on its own) is written to the next buffer of the thread, so the reports
+ *              never overwrite each other.
+ */
+class CFormattedReport
+{
+public:
+
+    CFormattedReport(CFormattedReport&& other) noexcept;
+
+    /**
+     * @internal
+     * @brief      Releases the buffer for the next report of the thread.
+     */
+    ~CFormattedReport();
+
+    CFormattedReport(const CFormattedReport&) = delete;
+
+    CFormattedReport& operator=(CFormattedReport&&) = delete;
+
+    CFormattedReport& operator=(const CFormattedReport&) = delete;
+
+    /**
+     * @internal
+     * @brief      Gets the text of the report, valid while the report is alive.
+     */
+    operator std::string_view() const noexcept;
+
+private:
+
+    friend class CReportFormatter;
+
+    /**
+     * @internal
+     * @brief      Takes the buffer which is marked as used.
+     */
+    explicit CFormattedReport(SReportBuffer* pBuffer) noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The buffer, null if the report is moved.
+     */
+    SReportBuffer* m_pBuffer;
+
+}; // class CFormattedReport
+
+/**
+ * @internal
+ * @class      CReportFormatter
+ * @brief      Formats the assertion reports into a reusable per-thread buffer.
+ *
+ * @details    The report is written directly into a buffer of the calling thread, the buffers keep their capacity
+ *              between reports, so formatting does not allocate after warm-up. The buffer is held by the returned
+ *              \ref CFormattedReport, the nested reports of the thread use the next buffer.
+ *             The time, thread and CPU come from the \ref SCaptureStamp taken at the failure, the raw ticks are
+ *              converted to the wall-clock time here, only for the reports which are rendered.
+ *             The JSON Lines record has the fields: level, timestamp (nanoseconds since the Unix epoch), ticks (the
+ *              raw clock value, for ordering), thread (the kernel thread id), cpu, file, line, function, expression,
+ *              uncaught (the count of uncaught exceptions), context (the object of the \ref CScopedContext values,
+ *              only if any) and message.
+ */
+class CReportFormatter
+{
+public:
+
+    CReportFormatter() = delete;
+
+    /**
+     * @internal
+     * @brief      Formats the report.
+     *
+     * @note       The report holds the buffer of the thread until it is destroyed, keep it for the time of use only.
+     *
+     * @param[in]  format      The output format.
+     * @param[in]  stamp       The time, thread and CPU captured at the failure.
+     * @param[in]  level       The assert level.
+     * @param[in]  message     The error description.
+     * @param[in]  expression  Expression to be evaluated, as a string.
+     * @param[in]  file        The filename that contains the code is a failed assertion.
+     * @param[in]  line        The line number in the file that contains the code that is failed assertion.
+     * @param[in]  function    The function that contains the code is a failed assertion.
+     *
+     * @return     The formatted report.
+     */
+    static CFormattedReport Format(
+            EReportFormat format, const SCaptureStamp& stamp, EAssertLevel level, std::string_view message, const char* expression,
+            const char* file, TLine line, const char* function);
+
+    /**
+     * @internal
+     * @brief      Appends the string to the buffer as a JSON string literal, with the quotes.
+     *
+     * @param[out] buffer  The buffer.
+     * @param[in]  value   The string.
+     */
+    static void AppendJsonString(std::string& buffer, std::string_view value);
+
+    /**
+     * @internal
+     * @brief      Gets the name of the level.
+     *
+     * @param[in]  level  The level.
+     *
+     * @return     The name of the level, for example "WARNING".
+     */
+    [[nodiscard]] static const char* ToString(EAssertLevel level) noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      Writes the report in the \ref EReportFormat::Text format.
+     */
+    static void formatText(
+            std::string& buffer, const SCaptureStamp& stamp, EAssertLevel level, std::string_view message, const char* expression,
+            const char* file, TLine line, const char* function);
+
+    /**
+     * @internal
+     * @brief      Writes the report in the \ref EReportFormat::JsonLines format.
+     */
+    static void formatJson(
+            std::string& buffer, const SCaptureStamp& stamp, EAssertLevel level, std::string_view message, const char* expression,
+            const char* file, TLine line, const char* function);
+
+}; // class CReportFormatter
+
+} // namespace dbgh::impl
@@ -0,0 +1,189 @@
+/**
+ * @file        CRequestSampling.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CRequestSampling and CScopedRequestSampling classes.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "EAssertLevel.h"
+
+namespace dbgh
+{
+
+/**
+ * @class      CRequestSampling
+ * @brief      The per-thread mask of the enabled levels, layered on top of \ref CAssertConfig::IsActiveAssert.
+ *
+ * @details    The assertion is active only if its level is enabled both in the configuration and in the mask of the
+ *              current thread. By default the mask enables all levels; it is narrowed for the duration of a request
+ *              by \ref CScopedRequestSampling.
+ *             The decision for the request is a function of the request key only (64-bit FNV-1a), so every host and
+ *              every thread which handles the same request sees the same decision.
+ */
+class CRequestSampling
+{
+public:
+
+    CRequestSampling() = delete;
+
+    /**
+     * @brief      Gets the mask of the levels enabled for the current thread.
+     *
+     * @return     The level mask, see \ref LevelMask.
+     */
+    [[nodiscard]] static std::uint32_t ThreadMask() noexcept
+    {
+        return t_uThreadMask;
+    }
+
+    /**
+     * @brief      Replaces the mask of the levels enabled for the current thread.
+     *
+     * @param[in]  mask  The level mask, see \ref LevelMask.
+     */
+    static void SetThreadMask(const std::uint32_t mask) noexcept
+    {
+        t_uThreadMask = mask;
+    }
+
+    /**
+     * @brief      Determines whether the request falls into the sampled fraction.
+     *
+     * @param[in]  requestKey  The key of the request, for example the request id.
+     * @param[in]  rate        The sampled fraction of the requests, from 0.0 to 1.0.
+     *
+     * @return     True if the request is sampled, False otherwise.
+     */
+    [[nodiscard]] static constexpr bool IsSampled(const std::string_view requestKey, const double rate) noexcept
+    {
+        if (! (rate > 0.0))
+        {
+            return false;
+        }
+        if (rate >= 1.0)
+        {
+            return true;
+        }
+        // The upper 32 bits of the hash are compared with the rate scaled to 2^32.
+        const auto uBucket = static_cast<double>(Hash(requestKey) >> 32u);
+        return uBucket < rate * 4294967296.0;
+    }
+
+    /**
+     * @brief      Hashes the request key, the result is the same on all platforms.
+     *
+     * @param[in]  requestKey  The key of the request.
+     *
+     * @return     The 64-bit FNV-1a hash with the final avalanche mixing.
+     */
+    [[nodiscard]] static constexpr std::uint64_t Hash(const std::string_view requestKey) noexcept
+    {
+        std::uint64_t uHash = 0xcbf29ce484222325u;
+        for (const auto ch : requestKey)
+        {
+            uHash ^= static_cast<unsigned char>(ch);
+            uHash *= 0x100000001b3u;
+        }
+        uHash ^= uHash >> 33u;
+        uHash *= 0xff51afd7ed558ccdu;
+        uHash ^= uHash >> 33u;
+        return uHash;
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      The mask of the levels enabled for the current thread.
+     */
+    static inline thread_local std::uint32_t t_uThreadMask = AllLevelsMask;
+
+}; // class CRequestSampling
+
+
+/**
+ * @class      CScopedRequestSampling
+ * @brief      Enables the given levels only for the sampled fraction of the requests, until the end of the scope.
+ *
+ * @details    The levels which are not sampled for the request are removed from the mask of the current thread, the
+ *              other levels keep their state. The previous mask is restored by the destructor, so the scopes can be
+ *              nested.
+ *
+ * @example     void HandleRequest(const SRequest& request)
+ *              {
+ *                  // The expensive Debug and Warning asserts run for 1% of the requests.
+ *                  dbgh::CScopedRequestSampling sampling { request.id, 0.01,
+ *                          dbgh::LevelMask(dbgh::EAssertLevel::Debug) | dbgh::LevelMask(dbgh::EAssertLevel::Warning) };
+ *                  ...
+ *              }
+ */
+class CScopedRequestSampling
+{
+public:
+
+    /**
+     * @brief      Narrows the level mask of the current thread according to the request key.
+     *
+     * @param[in]  requestKey  The key of the request.
+     * @param[in]  rate        The sampled fraction of the requests, from 0.0 to 1.0.
+     * @param[in]  levels      The mask of the sampled levels, see \ref LevelMask.
+     */
+    CScopedRequestSampling(const std::string_view requestKey, const double rate, const std::uint32_t levels) noexcept
+            : m_uPreviousMask { CRequestSampling::ThreadMask() },
+            m_bSampled { CRequestSampling::IsSampled(requestKey, rate) }
+    {
+        if (! m_bSampled)
+        {
+            CRequestSampling::SetThreadMask(m_uPreviousMask & ~levels);
+        }
+    }
+
+    /**
+     * @brief      Restores the previous level mask of the current thread.
+     */
+    ~CScopedRequestSampling()
+    {
+        CRequestSampling::SetThreadMask(m_uPreviousMask);
+    }
+
+    CScopedRequestSampling(CScopedRequestSampling&&) = delete;
+
+    CScopedRequestSampling(const CScopedRequestSampling&) = delete;
+
+    CScopedRequestSampling& operator=(CScopedRequestSampling&&) = delete;
+
+    CScopedRequestSampling& operator=(const CScopedRequestSampling&) = delete;
+
+    /**
+     * @brief      Determines whether the request is sampled.
+     *
+     * @return     True if the sampled levels are kept enabled, False otherwise.
+     */
+    [[nodiscard]] bool IsSampled() const noexcept
+    {
+        return m_bSampled;
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      The mask of the thread before the scope.
+     */
+    const std::uint32_t m_uPreviousMask;
+
+    /**
+     * @internal
+     * @brief      True if the request is sampled.
+     */
+    const bool m_bSampled;
+
+}; // class CScopedRequestSampling
+
+} // namespace dbgh
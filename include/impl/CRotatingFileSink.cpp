@@ -0,0 +1,333 @@
+/**
+ * @file        CRotatingFileSink.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CRotatingFileSink class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "CRotatingFileSink.h"
+
+namespace dbgh
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The suffix of the segment which is not finalized yet.
+ */
+constexpr std::string_view s_strPartSuffix = ".part";
+
+/**
+ * @internal
+ * @brief      The retry period of the failed segment preparation.
+ */
+constexpr std::chrono::seconds s_retryPeriod { 1 };
+
+/**
+ * @internal
+ * @brief      Gets the path of the finalized segment.
+ */
+std::string SegmentPath(const std::string& basePath, const std::uint64_t sequence)
+{
+    return basePath + '.' + std::to_string(sequence);
+}
+
+/**
+ * @internal
+ * @brief      Finds the biggest sequence number of the segments on the disk.
+ */
+std::uint64_t LastSequence(const std::string& basePath)
+{
+    const std::filesystem::path base { basePath };
+    const auto directory = base.has_parent_path() ? base.parent_path() : std::filesystem::path { "." };
+    const auto prefix = base.filename().string() + '.';
+
+    std::uint64_t uLast = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator { directory, error })
+    {
+        auto name = entry.path().filename().string();
+        if (0 != name.rfind(prefix, 0))
+        {
+            continue;
+        }
+        std::uint64_t uSequence = 0;
+        const auto* pBegin = name.data() + prefix.size();
+        const auto* pEnd = name.data() + name.size();
+        const auto [pParsed, parseError] = std::from_chars(pBegin, pEnd, uSequence);
+        if (std::errc { } == parseError && pParsed != pBegin)
+        {
+            uLast = std::max(uLast, uSequence);
+        }
+    }
+    return uLast;
+}
+}  // unnamed namespace
+
+
+struct CRotatingFileSink::SSegment
+{
+    ~SSegment()
+    {
+        if (nullptr != pData)
+        {
+            ::munmap(pData, uSize);
+        }
+        if (iFd >= 0)
+        {
+            ::close(iFd);
+        }
+    }
+
+    int iFd = -1;
+    char* pData = nullptr;
+    std::size_t uSize = 0;
+    std::size_t uUsed = 0;
+    std::uint64_t uSequence = 0;
+    std::chrono::steady_clock::time_point opened { };
+};
+
+
+CRotatingFileSink::CRotatingFileSink(
+        std::string path,
+        const std::size_t segmentSize,
+        const std::chrono::seconds maxAge,
+        const std::size_t maxSegments)
+        : m_strPath { std::move(path) },
+        m_uSegmentSize { [segmentSize]
+        {
+            const auto uPage = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            return std::max<std::size_t>((segmentSize + uPage - 1) / uPage, 1) * uPage;
+        }() },
+        m_maxAge { maxAge },
+        m_uMaxSegments { maxSegments },
+        m_uNextSequence { LastSequence(m_strPath) + 1 },
+        m_bPrepareFailed { false }
+{
+    m_pActive = prepareSegment();
+    if (nullptr == m_pActive)
+    {
+        throw std::system_error { errno, std::generic_category(), "Cannot create the assert log segment." };
+    }
+    m_pActive->opened = std::chrono::steady_clock::now();
+    m_worker = std::jthread { [this](std::stop_token stopToken) { workerLoop(std::move(stopToken)); } };
+}
+
+CRotatingFileSink::~CRotatingFileSink()
+{
+    m_worker.request_stop();
+    m_worker.join();
+
+    for (auto& segment : m_vecRetired)
+    {
+        finalizeSegment(std::move(segment));
+    }
+    finalizeSegment(std::move(m_pActive));
+    if (nullptr != m_pPrepared)
+    {
+        const auto uSequence = m_pPrepared->uSequence;
+        m_pPrepared.reset();
+        ::unlink((SegmentPath(m_strPath, uSequence) + std::string { s_strPartSuffix }).c_str());
+    }
+}
+
+void CRotatingFileSink::Write([[maybe_unused]] const EAssertLevel level, std::string_view report)
+{
+    std::lock_guard lock { m_mtxWrite };
+
+    const auto append = [this](std::string_view data)
+    {
+        while (! data.empty())
+        {
+            if (nullptr == m_pActive || m_pActive->uUsed == m_pActive->uSize)
+            {
+                if (! rotateLocked())
+                {
+                    return;
+                }
+            }
+            const auto uChunk = std::min(data.size(), m_pActive->uSize - m_pActive->uUsed);
+            std::memcpy(m_pActive->pData + m_pActive->uUsed, data.data(), uChunk);
+            m_pActive->uUsed += uChunk;
+            data.remove_prefix(uChunk);
+        }
+    };
+
+    // The report is not split between the segments if it fits into an empty one.
+    if (nullptr != m_pActive && m_pActive->uUsed + report.size() + 1 > m_pActive->uSize
+        && report.size() + 1 <= m_uSegmentSize)
+    {
+        if (! rotateLocked())
+        {
+            return;
+        }
+    }
+    append(report);
+    append("\n");
+}
+
+void CRotatingFileSink::Flush()
+{
+    std::lock_guard lock { m_mtxWrite };
+    if (nullptr != m_pActive)
+    {
+        ::msync(m_pActive->pData, m_pActive->uSize, MS_ASYNC);
+    }
+}
+
+bool CRotatingFileSink::rotateLocked()
+{
+    std::unique_lock rotation { m_mtxRotation };
+    if (nullptr == m_pPrepared)
+    {
+        if (m_bPrepareFailed)
+        {
+            return false;
+        }
+        m_cvWorker.notify_one();
+        m_cvPrepared.wait(rotation, [this] { return nullptr != m_pPrepared || m_bPrepareFailed; });
+        if (nullptr == m_pPrepared)
+        {
+            return false;
+        }
+    }
+
+    if (nullptr != m_pActive)
+    {
+        m_vecRetired.push_back(std::move(m_pActive));
+    }
+    m_pActive = std::move(m_pPrepared);
+    m_pActive->opened = std::chrono::steady_clock::now();
+    m_cvWorker.notify_one();
+    return true;
+}
+
+void CRotatingFileSink::workerLoop(std::stop_token stopToken)
+{
+    std::unique_lock rotation { m_mtxRotation };
+    while (! stopToken.stop_requested())
+    {
+        if (! m_vecRetired.empty())
+        {
+            auto vecRetired = std::move(m_vecRetired);
+            m_vecRetired.clear();
+            rotation.unlock();
+            for (auto& segment : vecRetired)
+            {
+                finalizeSegment(std::move(segment));
+            }
+            rotation.lock();
+            continue;
+        }
+
+        if (nullptr == m_pPrepared)
+        {
+            rotation.unlock();
+            auto segment = prepareSegment();
+            rotation.lock();
+            m_bPrepareFailed = (nullptr == segment);
+            m_pPrepared = std::move(segment);
+            m_cvPrepared.notify_all();
+            if (m_bPrepareFailed)
+            {
+                m_cvWorker.wait_for(rotation, stopToken, s_retryPeriod, [] { return false; });
+            }
+            continue;
+        }
+
+        const auto hasWork = [this] { return ! m_vecRetired.empty() || nullptr == m_pPrepared; };
+        if (0 == m_maxAge.count())
+        {
+            m_cvWorker.wait(rotation, stopToken, hasWork);
+            continue;
+        }
+
+        if (m_cvWorker.wait_for(rotation, stopToken, std::chrono::seconds { 1 }, hasWork))
+        {
+            continue;
+        }
+
+        // The time-based rotation, the lock order is m_mtxWrite then m_mtxRotation. The writer holding
+        // m_mtxWrite may wait for this thread to prepare a segment, so the lock is only tried.
+        rotation.unlock();
+        {
+            std::unique_lock lock { m_mtxWrite, std::try_to_lock };
+            if (lock.owns_lock() && nullptr != m_pActive && 0 != m_pActive->uUsed
+                && std::chrono::steady_clock::now() - m_pActive->opened >= m_maxAge)
+            {
+                rotateLocked();
+            }
+        }
+        rotation.lock();
+    }
+}
+
+auto CRotatingFileSink::prepareSegment() -> std::unique_ptr<SSegment>
+{
+    auto segment = std::make_unique<SSegment>();
+    segment->uSequence = m_uNextSequence;
+    segment->uSize = m_uSegmentSize;
+
+    const auto strPath = SegmentPath(m_strPath, segment->uSequence) + std::string { s_strPartSuffix };
+    segment->iFd = ::open(strPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (segment->iFd < 0)
+    {
+        return nullptr;
+    }
+    if (0 != ::posix_fallocate(segment->iFd, 0, static_cast<off_t>(segment->uSize)))
+    {
+        ::unlink(strPath.c_str());
+        return nullptr;
+    }
+    void* pData = ::mmap(nullptr, segment->uSize, PROT_READ | PROT_WRITE, MAP_SHARED, segment->iFd, 0);
+    if (MAP_FAILED == pData)
+    {
+        ::unlink(strPath.c_str());
+        return nullptr;
+    }
+    segment->pData = static_cast<char*>(pData);
+
+    ++m_uNextSequence;
+    return segment;
+}
+
+void CRotatingFileSink::finalizeSegment(std::unique_ptr<SSegment> segment)
+{
+    if (nullptr == segment)
+    {
+        return;
+    }
+
+    const auto uSequence = segment->uSequence;
+    const auto uUsed = segment->uUsed;
+    const auto iFd = segment->iFd;
+    ::munmap(segment->pData, segment->uSize);
+    segment->pData = nullptr;
+    if (0 != ::ftruncate(iFd, static_cast<off_t>(uUsed)))
+    {
+        // The segment keeps the preallocated size, the tail is filled with zeros.
+    }
+    segment.reset();
+
+    const auto strPath = SegmentPath(m_strPath, uSequence);
+    ::rename((strPath + std::string { s_strPartSuffix }).c_str(), strPath.c_str());
+
+    if (0 != m_uMaxSegments && uSequence > m_uMaxSegments)
+    {
+        ::unlink(SegmentPath(m_strPath, uSequence - m_uMaxSegments).c_str());
+    }
+}
+
+} // namespace dbgh
@@ -0,0 +1,213 @@
+/**
+ * @file        CRotatingFileSink.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CRotatingFileSink class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CAssertSink.h"
+
+namespace dbgh
+{
+
+/**
+ * @class       CRotatingFileSink
+ * @brief       The sink which writes the reports into preallocated, memory-mapped file segments with rotation.
+ *
+ * @details     The reports are copied into the mapping of the active segment, the asserting thread never calls
+ *               write(2) and never waits for the file growth. The segment is rotated when it is full or older than
+ *               the age limit.
+ *             A background thread prepares the next segment in advance (open, posix_fallocate, mmap) and finalizes
+ *              the retired segments (munmap, truncate to the written size, rename, removal of the oldest segments).
+ *              The rotation on the asserting thread is a swap of two mappings; it waits only if the next segment
+ *              is not prepared yet.
+ *             The segments are named "<path>.<sequence>", the active segment is "<path>.<sequence>.part" until it is
+ *              finalized. The sequence continues after the segments found on the disk.
+ *
+ * @note       Available on POSIX platforms.
+ *
+ * @example     auto router = std::make_unique<dbgh::CAssertRouter>();
+ *              router->Subscribe(dbgh::EAssertLevel::Warning,
+ *                                std::make_shared<dbgh::CRotatingFileSink>("/var/log/app/asserts.log"));
+ *              dbgh::CAssertConfig::Get().SetExecutor(std::move(router));
+ */
+class CRotatingFileSink : public CAssertSink
+{
+public:
+
+    /**
+     * @brief      Constructs the sink, creates the first segment and starts the background thread.
+     *
+     * @throw      std::system_error exception if the first segment cannot be created.
+     *
+     * @param[in]  path         The base path of the segments.
+     * @param[in]  segmentSize  The size of one segment, rounded up to the page size.
+     * @param[in]  maxAge       The maximum age of the segment, zero disables the time-based rotation.
+     * @param[in]  maxSegments  The count of the finalized segments kept on the disk, zero keeps all.
+     */
+    explicit CRotatingFileSink(
+            std::string path,
+            std::size_t segmentSize = 16 * 1024 * 1024,
+            std::chrono::seconds maxAge = std::chrono::seconds { 0 },
+            std::size_t maxSegments = 8);
+
+    /**
+     * @brief      Stops the background thread and finalizes all segments.
+     */
+    ~CRotatingFileSink() override;
+
+    /**
+     * @brief      Copies the report into the active segment.
+     *
+     * @param[in]  level   The level of the failed assertion.
+     * @param[in]  report  The formatted report.
+     */
+    void Write(EAssertLevel level, std::string_view report) override;
+
+    /**
+     * @brief      Schedules the write-back of the active segment (msync with MS_ASYNC).
+     */
+    void Flush() override;
+
+private:
+
+    /**
+     * @internal
+     * @brief      One mapped file segment.
+     */
+    struct SSegment;
+
+    /**
+     * @internal
+     * @brief      Replaces the active segment with the prepared one, must be called under m_mtxWrite.
+     *
+     * @return     True if the active segment is replaced, False if the next segment cannot be prepared.
+     */
+    bool rotateLocked();
+
+    /**
+     * @internal
+     * @brief      The loop of the background thread.
+     *
+     * @param[in]  stopToken  The stop token of the thread.
+     */
+    void workerLoop(std::stop_token stopToken);
+
+    /**
+     * @internal
+     * @brief      Creates, preallocates and maps a new segment.
+     *
+     * @return     The segment, or null on failure.
+     */
+    std::unique_ptr<SSegment> prepareSegment();
+
+    /**
+     * @internal
+     * @brief      Unmaps, truncates and renames the segment, removes the oldest segments.
+     *
+     * @param[in]  segment  The segment.
+     */
+    void finalizeSegment(std::unique_ptr<SSegment> segment);
+
+private:
+
+    /**
+     * @internal
+     * @brief      The base path of the segments.
+     */
+    const std::string m_strPath;
+
+    /**
+     * @internal
+     * @brief      The size of one segment.
+     */
+    const std::size_t m_uSegmentSize;
+
+    /**
+     * @internal
+     * @brief      The maximum age of the segment.
+     */
+    const std::chrono::seconds m_maxAge;
+
+    /**
+     * @internal
+     * @brief      The count of the finalized segments kept on the disk.
+     */
+    const std::size_t m_uMaxSegments;
+
+    /**
+     * @internal
+     * @brief      The sequence number of the next prepared segment, used by the background thread.
+     */
+    std::uint64_t m_uNextSequence;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the active segment.
+     */
+    std::mutex m_mtxWrite;
+
+    /**
+     * @internal
+     * @brief      The active segment.
+     */
+    std::unique_ptr<SSegment> m_pActive;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the prepared and the retired segments, locked after m_mtxWrite.
+     */
+    std::mutex m_mtxRotation;
+
+    /**
+     * @internal
+     * @brief      Wakes the background thread.
+     */
+    std::condition_variable_any m_cvWorker;
+
+    /**
+     * @internal
+     * @brief      Wakes the writer waiting for the prepared segment.
+     */
+    std::condition_variable m_cvPrepared;
+
+    /**
+     * @internal
+     * @brief      The prepared segment, null if it is not prepared yet.
+     */
+    std::unique_ptr<SSegment> m_pPrepared;
+
+    /**
+     * @internal
+     * @brief      True if the last preparation failed, the writes are dropped until it succeeds.
+     */
+    bool m_bPrepareFailed;
+
+    /**
+     * @internal
+     * @brief      The segments waiting for the finalization.
+     */
+    std::vector<std::unique_ptr<SSegment>> m_vecRetired;
+
+    /**
+     * @internal
+     * @brief      The background thread, declared last to be stopped before the other members are destroyed.
+     */
+    std::jthread m_worker;
+
+}; // class CRotatingFileSink
+
+} // namespace dbgh
@@ -0,0 +1,183 @@
+/**
+ * @file        CScopedContext.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for SContextFrame struct and CScopedContext class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <charconv>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace dbgh
+{
+
+/**
+ * @struct     SContextFrame
+ * @brief      One entry of the per-thread context stack.
+ */
+struct SContextFrame
+{
+    /**
+     * @brief      The type-erased formatter of the value.
+     */
+    using TFormatter = void(*)(std::string& buffer, const void* value);
+
+    /**
+     * @brief      The name of the value, for example "tenant".
+     */
+    const char* name;
+
+    /**
+     * @brief      The value, owned by the caller.
+     */
+    const void* value;
+
+    /**
+     * @brief      Appends the value to the buffer.
+     */
+    TFormatter format;
+
+    /**
+     * @brief      The enclosing frame, or null for the outermost one.
+     */
+    const SContextFrame* parent;
+};
+
+
+/**
+ * @class      CScopedContext
+ * @brief      Attaches a named value to the reports of all assertions failed in the current scope of the thread.
+ *
+ * @details    The constructor pushes a frame to the per-thread stack and the destructor pops it, the frame keeps
+ *              only pointers to the name, to the value and to its formatter. Nothing is formatted until a report is
+ *              rendered, then the frames are printed from the outermost to the innermost.
+ *             The strings (convertible to std::string_view) are printed as is, the arithmetic values by
+ *              std::to_chars, other types by std::format, so they need a std::formatter specialization.
+ *
+ * @note       The value is referenced, not copied: it must outlive the scope, the temporaries are rejected.
+ *
+ * @example     void HandleRequest(const SRequest& request)
+ *              {
+ *                  dbgh::CScopedContext tenant { "tenant", request.tenant };
+ *                  dbgh::CScopedContext requestId { "request", request.id };
+ *                  ASSERT_ERROR(request.IsValid(), "Invalid request.");
+ *              }
+ */
+class CScopedContext
+{
+public:
+
+    /**
+     * @brief      Pushes the value to the context stack of the current thread.
+     *
+     * @param[in]  name   The name of the value, must have the static storage duration.
+     * @param[in]  value  The value.
+     *
+     * @tparam     TValue The type of the value.
+     */
+    template<class TValue>
+    CScopedContext(const char* name, const TValue& value) noexcept
+            : m_frame { name, std::addressof(value), &formatValue<TValue>, s_pTop }
+    {
+        s_pTop = &m_frame;
+    }
+
+    template<class TValue>
+    CScopedContext(const char* name, const TValue&& value) = delete;
+
+    /**
+     * @brief      Pops the value from the context stack.
+     */
+    ~CScopedContext()
+    {
+        s_pTop = m_frame.parent;
+    }
+
+    CScopedContext(CScopedContext&&) = delete;
+
+    CScopedContext(const CScopedContext&) = delete;
+
+    CScopedContext& operator=(CScopedContext&&) = delete;
+
+    CScopedContext& operator=(const CScopedContext&) = delete;
+
+public:
+
+    /**
+     * @brief      Gets the innermost frame of the current thread.
+     *
+     * @return     The frame, or null if the stack is empty.
+     */
+    [[nodiscard]] static const SContextFrame* Top() noexcept
+    {
+        return s_pTop;
+    }
+
+    /**
+     * @brief      Replaces the context stack of the current thread.
+     *
+     * @details    Used to carry the context over the code which resumes on another thread.
+     *
+     * @param[in]  pTop  The innermost frame, or null.
+     */
+    static void SetTop(const SContextFrame* pTop) noexcept
+    {
+        s_pTop = pTop;
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      Appends the value of the given type to the buffer.
+     */
+    template<class TValue>
+    static void formatValue(std::string& buffer, const void* value)
+    {
+        const auto& typedValue = *static_cast<const TValue*>(value);
+        if constexpr (std::is_convertible_v<const TValue&, std::string_view>)
+        {
+            buffer += std::string_view { typedValue };
+        }
+        else if constexpr (std::is_same_v<TValue, bool>)
+        {
+            buffer += typedValue ? "true" : "false";
+        }
+        else if constexpr (std::is_arithmetic_v<TValue>)
+        {
+            char arrDigits[64] {};
+            const auto [pEnd, error] = std::to_chars(std::begin(arrDigits), std::end(arrDigits), typedValue);
+            (void) error;
+            buffer.append(arrDigits, pEnd);
+        }
+        else
+        {
+            std::format_to(std::back_inserter(buffer), "{}", typedValue);
+        }
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      The frame of this scope.
+     */
+    const SContextFrame m_frame;
+
+    /**
+     * @internal
+     * @brief      The innermost frame of the current thread.
+     */
+    static inline thread_local const SContextFrame* s_pTop = nullptr;
+
+}; // class CScopedContext
+
+} // namespace dbgh
@@ -0,0 +1,669 @@
+/**
+ * @file        CSharedControl.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CSharedControl class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "CAssertProbe.h"
+#include "CConfigParser.h"
+#include "CReportFormatter.h"
+#include "CSharedControl.h"
+#include "CSiteRules.h"
+
+namespace dbgh::impl
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The mark of the initialized block, "DBGH".
+ */
+constexpr std::uint32_t s_uMagic = 0x44424748;
+
+/**
+ * @internal
+ * @brief      The version of the block layout.
+ */
+constexpr std::uint32_t s_uVersion = 3;
+
+/**
+ * @internal
+ * @brief      The time given to the creator of the block to initialize it.
+ */
+constexpr auto s_initTimeout = std::chrono::seconds { 1 };
+
+/**
+ * @internal
+ * @brief      The longest wait of the mirror thread, the missed wake (the writer crashed after the change) is healed.
+ */
+constexpr auto s_mirrorTimeout = std::chrono::milliseconds { 100 };
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "The shared atomics must be address-free.");
+} // unnamed namespace
+
+/**
+ * @internal
+ * @struct     SSharedEntry
+ * @brief      The entry of the site in the shared control block.
+ */
+struct SSharedEntry
+{
+    /**
+     * @internal
+     * @brief      The rule bits of the site, see \ref SAssertSite::RuleOf.
+     */
+    std::atomic<std::uint32_t> rule;
+
+    /**
+     * @internal
+     * @brief      Nonzero if the entry is used.
+     */
+    std::uint32_t used;
+
+    /**
+     * @internal
+     * @brief      The level of the site.
+     */
+    std::uint32_t level;
+
+    /**
+     * @internal
+     * @brief      The line of the site.
+     */
+    TLine line;
+
+    /**
+     * @internal
+     * @brief      The file of the site, null-terminated.
+     */
+    char file[CSharedControl::MaxFileLength + 1];
+};
+
+struct SSharedBlock
+{
+    /**
+     * @internal
+     * @brief      Set to \ref s_uMagic when the block is initialized.
+     */
+    std::atomic<std::uint32_t> magic;
+
+    /**
+     * @internal
+     * @brief      The version of the layout.
+     */
+    std::uint32_t version;
+
+    /**
+     * @internal
+     * @brief      The enable word of the attached processes, see \ref EnableBit.
+     */
+    std::atomic<std::uint64_t> enableWord;
+
+    /**
+     * @internal
+     * @brief      The count of the changes of the enable word, the futex the mirror threads wait on.
+     */
+    std::atomic<std::uint32_t> enableGeneration;
+
+    /**
+     * @internal
+     * @brief      The count of the used entries.
+     */
+    std::uint32_t entryCount;
+
+    /**
+     * @internal
+     * @brief      The count of the sites not bound because the block is full.
+     */
+    std::uint32_t overflows;
+
+    /**
+     * @internal
+     * @brief      The process-shared robust mutex protecting the entries and the rules.
+     */
+    pthread_mutex_t mutex;
+
+    /**
+     * @internal
+     * @brief      The site rules as the configuration text, null-terminated.
+     */
+    char rules[CSharedControl::MaxRulesLength + 1];
+
+    /**
+     * @internal
+     * @brief      The site entries, an open-addressing hash table.
+     */
+    SSharedEntry entries[CSharedControl::Capacity];
+};
+
+namespace
+{
+/**
+ * @internal
+ * @brief      Locks the mutex of the block, recovers the mutex of the crashed holder.
+ */
+class CBlockLock
+{
+public:
+
+    explicit CBlockLock(pthread_mutex_t& mutex) noexcept
+            : m_mutex { mutex }
+    {
+        if (EOWNERDEAD == pthread_mutex_lock(&m_mutex))
+        {
+            pthread_mutex_consistent(&m_mutex);
+        }
+    }
+
+    ~CBlockLock()
+    {
+        pthread_mutex_unlock(&m_mutex);
+    }
+
+    CBlockLock(const CBlockLock&) = delete;
+
+    CBlockLock& operator=(const CBlockLock&) = delete;
+
+private:
+
+    pthread_mutex_t& m_mutex;
+};
+
+/**
+ * @internal
+ * @brief      The block the process is attached to and the mutex protecting the attachment.
+ */
+struct SAttachment
+{
+    std::mutex mtx;
+    CSharedControl* pControl = nullptr;
+    bool bForkHandled = false;
+};
+
+/**
+ * @internal
+ * @brief      Gets the attachment, the block is never detached.
+ */
+SAttachment& Attachment()
+{
+    static SAttachment attachment;
+    return attachment;
+}
+
+/**
+ * @internal
+ * @brief      Gets the futex word of the shared atomic.
+ */
+std::uint32_t* FutexWord(std::atomic<std::uint32_t>& word) noexcept
+{
+    return reinterpret_cast<std::uint32_t*>(&word);
+}
+
+/**
+ * @internal
+ * @brief      Prepends "/" to the name of the segment if it is missing.
+ */
+std::string NormalizeName(std::string name)
+{
+    return (name.starts_with('/')) ? name : "/" + name;
+}
+
+/**
+ * @internal
+ * @brief      Gets the stored form of the file path: the tail of the long path.
+ */
+std::string_view StoredFile(const std::string_view file) noexcept
+{
+    return (file.size() > CSharedControl::MaxFileLength) ? file.substr(file.size() - CSharedControl::MaxFileLength) : file;
+}
+
+/**
+ * @internal
+ * @brief      Computes the FNV-1a hash of the site.
+ */
+std::uint32_t HashSite(const EAssertLevel level, const std::string_view file, const TLine line) noexcept
+{
+    std::uint32_t uHash = 2166136261u;
+    const auto mix = [&uHash](const std::uint32_t uByte) { uHash = (uHash ^ uByte) * 16777619u; };
+    for (const auto symbol : file)
+    {
+        mix(static_cast<unsigned char>(symbol));
+    }
+    for (std::uint32_t uShift = 0; uShift < 32; uShift += 8)
+    {
+        mix((static_cast<std::uint32_t>(line) >> uShift) & 0xffu);
+    }
+    mix(static_cast<std::uint32_t>(level));
+    return uHash;
+}
+
+/**
+ * @internal
+ * @brief      Gets the name of the mode of the rule bits, in the syntax of the configuration.
+ */
+std::string RuleModeName(const std::uint32_t uRule)
+{
+    if (0 == (uRule & SAssertSite::RulePinned))
+    {
+        return "default";
+    }
+    if (0 != (uRule & SAssertSite::RuleDisabled))
+    {
+        return "off";
+    }
+    if (0 != (uRule & SAssertSite::RuleSampled))
+    {
+        const auto uShift = (uRule & SAssertSite::RuleRateMask) >> SAssertSite::RuleRateShift;
+        return (0 == uShift) ? "sampled" : "sampled:" + std::to_string(std::uint64_t { 1 } << uShift);
+    }
+    return "full";
+}
+
+/**
+ * @internal
+ * @brief      Removes the leading and the trailing whitespaces.
+ */
+std::string_view Trim(std::string_view text) noexcept
+{
+    constexpr std::string_view whitespaces { " \t\r\n" };
+    const auto uBegin = text.find_first_not_of(whitespaces);
+    if (std::string_view::npos == uBegin)
+    {
+        return { };
+    }
+    return text.substr(uBegin, text.find_last_not_of(whitespaces) - uBegin + 1);
+}
+} // unnamed namespace
+
+CSharedControl::CSharedControl(std::string name, const bool create, const std::uint64_t initialWord)
+        : m_strName { NormalizeName(std::move(name)) },
+        m_pBlock { nullptr }
+{
+    const auto throwError = [this](const char* pszWhat)
+    {
+        throw std::system_error { errno, std::generic_category(), std::string { pszWhat } + m_strName };
+    };
+
+    auto fd = create ? shm_open(m_strName.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR) : -1;
+    const auto bCreated = -1 != fd;
+    if (! bCreated && (! create || EEXIST == errno))
+    {
+        fd = shm_open(m_strName.c_str(), O_RDWR, 0);
+    }
+    if (-1 == fd)
+    {
+        throwError("Cannot open the shared control block: ");
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + s_initTimeout;
+    if (bCreated)
+    {
+        if (-1 == ftruncate(fd, sizeof(SSharedBlock)))
+        {
+            const auto iError = errno;
+            close(fd);
+            shm_unlink(m_strName.c_str());
+            errno = iError;
+            throwError("Cannot size the shared control block: ");
+        }
+    }
+    else
+    {
+        // The creator may not have sized the segment yet.
+        struct stat status { };
+        while (0 == fstat(fd, &status) && static_cast<std::size_t>(status.st_size) < sizeof(SSharedBlock)
+               && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+        }
+        if (static_cast<std::size_t>(status.st_size) != sizeof(SSharedBlock))
+        {
+            close(fd);
+            throw std::runtime_error { "The segment is not a shared control block of this version: " + m_strName };
+        }
+    }
+
+    auto* pMemory = mmap(nullptr, sizeof(SSharedBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == pMemory)
+    {
+        throwError("Cannot map the shared control block: ");
+    }
+
+    if (bCreated)
+    {
+        m_pBlock = new (pMemory) SSharedBlock { };
+        pthread_mutexattr_t attributes;
+        pthread_mutexattr_init(&attributes);
+        pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&m_pBlock->mutex, &attributes);
+        pthread_mutexattr_destroy(&attributes);
+        m_pBlock->version = s_uVersion;
+        m_pBlock->enableWord.store(initialWord, std::memory_order_relaxed);
+        m_pBlock->magic.store(s_uMagic, std::memory_order_release);
+        return;
+    }
+
+    m_pBlock = static_cast<SSharedBlock*>(pMemory);
+    while (s_uMagic != m_pBlock->magic.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+    }
+    if (s_uMagic != m_pBlock->magic.load(std::memory_order_acquire) || s_uVersion != m_pBlock->version)
+    {
+        munmap(m_pBlock, sizeof(SSharedBlock));
+        throw std::runtime_error { "The segment is not a shared control block of this version: " + m_strName };
+    }
+}
+
+CSharedControl::~CSharedControl()
+{
+    munmap(m_pBlock, sizeof(SSharedBlock));
+}
+
+std::atomic<std::uint64_t>& CSharedControl::EnableWord() noexcept
+{
+    return m_pBlock->enableWord;
+}
+
+void CSharedControl::PublishEnableWord() noexcept
+{
+    m_pBlock->enableGeneration.fetch_add(1, std::memory_order_release);
+    ::syscall(SYS_futex, FutexWord(m_pBlock->enableGeneration), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    refreshMirror();
+}
+
+void CSharedControl::Mirror(TMirror mirror) noexcept
+{
+    {
+        std::lock_guard lock { m_mtxMirror };
+        m_fnMirror = std::move(mirror);
+    }
+    refreshMirror();
+}
+
+std::atomic<std::uint32_t>* CSharedControl::Bind(const EAssertLevel level, const std::string_view file, const TLine line) noexcept
+{
+    const auto stored = StoredFile(file);
+    const auto uLevel = static_cast<std::uint32_t>(level);
+    const auto uHash = HashSite(level, stored, line);
+
+    CBlockLock lock { m_pBlock->mutex };
+    for (std::uint32_t uProbe = 0; uProbe < Capacity; ++uProbe)
+    {
+        auto& entry = m_pBlock->entries[(uHash + uProbe) % Capacity];
+        if (0 == entry.used)
+        {
+            std::uint32_t uRule = 0;
+            try
+            {
+                uRule = CSiteRules::Compute(CConfigParser::Parse(m_pBlock->rules).siteRules, level, stored, line);
+            }
+            catch (...)
+            {
+                // The stored rules are validated by the writer, the entry is left without the rule.
+            }
+            entry.level = uLevel;
+            entry.line = line;
+            std::memcpy(entry.file, stored.data(), stored.size());
+            entry.file[stored.size()] = '\0';
+            entry.rule.store(uRule, std::memory_order_relaxed);
+            entry.used = 1;
+            ++m_pBlock->entryCount;
+            return &entry.rule;
+        }
+        if (uLevel == entry.level && line == entry.line && stored == entry.file)
+        {
+            return &entry.rule;
+        }
+    }
+    ++m_pBlock->overflows;
+    return nullptr;
+}
+
+std::string CSharedControl::Execute(const std::string_view request)
+{
+    const auto line = Trim(request);
+    const auto uSpace = line.find_first_of(" \t");
+    const auto command = line.substr(0, uSpace);
+    const auto argument = (std::string_view::npos == uSpace) ? std::string_view { } : Trim(line.substr(uSpace));
+
+    std::string strResponse;
+    try
+    {
+        CBlockLock lock { m_pBlock->mutex };
+        if ("list" == command)
+        {
+            for (std::uint32_t uIndex = 0; uIndex < Capacity; ++uIndex)
+            {
+                const auto& entry = m_pBlock->entries[uIndex];
+                if (0 != entry.used && (argument.empty() || CSiteRules::MatchesPath(entry.file, argument)))
+                {
+                    strResponse.append(std::to_string(uIndex)).append("\t")
+                               .append(CReportFormatter::ToString(static_cast<EAssertLevel>(entry.level))).append("\t")
+                               .append(entry.file).append(":").append(std::to_string(entry.line)).append("\t")
+                               .append(RuleModeName(entry.rule.load(std::memory_order_relaxed))).append("\n");
+                }
+            }
+        }
+        else if ("status" == command)
+        {
+            strResponse.append(CConfigParser::FormatEnableWord(m_pBlock->enableWord.load(std::memory_order_relaxed)))
+                       .append("sites=").append(std::to_string(m_pBlock->entryCount)).append("\n")
+                       .append("overflows=").append(std::to_string(m_pBlock->overflows)).append("\n")
+                       .append("rules=").append(std::to_string(CConfigParser::Parse(m_pBlock->rules).siteRules.size())).append("\n");
+        }
+        else if ("rules" == command)
+        {
+            strResponse.append(m_pBlock->rules);
+        }
+        else if ("set" == command || "config" == command)
+        {
+            const auto settings = CConfigParser::Parse(argument);
+            if (settings.reportFormat.has_value() || settings.cpuBudget.has_value() || settings.sink.has_value())
+            {
+                throw std::invalid_argument { "Only the levels, the categories and the site rules are shared." };
+            }
+            std::string strRules = ("set" == command) ? m_pBlock->rules : "";
+            for (const auto& rule : settings.siteRules)
+            {
+                strRules.append(CConfigParser::FormatRule(rule)).append("\n");
+            }
+            if (strRules.size() > MaxRulesLength)
+            {
+                throw std::invalid_argument { "The shared rules are too long." };
+            }
+            // The rules are applied first, the sites which pass the new override bits find the rules which enable
+            // them.
+            applyRules(strRules);
+            const auto uOverrideWord = CSiteRules::OverrideWordOf(CConfigParser::Parse(strRules).siteRules);
+            constexpr auto uAllOverrides = OverrideWordOf(AllLevelsMask);
+            for (auto uWord = m_pBlock->enableWord.load(std::memory_order_relaxed); ; )
+            {
+                const auto uNewWord = (CConfigParser::UpdateEnableWord(settings, uWord) & ~uAllOverrides) | uOverrideWord;
+                if (uNewWord == uWord)
+                {
+                    break;
+                }
+                if (m_pBlock->enableWord.compare_exchange_weak(uWord, uNewWord, std::memory_order_relaxed))
+                {
+                    PublishEnableWord();
+                    break;
+                }
+            }
+        }
+        else if ("help" == command)
+        {
+            strResponse.append("list [<path>]    the sites of the attached processes\n"
+                               "status           the enabled levels and categories, the counts\n"
+                               "rules            the shared site rules\n"
+                               "set <config>     sets the levels and categories, appends the site rules\n"
+                               "config <config>  sets the levels and categories, replaces the site rules\n");
+        }
+        else
+        {
+            throw std::invalid_argument { "Unknown request: '" + std::string { command } + "', see 'help'." };
+        }
+    }
+    catch (const std::exception& e)
+    {
+        return std::string { "error: " } + e.what() + "\n";
+    }
+    return strResponse.append("ok\n");
+}
+
+void CSharedControl::Remove(const std::string& name) noexcept
+{
+    try
+    {
+        shm_unlink(NormalizeName(name).c_str());
+    }
+    catch (...)
+    {
+    }
+}
+
+CSharedControl& CSharedControl::Attach(const std::string& name, const std::uint64_t initialWord, TMirror mirror)
+{
+    auto& attachment = Attachment();
+    std::lock_guard lock { attachment.mtx };
+    if (nullptr != attachment.pControl)
+    {
+        if (NormalizeName(name) != attachment.pControl->m_strName)
+        {
+            throw std::runtime_error { "The process is attached to the shared control block: " + attachment.pControl->m_strName };
+        }
+        return *attachment.pControl;
+    }
+
+    if (! attachment.bForkHandled)
+    {
+        if (0 != pthread_atfork(&prepareFork, &resumeParent, &resumeChild))
+        {
+            throw std::runtime_error { "Cannot register the fork handlers of the shared control block." };
+        }
+        attachment.bForkHandled = true;
+    }
+    // Never deleted: the asserting threads read the block until the process exits.
+    auto pControl = std::make_unique<CSharedControl>(name, true, initialWord);
+    pControl->Mirror(std::move(mirror));
+    pControl->startMirrorThread();
+    attachment.pControl = pControl.release();
+    CAssertSiteRegistry::ForEach([pControl = attachment.pControl](SAssertSite& site)
+    {
+        site.sharedRule.store(pControl->Bind(site.level, site.file, site.line), std::memory_order_release);
+    });
+    CAssertProbe::SetSharedEnabled(true);
+    return *attachment.pControl;
+}
+
+void CSharedControl::BindSite(SAssertSite& site) noexcept
+{
+    auto& attachment = Attachment();
+    std::lock_guard lock { attachment.mtx };
+    if (nullptr != attachment.pControl)
+    {
+        site.sharedRule.store(attachment.pControl->Bind(site.level, site.file, site.line), std::memory_order_release);
+    }
+}
+
+void CSharedControl::refreshMirror() noexcept
+{
+    std::lock_guard lock { m_mtxMirror };
+    if (m_fnMirror)
+    {
+        m_fnMirror(m_pBlock->enableWord.load(std::memory_order_relaxed));
+    }
+}
+
+void CSharedControl::startMirrorThread()
+{
+    std::thread { [this]
+    {
+        constexpr timespec timeout {
+            0, static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(s_mirrorTimeout).count()) };
+        for (;;)
+        {
+            const auto uGeneration = m_pBlock->enableGeneration.load(std::memory_order_acquire);
+            refreshMirror();
+            ::syscall(SYS_futex, FutexWord(m_pBlock->enableGeneration), FUTEX_WAIT, uGeneration, &timeout, nullptr, 0);
+        }
+    } }.detach();
+}
+
+void CSharedControl::prepareFork() noexcept
+{
+    auto& attachment = Attachment();
+    attachment.mtx.lock();
+    if (nullptr != attachment.pControl)
+    {
+        attachment.pControl->m_mtxMirror.lock();
+    }
+}
+
+void CSharedControl::resumeParent() noexcept
+{
+    auto& attachment = Attachment();
+    if (nullptr != attachment.pControl)
+    {
+        attachment.pControl->m_mtxMirror.unlock();
+    }
+    attachment.mtx.unlock();
+}
+
+void CSharedControl::resumeChild() noexcept
+{
+    auto& attachment = Attachment();
+    if (nullptr != attachment.pControl)
+    {
+        attachment.pControl->m_mtxMirror.unlock();
+        try
+        {
+            attachment.pControl->startMirrorThread();
+        }
+        catch (...)
+        {
+            // The child without the mirror thread keeps the enable word of the fork.
+        }
+    }
+    attachment.mtx.unlock();
+}
+
+void CSharedControl::applyRules(const std::string& text)
+{
+    const auto rules = CConfigParser::Parse(text).siteRules;
+    std::memcpy(m_pBlock->rules, text.c_str(), text.size() + 1);
+    for (auto& entry : m_pBlock->entries)
+    {
+        if (0 != entry.used)
+        {
+            entry.rule.store(
+                    CSiteRules::Compute(rules, static_cast<EAssertLevel>(entry.level), entry.file, entry.line),
+                    std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace dbgh::impl
@@ -0,0 +1,261 @@
+/**
+ * @file        CSharedControl.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CSharedControl class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "CAssertSite.h"
+
+namespace dbgh::impl
+{
+
+/**
+ * @internal
+ * @struct     SSharedBlock
+ * @brief      The layout of the shared control block, defined in CSharedControl.cpp.
+ */
+struct SSharedBlock;
+
+/**
+ * @internal
+ * @class      CSharedControl
+ * @brief      The named shared-memory segment with the enable word and the site rules of the process group.
+ *
+ * @details    The processes attached to the block (see \ref CAssertConfig::AttachSharedControl) mirror the enable word
+ *              of the block to their own one, and every site of the process gets the rule word of its entry in the
+ *              block (the entry is found or added by the level, the file and the line of the site). The asserting
+ *              threads read both words with relaxed loads, the IPC is not involved.
+ *             The writer of the enable word bumps the generation of the block and wakes the mirror thread of every
+ *              attached process (a futex on the generation), the thread copies the word to the mirror. The mirror
+ *              thread is restarted in the forked children.
+ *             The writer (the attached process or dbgh-ctl, see \ref Execute) changes the enable word and the site
+ *              rules of all attached processes at once. The rules are stored in the block as text, the rule words
+ *              of the entries added later are computed from it. The writers and the entry additions are serialized
+ *              by the process-shared robust mutex of the block, the crashed holder does not block the others.
+ *             Only the enable word and the site rules are shared: the report format, the sink and the CPU budget
+ *              stay per process.
+ *             The block is mapped for the lifetime of the process.
+ *
+ * @example    dbgh-ctl shm:/server.asserts set "levels=warning,error; file:net/=off"
+ *
+ * @note       Available on Linux.
+ */
+class CSharedControl
+{
+public:
+
+    /**
+     * @internal
+     * @brief      The function receiving the enable word of the block in the attached process.
+     */
+    using TMirror = std::function<void(std::uint64_t word)>;
+
+    /**
+     * @internal
+     * @brief      The maximum count of the site entries of the block.
+     */
+    static constexpr std::uint32_t Capacity = 4096;
+
+    /**
+     * @internal
+     * @brief      The maximum length of the stored file path, the longer paths keep their tail.
+     */
+    static constexpr std::size_t MaxFileLength = 239;
+
+    /**
+     * @internal
+     * @brief      The maximum length of the rules text.
+     */
+    static constexpr std::size_t MaxRulesLength = 16 * 1024;
+
+    /**
+     * @internal
+     * @brief      Opens the block, creating and initializing it if requested.
+     *
+     * @throw      std::system_error exception if the segment cannot be opened or mapped.
+     * @throw      std::runtime_error exception if the segment is not a control block or is not initialized in time.
+     *
+     * @param[in]  name         The name of the segment, "/" is prepended if missing.
+     * @param[in]  create       True to create the missing segment.
+     * @param[in]  initialWord  The enable word of the created block.
+     */
+    CSharedControl(std::string name, bool create, std::uint64_t initialWord = 0);
+
+    /**
+     * @internal
+     * @brief      Unmaps the block.
+     */
+    ~CSharedControl();
+
+    CSharedControl(CSharedControl&&) = delete;
+
+    CSharedControl(const CSharedControl&) = delete;
+
+    CSharedControl& operator=(CSharedControl&&) = delete;
+
+    CSharedControl& operator=(const CSharedControl&) = delete;
+
+    /**
+     * @internal
+     * @brief      Gets the enable word of the block.
+     *
+     * @return     The reference to the word in the block.
+     */
+    [[nodiscard]] std::atomic<std::uint64_t>& EnableWord() noexcept;
+
+    /**
+     * @internal
+     * @brief      Publishes the change of the enable word to the mirrors of the attached processes, called by the
+     *              writer after the change.
+     */
+    void PublishEnableWord() noexcept;
+
+    /**
+     * @internal
+     * @brief      Sets the function the enable word of the block is mirrored to by the attached process.
+     *
+     * @details    The function is called with the current word of the block, then on every change. The calls are
+     *              serialized, a word is never followed by an older one.
+     *
+     * @param[in]  mirror  The mirror, or empty to stop mirroring.
+     */
+    void Mirror(TMirror mirror) noexcept;
+
+    /**
+     * @internal
+     * @brief      Finds or adds the entry of the site.
+     *
+     * @param[in]  level  The level of the site.
+     * @param[in]  file   The file of the site.
+     * @param[in]  line   The line of the site.
+     *
+     * @return     The rule word of the entry, or null if the block is full.
+     */
+    [[nodiscard]] std::atomic<std::uint32_t>* Bind(EAssertLevel level, std::string_view file, TLine line) noexcept;
+
+    /**
+     * @internal
+     * @brief      Executes the request of the writer, the syntax of \ref CControlServer is used.
+     *
+     * @details    The requests: list [<path>], status, rules, set <config>, config <config>, help. The config may
+     *              contain the levels and the site rules only.
+     *
+     * @param[in]  request  The request line.
+     *
+     * @return     The response, ending with the status line.
+     */
+    [[nodiscard]] std::string Execute(std::string_view request);
+
+    /**
+     * @internal
+     * @brief      Removes the name of the segment, the attached processes keep their mappings.
+     *
+     * @param[in]  name  The name of the segment.
+     */
+    static void Remove(const std::string& name) noexcept;
+
+    /**
+     * @internal
+     * @brief      Attaches the process to the block: binds all registered sites and the sites registered later, and
+     *              starts mirroring the enable word of the block.
+     *
+     * @details    The block stays attached for the lifetime of the process.
+     *
+     * @throw      std::runtime_error exception if the process is attached to another block.
+     * @throw      std::system_error exception if the segment cannot be opened or mapped.
+     *
+     * @param[in]  name         The name of the segment.
+     * @param[in]  initialWord  The enable word of the block if it is created.
+     * @param[in]  mirror       The mirror of the enable word of the block, see \ref Mirror.
+     *
+     * @return     The block.
+     */
+    static CSharedControl& Attach(const std::string& name, std::uint64_t initialWord, TMirror mirror);
+
+    /**
+     * @internal
+     * @brief      Binds the site to the attached block, called at the registration of the site.
+     *
+     * @param[in]  site  The site.
+     */
+    static void BindSite(SAssertSite& site) noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      Applies the rules text to all entries, called under the mutex of the block.
+     */
+    void applyRules(const std::string& text);
+
+    /**
+     * @internal
+     * @brief      Passes the enable word of the block to the mirror.
+     */
+    void refreshMirror() noexcept;
+
+    /**
+     * @internal
+     * @brief      Starts the thread mirroring the enable word, the thread runs until the process exits.
+     */
+    void startMirrorThread();
+
+    /**
+     * @internal
+     * @brief      Locks the attachment and the mirror before the fork, the child does not inherit the held mutexes.
+     */
+    static void prepareFork() noexcept;
+
+    /**
+     * @internal
+     * @brief      Unlocks the attachment and the mirror after the fork in the parent.
+     */
+    static void resumeParent() noexcept;
+
+    /**
+     * @internal
+     * @brief      Unlocks the attachment and the mirror after the fork in the child and restarts the mirror thread,
+     *              the threads are not inherited.
+     */
+    static void resumeChild() noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      The name of the segment.
+     */
+    const std::string m_strName;
+
+    /**
+     * @internal
+     * @brief      The mapped block.
+     */
+    SSharedBlock* m_pBlock;
+
+    /**
+     * @internal
+     * @brief      The mutex serializing the calls of the mirror.
+     */
+    std::mutex m_mtxMirror;
+
+    /**
+     * @internal
+     * @brief      The mirror of the attached process, see \ref Mirror.
+     */
+    TMirror m_fnMirror;
+
+}; // class CSharedControl
+
+} // namespace dbgh::impl
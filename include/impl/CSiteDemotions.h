@@ -0,0 +1,136 @@
+/**
+ * @file        CSiteDemotions.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for SSiteDemotion struct and CSiteDemotions class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "CAssertProbe.h"
+#include "CAssertSite.h"
+#include "EAssertLevel.h"
+
+#if defined(DBGH_ASSERTS_DEMOTIONS_HEADER)
+#include DBGH_ASSERTS_DEMOTIONS_HEADER
+#endif
+
+#ifndef DBGH_ASSERTS_DEMOTIONS
+
+/**
+ * @brief      The entries of the demotion table, generated from the recorded profile.
+ *
+ * @details    Every entry is { "file", line, dbgh::ESiteMode::<mode> }, followed by a comma.
+ *              The table is generated by cmake/DBGHAssertsDemotion.cmake when the DBGH_ASSERTS_DEMOTION_PROFILE
+ *              option is set, without it no site is demoted.
+ */
+#define DBGH_ASSERTS_DEMOTIONS
+#endif
+
+namespace dbgh
+{
+
+/**
+ * @struct     SSiteDemotion
+ * @brief      The mode of one assertion site, chosen at compile time.
+ */
+struct SSiteDemotion
+{
+    /**
+     * @brief      The filename that contains the assertion, or its trailing path components.
+     */
+    const char* file;
+
+    /**
+     * @brief      The line number in the file that contains the assertion.
+     */
+    TLine line;
+
+    /**
+     * @brief      The mode, \ref ESiteMode::Disabled removes the check from the build.
+     */
+    ESiteMode mode;
+};
+
+
+/**
+ * @class      CSiteDemotions
+ * @brief      The compile-time demotion of the hot assertion sites.
+ *
+ * @details    The assert macros look up their site at compile time. The Disabled site is compiled out, the Sampled
+ *              site is passed to \ref CAssertProbe as the compiled mode, all other sites keep the full check.
+ *             The sites of \ref ASSERT_FATAL are never demoted.
+ *             The workflow:
+ *              > build with DBGH_ASSERTS_PROFILE and run with DBGH_ASSERTS_PROFILE_FILE=<profile>,
+ *              > build with DBGH_ASSERTS_DEMOTION_PROFILE=<profile>, it generates the table of the hottest sites.
+ */
+class CSiteDemotions
+{
+public:
+
+    CSiteDemotions() = delete;
+
+    /**
+     * @brief      Finds the mode of the site in the table.
+     *
+     * @param[in]  pTable  The table, terminated by the entry with the null file.
+     * @param[in]  file    The filename that contains the assertion.
+     * @param[in]  line    The line number in the file that contains the assertion.
+     *
+     * @return     The mode of the site, \ref ESiteMode::Full if the site is not in the table.
+     */
+    [[nodiscard]] static constexpr ESiteMode Find(
+            const SSiteDemotion* pTable, const std::string_view file, const TLine line) noexcept
+    {
+        for (; nullptr != pTable->file; ++pTable)
+        {
+            const std::string_view entry { pTable->file };
+            if (line == pTable->line && file.ends_with(entry)
+                && (file.size() == entry.size() || isSeparator(file[file.size() - entry.size() - 1])))
+            {
+                return pTable->mode;
+            }
+        }
+        return ESiteMode::Full;
+    }
+
+    /**
+     * @brief      Gets the compiled mode of the site.
+     *
+     * @param[in]  level  The assert level.
+     * @param[in]  file   The filename that contains the assertion.
+     * @param[in]  line   The line number in the file that contains the assertion.
+     *
+     * @return     The mode of the site.
+     */
+    [[nodiscard]] static constexpr ESiteMode Get(
+            const EAssertLevel level, const std::string_view file, const TLine line) noexcept
+    {
+        return (EAssertLevel::Fatal == level) ? ESiteMode::Full : Find(s_arrTable, file, line);
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      Determines whether the character separates the path components.
+     */
+    static constexpr bool isSeparator(const char symbol) noexcept
+    {
+        return '/' == symbol || '\\' == symbol;
+    }
+
+private:
+
+    /**
+     * @internal
+     * @brief      The generated table.
+     */
+    static constexpr SSiteDemotion s_arrTable[] = { DBGH_ASSERTS_DEMOTIONS { nullptr, 0, ESiteMode::Full } };
+
+}; // class CSiteDemotions
+
+} // namespace dbgh
@@ -0,0 +1,257 @@
+/**
+ * @file        CSiteRules.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CSiteRules class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <mutex>
+
+#include "CSiteRules.h"
+
+namespace dbgh
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The rules and the mutex protecting them.
+ */
+struct SRuleStorage
+{
+    std::mutex mtx;
+    std::vector<SSiteRule> vecRules;
+    std::vector<SSiteRule> vecBursts;
+    std::vector<SSiteRule> vecEffective;
+    std::uint64_t uEnableWord = ~std::uint64_t { 0 };
+    std::uint64_t uOverrideWord = 0;
+    std::atomic<std::uint64_t>* pEnableWord = nullptr;
+};
+
+/**
+ * @internal
+ * @brief      Gets the storage of the rules.
+ */
+SRuleStorage& Storage()
+{
+    static SRuleStorage storage;
+    return storage;
+}
+
+/**
+ * @internal
+ * @brief      Determines whether the character separates the path components.
+ */
+bool IsSeparator(const char symbol) noexcept
+{
+    return '/' == symbol || '\\' == symbol;
+}
+
+/**
+ * @internal
+ * @brief      Writes the rule bits to the slots of the site given by the mask (bit 0 for slot 0, bit 1 for slot 1).
+ */
+void WriteRule(SAssertSite& site, const std::uint32_t uSlots, const std::uint32_t uRule) noexcept
+{
+    std::uint32_t uMask = 0;
+    std::uint32_t uSet = 0;
+    for (std::uint32_t uSlot = 0; uSlot < 2; ++uSlot)
+    {
+        if (0 != (uSlots & (1u << uSlot)))
+        {
+            const auto uShift = SAssertSite::RuleSlotShift + uSlot * SAssertSite::RuleSlotBits;
+            uMask |= ((1u << SAssertSite::RuleSlotBits) - 1) << uShift;
+            uSet |= uRule << uShift;
+        }
+    }
+    auto uFlags = site.flags.load(std::memory_order_relaxed);
+    while (! site.flags.compare_exchange_weak(uFlags, (uFlags & ~uMask) | uSet, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @internal
+ * @brief      Applies the rules and the burst rules of the storage to all registered sites and publishes them with the
+ *              enable word of the storage, called under the mutex.
+ *
+ * @details    The bound enable word gets the new levels and override bits before the switch, so the sites enabled by
+ *              the new configuration pass it, and loses the old ones after the switch. The sites which pass the word
+ *              by the old bits are stopped by the enable word and the rules of the new slot.
+ */
+void Publish(SRuleStorage& storage)
+{
+    auto vecEffective = storage.vecRules;
+    vecEffective.insert(vecEffective.end(), storage.vecBursts.begin(), storage.vecBursts.end());
+    const auto uNextSlot = 1 - CAssertProbe::ActiveRuleSlot();
+    CAssertSiteRegistry::ForEach([&vecEffective, uNextSlot](SAssertSite& site)
+    {
+        WriteRule(site, 1u << uNextSlot, CSiteRules::Compute(vecEffective, site.level, site.file, site.line));
+    });
+    storage.vecEffective = std::move(vecEffective);
+    storage.uOverrideWord = CSiteRules::OverrideWordOf(storage.vecEffective);
+    CAssertProbe::SetEnableWord(uNextSlot, storage.uEnableWord);
+    if (nullptr != storage.pEnableWord)
+    {
+        storage.pEnableWord->fetch_or(storage.uEnableWord | storage.uOverrideWord, std::memory_order_relaxed);
+    }
+    CAssertProbe::PublishRules(! storage.vecEffective.empty(), uNextSlot);
+    if (nullptr != storage.pEnableWord)
+    {
+        storage.pEnableWord->store(storage.uEnableWord | storage.uOverrideWord, std::memory_order_relaxed);
+    }
+}
+}  // unnamed namespace
+
+void CSiteRules::BindEnableWord(std::atomic<std::uint64_t>& word) noexcept
+{
+    auto& storage = Storage();
+    std::lock_guard lock { storage.mtx };
+    storage.pEnableWord = &word;
+    storage.uEnableWord = word.load(std::memory_order_relaxed) & ~dbgh::OverrideWordOf(AllLevelsMask);
+    CAssertProbe::SetEnableWord(0, storage.uEnableWord);
+    CAssertProbe::SetEnableWord(1, storage.uEnableWord);
+    word.store(storage.uEnableWord | storage.uOverrideWord, std::memory_order_relaxed);
+}
+
+void CSiteRules::Set(std::vector<SSiteRule> rules)
+{
+    auto& storage = Storage();
+    std::lock_guard lock { storage.mtx };
+    storage.vecRules = std::move(rules);
+    Publish(storage);
+}
+
+void CSiteRules::Set(std::vector<SSiteRule> rules, const std::uint64_t word)
+{
+    auto& storage = Storage();
+    std::lock_guard lock { storage.mtx };
+    storage.vecRules = std::move(rules);
+    storage.uEnableWord = word;
+    Publish(storage);
+}
+
+void CSiteRules::SetEnableWord(const std::uint64_t word)
+{
+    auto& storage = Storage();
+    std::lock_guard lock { storage.mtx };
+    storage.uEnableWord = word;
+    CAssertProbe::SetEnableWord(CAssertProbe::ActiveRuleSlot(), word);
+    if (nullptr != storage.pEnableWord)
+    {
+        storage.pEnableWord->store(word | storage.uOverrideWord, std::memory_order_relaxed);
+    }
+}
+
+void CSiteRules::SetBursts(std::vector<SSiteRule> rules)
+{
+    auto& storage = Storage();
+    std::lock_guard lock { storage.mtx };
+    storage.vecBursts = std::move(rules);
+    Publish(storage);
+}
+
+std::vector<SSiteRule> CSiteRules::Get()
+{
+    auto& storage = Storage();
+    std::lock_guard lock { storage.mtx };
+    return storage.vecRules;
+}
+
+void CSiteRules::Apply(SAssertSite& site) noexcept
+{
+    auto& storage = Storage();
+    std::lock_guard lock { storage.mtx };
+    // The new site is not seen by the asserting threads yet, both slots get the current rules.
+    WriteRule(site, 0b11u, Compute(storage.vecEffective, site.level, site.file, site.line));
+}
+
+bool CSiteRules::Matches(const SSiteRule& rule, const SAssertSite& site) noexcept
+{
+    return Matches(rule, site.level, site.file, site.line);
+}
+
+bool CSiteRules::Matches(
+        const SSiteRule& rule, const EAssertLevel level, const std::string_view file, const TLine line) noexcept
+{
+    return (! rule.level.has_value() || *rule.level == level)
+           && (0 == rule.line || rule.line == line)
+           && (rule.file.empty() || MatchesPath(file, rule.file));
+}
+
+std::uint32_t CSiteRules::Compute(
+        const std::vector<SSiteRule>& rules, const EAssertLevel level, const std::string_view file, const TLine line) noexcept
+{
+    const SSiteRule* pMatched = nullptr;
+    for (const auto& rule : rules)
+    {
+        if (Matches(rule, level, file, line))
+        {
+            pMatched = &rule;
+        }
+    }
+    if (nullptr == pMatched)
+    {
+        return 0;
+    }
+
+    auto uRule = SAssertSite::RulePinned | (pMatched->rateShift << SAssertSite::RuleRateShift);
+    if (ESiteMode::Sampled == pMatched->mode)
+    {
+        uRule |= SAssertSite::RuleSampled;
+    }
+    else if (ESiteMode::Disabled == pMatched->mode)
+    {
+        uRule |= SAssertSite::RuleDisabled;
+    }
+    if (Enables(*pMatched))
+    {
+        uRule |= SAssertSite::RuleEnabled;
+    }
+    return uRule;
+}
+
+bool CSiteRules::Enables(const SSiteRule& rule) noexcept
+{
+    return ! rule.file.empty() && 0 != rule.line && ESiteMode::Disabled != rule.mode;
+}
+
+std::uint64_t CSiteRules::OverrideWordOf(const std::vector<SSiteRule>& rules) noexcept
+{
+    std::uint64_t uWord = 0;
+    for (const auto& rule : rules)
+    {
+        if (Enables(rule))
+        {
+            uWord |= rule.level.has_value() ? OverrideBit(*rule.level) : dbgh::OverrideWordOf(AllLevelsMask);
+        }
+    }
+    return uWord;
+}
+
+bool CSiteRules::MatchesPath(const std::string_view path, const std::string_view pattern) noexcept
+{
+    if (pattern.empty())
+    {
+        return false;
+    }
+    if (IsSeparator(pattern.back()))
+    {
+        // The directory matches at any component boundary.
+        for (auto uPos = path.find(pattern); std::string_view::npos != uPos; uPos = path.find(pattern, uPos + 1))
+        {
+            if (0 == uPos || IsSeparator(path[uPos - 1]) || IsSeparator(pattern.front()))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    return path.ends_with(pattern)
+           && (path.size() == pattern.size() || IsSeparator(path[path.size() - pattern.size() - 1])
+               || IsSeparator(pattern.front()));
+}
+
+} // namespace dbgh
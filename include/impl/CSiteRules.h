@@ -0,0 +1,221 @@
+/**
+ * @file        CSiteRules.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for SSiteRule struct and CSiteRules class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CAssertProbe.h"
+#include "CAssertSite.h"
+#include "EAssertLevel.h"
+
+namespace dbgh
+{
+
+/**
+ * @struct     SSiteRule
+ * @brief      The configuration rule which sets the evaluation mode of the matching sites.
+ *
+ * @details    The rule matches the site if all set fields match: the level, the file and the line.
+ *             The rule which names one site (the file and the line) and does not disable it enables the site also
+ *              if its level or its category is disabled, see \ref CSiteRules::Enables.
+ */
+struct SSiteRule
+{
+    /**
+     * @brief      The level of the matching sites, or any level.
+     */
+    std::optional<EAssertLevel> level;
+
+    /**
+     * @brief      The path suffix of the matching sites, the pattern ending with '/' matches the directory.
+     *              Empty matches any file.
+     */
+    std::string file;
+
+    /**
+     * @brief      The line of the matching sites, zero matches any line.
+     */
+    TLine line = 0;
+
+    /**
+     * @brief      The mode of the matching sites.
+     */
+    ESiteMode mode = ESiteMode::Full;
+
+    /**
+     * @brief      The log2 of the sampling rate of the Sampled mode, zero is \ref CAssertProbe::SampleRate.
+     */
+    std::uint32_t rateShift = 0;
+};
+
+
+/**
+ * @class      CSiteRules
+ * @brief      The site rules of the configuration, compiled into the flags of the sites.
+ *
+ * @details    The rules are compiled into the flags of every registered site when they are set, and of every new
+ *              site at the registration, so the assert macros read only the site flags. The last matching rule wins.
+ *              The matched site is pinned: the CPU budget governor does not choose its mode.
+ *             Every site has two rule slots (see \ref SAssertSite::RuleSlotShift). The new rules are written to the
+ *              inactive slots and published by one store which switches the active slot, so the asserting threads
+ *              never block and see either the old or the new rules of all sites.
+ *             The enable word of the configuration is published with the rules, to the enable word of the slot
+ *              (see \ref CAssertProbe::PublishRules): the new levels never run under the old rules.
+ *             The rules also write the enable word read by \ref CAssertConfig::IsActiveAssert (see
+ *              \ref BindEnableWord): it is the enable word of the configuration with the override bits of the levels
+ *              of the rules which enable a site (see \ref OverrideBit). While no such rule is set, the sites of a
+ *              disabled level still cost one load and one AND; while it is set, the sites of the level are registered
+ *              when reached and stopped by \ref CAssertProbe unless the rule enables them.
+ */
+class CSiteRules
+{
+public:
+
+    CSiteRules() = delete;
+
+    /**
+     * @internal
+     * @brief      Binds the enable word of the configuration, the rules keep its override bits.
+     *
+     * @details    The current value of the word is the enable word of the configuration, see \ref SetEnableWord.
+     *
+     * @param[in]  word  The enable word read by \ref CAssertConfig::IsActiveAssert.
+     */
+    static void BindEnableWord(std::atomic<std::uint64_t>& word) noexcept;
+
+    /**
+     * @brief      Replaces the rules and applies them to all registered sites.
+     *
+     * @details    The sites pinned by the previous rules which match no new rule get back the mode chosen by the
+     *              CPU budget governor. The concurrent calls are serialized.
+     *
+     * @param[in]  rules  The rules.
+     */
+    static void Set(std::vector<SSiteRule> rules);
+
+    /**
+     * @brief      Replaces the rules and the enable word and publishes them by one switch of the active slot.
+     *
+     * @details    See \ref Set. The asserting threads see either the old rules and the old enable word or the new
+     *              ones, the threads which checked the old enable word before the switch are stopped by the new one.
+     *
+     * @param[in]  rules  The rules.
+     * @param[in]  word   The enable word, see \ref EnableBit.
+     */
+    static void Set(std::vector<SSiteRule> rules, std::uint64_t word);
+
+    /**
+     * @brief      Replaces the enable word of the active slot and of the configuration, the rules are kept.
+     *
+     * @param[in]  word  The enable word, see \ref EnableBit.
+     */
+    static void SetEnableWord(std::uint64_t word);
+
+    /**
+     * @brief      Replaces the burst rules, which are appended after the rules of the configuration.
+     *
+     * @details    The burst rules are set by \ref CAssertConfig::EnableSiteFor and kept apart, so they survive the
+     *              replacement of the configuration rules and are not listed by \ref Get.
+     *
+     * @param[in]  rules  The burst rules.
+     */
+    static void SetBursts(std::vector<SSiteRule> rules);
+
+    /**
+     * @brief      Gets the current rules of the configuration.
+     *
+     * @return     The copy of the rules.
+     */
+    [[nodiscard]] static std::vector<SSiteRule> Get();
+
+    /**
+     * @brief      Applies the rules to the site.
+     *
+     * @param[in]  site  The site.
+     */
+    static void Apply(SAssertSite& site) noexcept;
+
+    /**
+     * @brief      Determines whether the rule matches the site.
+     *
+     * @param[in]  rule  The rule.
+     * @param[in]  site  The site.
+     *
+     * @return     True if the rule matches, False otherwise.
+     */
+    [[nodiscard]] static bool Matches(const SSiteRule& rule, const SAssertSite& site) noexcept;
+
+    /**
+     * @brief      Determines whether the rule matches the site given by its level, file and line.
+     *
+     * @param[in]  rule   The rule.
+     * @param[in]  level  The level of the site.
+     * @param[in]  file   The file of the site.
+     * @param[in]  line   The line of the site.
+     *
+     * @return     True if the rule matches, False otherwise.
+     */
+    [[nodiscard]] static bool Matches(const SSiteRule& rule, EAssertLevel level, std::string_view file, TLine line) noexcept;
+
+    /**
+     * @brief      Computes the rule bits of the site given by its level, file and line, the last matching rule wins.
+     *
+     * @param[in]  rules  The rules.
+     * @param[in]  level  The level of the site.
+     * @param[in]  file   The file of the site.
+     * @param[in]  line   The line of the site.
+     *
+     * @return     The rule bits (see \ref SAssertSite::RuleOf), zero if no rule matches.
+     */
+    [[nodiscard]] static std::uint32_t Compute(
+            const std::vector<SSiteRule>& rules, EAssertLevel level, std::string_view file, TLine line) noexcept;
+
+    /**
+     * @brief      Determines whether the rule enables the matched site also if its level or its category is disabled.
+     *
+     * @details    The rule names one site (the file and the line, as the rules of \ref CAssertConfig::EnableSiteFor)
+     *              and does not disable it.
+     *
+     * @param[in]  rule  The rule.
+     *
+     * @return     True if the rule enables the site, False otherwise.
+     */
+    [[nodiscard]] static bool Enables(const SSiteRule& rule) noexcept;
+
+    /**
+     * @brief      Gets the override bits of the levels of the rules which enable a site, see \ref Enables.
+     *
+     * @param[in]  rules  The rules.
+     *
+     * @return     The word with the override bits, see \ref OverrideBit.
+     */
+    [[nodiscard]] static std::uint64_t OverrideWordOf(const std::vector<SSiteRule>& rules) noexcept;
+
+    /**
+     * @brief      Determines whether the path matches the pattern.
+     *
+     * @details    The pattern matches the trailing path components, "net/socket.cpp" matches
+     *              "/src/net/socket.cpp". The pattern ending with '/' matches all files of the directory at any depth,
+     *              "net/" matches "/src/net/socket.cpp" and "/src/net/tcp/client.cpp".
+     *
+     * @param[in]  path     The path.
+     * @param[in]  pattern  The pattern.
+     *
+     * @return     True if the path matches, False otherwise.
+     */
+    [[nodiscard]] static bool MatchesPath(std::string_view path, std::string_view pattern) noexcept;
+
+}; // class CSiteRules
+
+} // namespace dbgh
@@ -0,0 +1,414 @@
+/**
+ * @file        CStatsSegment.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CStatsSegment class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CAssertProfiler.h"
+#include "CStatsSegment.h"
+
+namespace dbgh::impl
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The mark of the initialized segment, "DBGS".
+ */
+constexpr std::uint32_t s_uMagic = 0x44424753;
+
+/**
+ * @internal
+ * @brief      The version of the segment layout.
+ */
+constexpr std::uint32_t s_uVersion = 2;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "The shared atomics must be address-free.");
+} // unnamed namespace
+
+/**
+ * @internal
+ * @struct     SStatsEntry
+ * @brief      The entry of the site in the stats segment.
+ */
+struct SStatsEntry
+{
+    /**
+     * @internal
+     * @brief      The failed assertions.
+     */
+    std::atomic<std::uint64_t> failures;
+
+    /**
+     * @internal
+     * @brief      The failures suppressed by the report backoff or the circuit breaker.
+     */
+    std::atomic<std::uint64_t> suppressed;
+
+    /**
+     * @internal
+     * @brief      The failures dropped by the filter.
+     */
+    std::atomic<std::uint64_t> dropped;
+
+    /**
+     * @internal
+     * @brief      The evaluated expressions.
+     */
+    std::atomic<std::uint64_t> evaluations;
+
+    /**
+     * @internal
+     * @brief      The level of the site.
+     */
+    std::uint32_t level;
+
+    /**
+     * @internal
+     * @brief      The line of the site.
+     */
+    TLine line;
+
+    /**
+     * @internal
+     * @brief      The file of the site, null-terminated.
+     */
+    char file[CStatsSegment::MaxFileLength + 1];
+
+    /**
+     * @internal
+     * @brief      The expression of the site, null-terminated.
+     */
+    char expression[CStatsSegment::MaxExpressionLength + 1];
+};
+
+struct SStatsBlock
+{
+    /**
+     * @internal
+     * @brief      Set to \ref s_uMagic when the segment is initialized.
+     */
+    std::atomic<std::uint32_t> magic;
+
+    /**
+     * @internal
+     * @brief      The version of the layout.
+     */
+    std::uint32_t version;
+
+    /**
+     * @internal
+     * @brief      The count of the entries.
+     */
+    std::uint32_t capacity;
+
+    /**
+     * @internal
+     * @brief      The process id of the writer.
+     */
+    std::uint32_t pid;
+
+    /**
+     * @internal
+     * @brief      The count of the publications.
+     */
+    std::atomic<std::uint64_t> publications;
+
+    /**
+     * @internal
+     * @brief      The steady clock time of the last publication in nanoseconds, stored before the publication count.
+     */
+    std::atomic<std::uint64_t> publishedAt;
+
+    /**
+     * @internal
+     * @brief      The count of the published entries, stored with the release order after the entry is written.
+     */
+    std::atomic<std::uint32_t> siteCount;
+
+    /**
+     * @internal
+     * @brief      The count of the sites not published because the segment is full.
+     */
+    std::atomic<std::uint32_t> overflows;
+
+    /**
+     * @internal
+     * @brief      The site entries, in the order of the publication.
+     */
+    SStatsEntry entries[CStatsSegment::Capacity];
+};
+
+namespace
+{
+/**
+ * @internal
+ * @brief      Prepends "/" to the name of the segment if it is missing.
+ */
+std::string NormalizeName(std::string name)
+{
+    return (name.starts_with('/')) ? name : "/" + name;
+}
+
+/**
+ * @internal
+ * @brief      Determines whether the existing segment of the name was left by a process which is not running.
+ *
+ * @details    The magic and the process id are at the same offsets in all versions of the layout. The segment
+ *              without the magic may be initialized by the starting process right now, it is not stale.
+ */
+bool IsStaleSegment(const std::string& name) noexcept
+{
+    const auto fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (-1 == fd)
+    {
+        return false;
+    }
+    struct SHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t capacity;
+        std::uint32_t pid;
+    };
+    struct stat status { };
+    auto bStale = false;
+    if (0 == fstat(fd, &status) && static_cast<std::size_t>(status.st_size) >= sizeof(SHeader))
+    {
+        auto* pMemory = mmap(nullptr, sizeof(SHeader), PROT_READ, MAP_SHARED, fd, 0);
+        if (MAP_FAILED != pMemory)
+        {
+            SHeader header { };
+            std::memcpy(&header, pMemory, sizeof(header));
+            munmap(pMemory, sizeof(SHeader));
+            bStale = s_uMagic == header.magic && 0 != header.pid
+                     && -1 == kill(static_cast<pid_t>(header.pid), 0) && ESRCH == errno;
+        }
+    }
+    close(fd);
+    return bStale;
+}
+
+/**
+ * @internal
+ * @brief      Gets the current time of the steady clock in nanoseconds.
+ */
+std::uint64_t SteadyNanoseconds() noexcept
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @internal
+ * @brief      Copies the text to the null-terminated field, keeps the tail or the head of the long text.
+ */
+template<std::size_t Size>
+void StoreText(char (&field)[Size], std::string_view text, const bool keepTail) noexcept
+{
+    if (text.size() >= Size)
+    {
+        text = keepTail ? text.substr(text.size() - (Size - 1)) : text.substr(0, Size - 1);
+    }
+    std::memcpy(field, text.data(), text.size());
+    field[text.size()] = '\0';
+}
+} // unnamed namespace
+
+CStatsSegment::CStatsSegment(std::string name, const std::chrono::milliseconds period)
+        : m_strName { NormalizeName(std::move(name)) },
+        m_period { period },
+        m_pBlock { nullptr }
+{
+    const auto throwError = [this](const char* pszWhat)
+    {
+        throw std::system_error { errno, std::generic_category(), std::string { pszWhat } + m_strName };
+    };
+
+    // The segment of the running process is never replaced. The segment left by the crashed process is, its
+    // readers keep the old mapping.
+    auto fd = shm_open(m_strName.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (-1 == fd && EEXIST == errno && IsStaleSegment(m_strName))
+    {
+        shm_unlink(m_strName.c_str());
+        fd = shm_open(m_strName.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    }
+    if (-1 == fd)
+    {
+        throwError("Cannot create the stats segment: ");
+    }
+    if (-1 == ftruncate(fd, sizeof(SStatsBlock)))
+    {
+        const auto iError = errno;
+        close(fd);
+        shm_unlink(m_strName.c_str());
+        errno = iError;
+        throwError("Cannot size the stats segment: ");
+    }
+    auto* pMemory = mmap(nullptr, sizeof(SStatsBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == pMemory)
+    {
+        const auto iError = errno;
+        shm_unlink(m_strName.c_str());
+        errno = iError;
+        throwError("Cannot map the stats segment: ");
+    }
+
+    m_pBlock = new (pMemory) SStatsBlock { };
+    m_pBlock->version = s_uVersion;
+    m_pBlock->capacity = Capacity;
+    m_pBlock->pid = static_cast<std::uint32_t>(getpid());
+    Publish();
+    m_pBlock->magic.store(s_uMagic, std::memory_order_release);
+    m_worker = std::jthread { [this](std::stop_token stopToken) { workerLoop(std::move(stopToken)); } };
+}
+
+CStatsSegment::~CStatsSegment()
+{
+    m_worker.request_stop();
+    m_worker.join();
+    munmap(m_pBlock, sizeof(SStatsBlock));
+    shm_unlink(m_strName.c_str());
+}
+
+void CStatsSegment::Publish()
+{
+    std::lock_guard lock { m_mtxPublish };
+    std::unordered_map<const SAssertSite*, std::uint64_t> mapEvaluations;
+    for (const auto& profile : CAssertProfiler::Collect())
+    {
+        mapEvaluations[profile.pSite] = profile.evaluation.count;
+    }
+
+    std::uint32_t uOverflows = 0;
+    CAssertSiteRegistry::ForEach([this, &mapEvaluations, &uOverflows](const SAssertSite& site)
+    {
+        auto itEntry = m_mapEntries.find(&site);
+        if (m_mapEntries.end() == itEntry)
+        {
+            const auto uIndex = m_pBlock->siteCount.load(std::memory_order_relaxed);
+            if (uIndex >= Capacity)
+            {
+                ++uOverflows;
+                return;
+            }
+            auto& entry = m_pBlock->entries[uIndex];
+            entry.level = static_cast<std::uint32_t>(site.level);
+            entry.line = site.line;
+            StoreText(entry.file, site.file, true);
+            StoreText(entry.expression, site.expression, false);
+            itEntry = m_mapEntries.emplace(&site, uIndex).first;
+            m_pBlock->siteCount.store(uIndex + 1, std::memory_order_release);
+        }
+
+        auto& entry = m_pBlock->entries[itEntry->second];
+        entry.failures.store(site.failures.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        entry.suppressed.store(site.suppressed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        entry.dropped.store(site.dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        const auto itEvaluations = mapEvaluations.find(&site);
+        entry.evaluations.store(
+                (mapEvaluations.end() != itEvaluations) ? itEvaluations->second : 0, std::memory_order_relaxed);
+    });
+    m_pBlock->overflows.store(uOverflows, std::memory_order_relaxed);
+    m_pBlock->publishedAt.store(SteadyNanoseconds(), std::memory_order_relaxed);
+    m_pBlock->publications.fetch_add(1, std::memory_order_release);
+}
+
+SStatsSnapshot CStatsSegment::Read(const std::string& name)
+{
+    const auto strName = NormalizeName(name);
+    const auto fd = shm_open(strName.c_str(), O_RDONLY, 0);
+    if (-1 == fd)
+    {
+        throw std::system_error { errno, std::generic_category(), "Cannot open the stats segment: " + strName };
+    }
+    struct stat status { };
+    if (0 != fstat(fd, &status) || static_cast<std::size_t>(status.st_size) != sizeof(SStatsBlock))
+    {
+        close(fd);
+        throw std::runtime_error { "The segment is not a stats segment of this version: " + strName };
+    }
+    auto* pMemory = mmap(nullptr, sizeof(SStatsBlock), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == pMemory)
+    {
+        throw std::system_error { errno, std::generic_category(), "Cannot map the stats segment: " + strName };
+    }
+
+    const auto* pBlock = static_cast<const SStatsBlock*>(pMemory);
+    if (s_uMagic != pBlock->magic.load(std::memory_order_acquire) || s_uVersion != pBlock->version
+        || Capacity != pBlock->capacity)
+    {
+        munmap(pMemory, sizeof(SStatsBlock));
+        throw std::runtime_error { "The segment is not a stats segment of this version: " + strName };
+    }
+
+    SStatsSnapshot snapshot;
+    snapshot.pid = pBlock->pid;
+    snapshot.publications = pBlock->publications.load(std::memory_order_acquire);
+    const std::chrono::nanoseconds publishedAt {
+            static_cast<std::chrono::nanoseconds::rep>(pBlock->publishedAt.load(std::memory_order_relaxed)) };
+    snapshot.publishedAt = std::chrono::steady_clock::time_point {
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(publishedAt) };
+    snapshot.overflows = pBlock->overflows.load(std::memory_order_relaxed);
+    const auto uCount = std::min(pBlock->siteCount.load(std::memory_order_acquire), Capacity);
+    snapshot.sites.reserve(uCount);
+    for (std::uint32_t uIndex = 0; uIndex < uCount; ++uIndex)
+    {
+        const auto& entry = pBlock->entries[uIndex];
+        SSiteStats stats;
+        stats.level = static_cast<EAssertLevel>(entry.level);
+        stats.line = entry.line;
+        stats.file = entry.file;
+        stats.expression = entry.expression;
+        stats.failures = entry.failures.load(std::memory_order_relaxed);
+        stats.suppressed = entry.suppressed.load(std::memory_order_relaxed);
+        stats.dropped = entry.dropped.load(std::memory_order_relaxed);
+        stats.evaluations = entry.evaluations.load(std::memory_order_relaxed);
+        snapshot.sites.push_back(std::move(stats));
+    }
+    munmap(pMemory, sizeof(SStatsBlock));
+    return snapshot;
+}
+
+void CStatsSegment::workerLoop(std::stop_token stopToken)
+{
+    std::mutex mtxWait;
+    std::unique_lock lock { mtxWait };
+    while (! m_cvWorker.wait_for(lock, stopToken, m_period, [] { return false; }))
+    {
+        if (stopToken.stop_requested())
+        {
+            return;
+        }
+        try
+        {
+            Publish();
+        }
+        catch (...)
+        {
+            // The counters are published in the next period.
+        }
+    }
+}
+
+} // namespace dbgh::impl
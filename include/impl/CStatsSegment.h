@@ -0,0 +1,267 @@
+/**
+ * @file        CStatsSegment.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for SSiteStats, SStatsSnapshot structs and CStatsSegment class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "CAssertSite.h"
+
+namespace dbgh::impl
+{
+
+/**
+ * @internal
+ * @struct     SStatsBlock
+ * @brief      The layout of the stats segment, defined in CStatsSegment.cpp.
+ */
+struct SStatsBlock;
+
+/**
+ * @internal
+ * @struct     SSiteStats
+ * @brief      The counters of one site read from the stats segment.
+ */
+struct SSiteStats
+{
+    /**
+     * @internal
+     * @brief      The level of the site.
+     */
+    EAssertLevel level = EAssertLevel::Warning;
+
+    /**
+     * @internal
+     * @brief      The line of the site.
+     */
+    TLine line = 0;
+
+    /**
+     * @internal
+     * @brief      The file of the site, the tail of the long path.
+     */
+    std::string file;
+
+    /**
+     * @internal
+     * @brief      The expression of the site, the head of the long expression.
+     */
+    std::string expression;
+
+    /**
+     * @internal
+     * @brief      The failed assertions, see \ref SAssertSite::failures.
+     */
+    std::uint64_t failures = 0;
+
+    /**
+     * @internal
+     * @brief      The failures suppressed by the report backoff or the circuit breaker.
+     */
+    std::uint64_t suppressed = 0;
+
+    /**
+     * @internal
+     * @brief      The failures dropped by the filter.
+     */
+    std::uint64_t dropped = 0;
+
+    /**
+     * @internal
+     * @brief      The evaluated expressions, counted with DBGH_ASSERTS_PROFILE only.
+     */
+    std::uint64_t evaluations = 0;
+};
+
+/**
+ * @internal
+ * @struct     SStatsSnapshot
+ * @brief      The content of the stats segment.
+ */
+struct SStatsSnapshot
+{
+    /**
+     * @internal
+     * @brief      The process id of the writer.
+     */
+    std::uint32_t pid = 0;
+
+    /**
+     * @internal
+     * @brief      The count of the publications, grows while the writer is alive.
+     */
+    std::uint64_t publications = 0;
+
+    /**
+     * @internal
+     * @brief      The time of the last publication, the rates are measured between the publications.
+     */
+    std::chrono::steady_clock::time_point publishedAt { };
+
+    /**
+     * @internal
+     * @brief      The count of the sites not published because the segment is full.
+     */
+    std::uint32_t overflows = 0;
+
+    /**
+     * @internal
+     * @brief      The sites, in the order of the publication.
+     */
+    std::vector<SSiteStats> sites;
+};
+
+/**
+ * @internal
+ * @class      CStatsSegment
+ * @brief      Publishes the counters of the sites to the named shared-memory segment of the process.
+ *
+ * @details    Every period the background thread copies the failure, suppression, drop and evaluation counters of
+ *              the sites (see \ref CMetricsExporter) to the segment. The asserting threads do not write to the
+ *              segment, so the observation costs nothing to them, and the readers (see \ref Read and the dbgh-top
+ *              tool) map it read-only and never block the process.
+ *             The layout is versioned: the header with the magic, the version, the capacity, the writer process id
+ *              and the time of the last publication is followed by the append-only entries of the sites. The entry is published by the release store of the site count
+ *              after its static fields are written, the counters are relaxed atomics.
+ *             The segment is removed when the publishing stops. The segment of the name left by the crashed
+ *              process is replaced, the segment of the running process is not.
+ *
+ * @example    dbgh-top /server.stats
+ *
+ * @note       Available on Linux.
+ */
+class CStatsSegment
+{
+public:
+
+    /**
+     * @internal
+     * @brief      The maximum count of the site entries of the segment.
+     */
+    static constexpr std::uint32_t Capacity = 4096;
+
+    /**
+     * @internal
+     * @brief      The maximum length of the stored file path, the longer paths keep their tail.
+     */
+    static constexpr std::size_t MaxFileLength = 127;
+
+    /**
+     * @internal
+     * @brief      The maximum length of the stored expression, the longer expressions keep their head.
+     */
+    static constexpr std::size_t MaxExpressionLength = 95;
+
+    /**
+     * @internal
+     * @brief      Creates the segment, publishes the counters and starts publishing them periodically.
+     *
+     * @throw      std::system_error exception if the segment cannot be created or mapped, or if the segment of the
+     *              name is published by the running process (EEXIST).
+     *
+     * @param[in]  name    The name of the segment, "/" is prepended if missing. The segment left by the crashed
+     *                     process is replaced.
+     * @param[in]  period  The period of the publication.
+     */
+    CStatsSegment(std::string name, std::chrono::milliseconds period);
+
+    /**
+     * @internal
+     * @brief      Stops publishing, unmaps and removes the segment.
+     */
+    ~CStatsSegment();
+
+    CStatsSegment(CStatsSegment&&) = delete;
+
+    CStatsSegment(const CStatsSegment&) = delete;
+
+    CStatsSegment& operator=(CStatsSegment&&) = delete;
+
+    CStatsSegment& operator=(const CStatsSegment&) = delete;
+
+    /**
+     * @internal
+     * @brief      Copies the counters of all sites to the segment.
+     */
+    void Publish();
+
+    /**
+     * @internal
+     * @brief      Reads the segment of the process.
+     *
+     * @throw      std::system_error exception if the segment cannot be opened or mapped.
+     * @throw      std::runtime_error exception if the segment is not a stats segment of this version.
+     *
+     * @param[in]  name  The name of the segment.
+     *
+     * @return     The content of the segment.
+     */
+    [[nodiscard]] static SStatsSnapshot Read(const std::string& name);
+
+private:
+
+    /**
+     * @internal
+     * @brief      The loop of the background thread.
+     */
+    void workerLoop(std::stop_token stopToken);
+
+private:
+
+    /**
+     * @internal
+     * @brief      The name of the segment.
+     */
+    const std::string m_strName;
+
+    /**
+     * @internal
+     * @brief      The period of the publication.
+     */
+    const std::chrono::milliseconds m_period;
+
+    /**
+     * @internal
+     * @brief      The mapped segment.
+     */
+    SStatsBlock* m_pBlock;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the publication.
+     */
+    std::mutex m_mtxPublish;
+
+    /**
+     * @internal
+     * @brief      The entry indexes of the published sites.
+     */
+    std::unordered_map<const SAssertSite*, std::uint32_t> m_mapEntries;
+
+    /**
+     * @internal
+     * @brief      Wakes the background thread on stop.
+     */
+    std::condition_variable_any m_cvWorker;
+
+    /**
+     * @internal
+     * @brief      The background thread, declared last to be stopped before the other members are destroyed.
+     */
+    std::jthread m_worker;
+
+}; // class CStatsSegment
+
+} // namespace dbgh::impl
@@ -0,0 +1,177 @@
+/**
+ * @file        CWritevSink.cpp
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Implementation for CWritevSink class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#include <unistd.h>
+
+#include "CWritevSink.h"
+
+namespace dbgh
+{
+
+namespace
+{
+/**
+ * @internal
+ * @brief      The line terminator appended to every report, the same as CHandlerExecutor::Logs does.
+ */
+char s_chLineTerminator = '\n';
+
+/**
+ * @internal
+ * @brief      The maximum count of the buffers in one writev call.
+ */
+constexpr std::size_t s_uMaxIovecs = IOV_MAX;
+}  // unnamed namespace
+
+CWritevSink::CWritevSink(
+        const int fd,
+        const std::size_t maxBatchReports,
+        const std::size_t maxBatchBytes,
+        const std::chrono::milliseconds maxAge)
+        : m_iFd { fd },
+        m_uMaxBatchReports { std::clamp<std::size_t>(maxBatchReports, 1, s_uMaxIovecs / 2) },
+        m_maxAge { maxAge },
+        m_vecBuffer(std::max<std::size_t>(maxBatchBytes, 1)),
+        m_uBufferUsed { 0 },
+        m_oldestReport { },
+        m_uSyscallCount { 0 }
+{
+    m_vecIovecs.reserve(m_uMaxBatchReports * 2);
+    if (m_maxAge.count() > 0)
+    {
+        m_flusher = std::jthread { [this](std::stop_token stopToken) { flusherLoop(std::move(stopToken)); } };
+    }
+}
+
+CWritevSink::~CWritevSink()
+{
+    if (m_flusher.joinable())
+    {
+        m_flusher.request_stop();
+        m_flusher.join();
+    }
+    Flush();
+}
+
+void CWritevSink::Write(const EAssertLevel level, std::string_view report)
+{
+    std::lock_guard lock { m_mtxBatch };
+
+    if (m_uBufferUsed + report.size() > m_vecBuffer.size() || m_vecIovecs.size() / 2 >= m_uMaxBatchReports)
+    {
+        flushLocked();
+    }
+
+    if (report.size() > m_vecBuffer.size())
+    {
+        // Too big for the batch buffer, written directly.
+        iovec arrIovecs[2] {
+                { const_cast<char*>(report.data()), report.size() },
+                { &s_chLineTerminator, 1 } };
+        writeAll(arrIovecs, 2);
+        return;
+    }
+
+    if (m_vecIovecs.empty())
+    {
+        m_oldestReport = std::chrono::steady_clock::now();
+        m_cvBatchStarted.notify_one();
+    }
+
+    char* pReport = m_vecBuffer.data() + m_uBufferUsed;
+    std::memcpy(pReport, report.data(), report.size());
+    m_uBufferUsed += report.size();
+    m_vecIovecs.push_back({ pReport, report.size() });
+    m_vecIovecs.push_back({ &s_chLineTerminator, 1 });
+
+    if (EAssertLevel::Fatal == level)
+    {
+        flushLocked();
+    }
+}
+
+void CWritevSink::Flush()
+{
+    std::lock_guard lock { m_mtxBatch };
+    flushLocked();
+}
+
+std::size_t CWritevSink::SyscallCount() const noexcept
+{
+    return m_uSyscallCount.load(std::memory_order_relaxed);
+}
+
+void CWritevSink::flushLocked()
+{
+    if (m_vecIovecs.empty())
+    {
+        return;
+    }
+    writeAll(m_vecIovecs.data(), m_vecIovecs.size());
+    m_vecIovecs.clear();
+    m_uBufferUsed = 0;
+}
+
+void CWritevSink::writeAll(iovec* pIovecs, std::size_t count)
+{
+    while (0 != count)
+    {
+        m_uSyscallCount.fetch_add(1, std::memory_order_relaxed);
+        auto written = ::writev(m_iFd, pIovecs, static_cast<int>(count));
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            // The reports are dropped, there is no better place to report the failure of the assertion log.
+            return;
+        }
+
+        auto uWritten = static_cast<std::size_t>(written);
+        while (0 != count && uWritten >= pIovecs->iov_len)
+        {
+            uWritten -= pIovecs->iov_len;
+            ++pIovecs;
+            --count;
+        }
+        if (0 != count)
+        {
+            pIovecs->iov_base = static_cast<char*>(pIovecs->iov_base) + uWritten;
+            pIovecs->iov_len -= uWritten;
+        }
+    }
+}
+
+void CWritevSink::flusherLoop(std::stop_token stopToken)
+{
+    std::unique_lock lock { m_mtxBatch };
+    while (! stopToken.stop_requested())
+    {
+        if (m_vecIovecs.empty())
+        {
+            m_cvBatchStarted.wait(lock, stopToken, [this] { return ! m_vecIovecs.empty(); });
+            continue;
+        }
+
+        const auto deadline = m_oldestReport + m_maxAge;
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            flushLocked();
+            continue;
+        }
+        m_cvBatchStarted.wait_until(lock, stopToken, deadline, [] { return false; });
+    }
+}
+
+} // namespace dbgh
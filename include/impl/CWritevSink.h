@@ -0,0 +1,182 @@
+/**
+ * @file        CWritevSink.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for CWritevSink class.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include "CAssertSink.h"
+
+namespace dbgh
+{
+
+/**
+ * @class       CWritevSink
+ * @brief       The sink which collects the reports into batches and writes every batch with a single writev(2).
+ *
+ * @details     The reports are copied into a preallocated buffer and described by an iovec array. The batch is
+ *               written when it reaches the report count or the byte size limit, when the oldest report reaches the
+ *               age limit, and immediately after a Fatal report. During an assertion storm this replaces one
+ *               write and flush per report with one system call per batch.
+ *             The age limit is enforced by a background thread, it is not started if the age limit is zero.
+ *
+ * @note       Available on POSIX platforms.
+ *
+ * @example     auto router = std::make_unique<dbgh::CAssertRouter>();
+ *              auto sink = std::make_shared<dbgh::CWritevSink>(STDERR_FILENO);
+ *              router->Subscribe(dbgh::EAssertLevel::Warning, sink);
+ *              router->Subscribe(dbgh::EAssertLevel::Fatal, sink);
+ *              dbgh::CAssertConfig::Get().SetExecutor(std::move(router));
+ */
+class CWritevSink : public CAssertSink
+{
+public:
+
+    /**
+     * @brief      Constructs the sink.
+     *
+     * @param[in]  fd               The file descriptor, the sink does not own it.
+     * @param[in]  maxBatchReports  The maximum count of the reports in one batch, limited by IOV_MAX.
+     * @param[in]  maxBatchBytes    The size of the batch buffer, the bigger reports are written unbatched.
+     * @param[in]  maxAge           The maximum time a report waits in the batch, zero disables the age limit.
+     */
+    explicit CWritevSink(
+            int fd,
+            std::size_t maxBatchReports = 256,
+            std::size_t maxBatchBytes = 64 * 1024,
+            std::chrono::milliseconds maxAge = std::chrono::milliseconds { 100 });
+
+    /**
+     * @brief      Stops the background thread and writes the pending batch.
+     */
+    ~CWritevSink() override;
+
+    /**
+     * @brief      Appends the report to the current batch.
+     *
+     * @param[in]  level   The level of the failed assertion, the Fatal report flushes the batch.
+     * @param[in]  report  The formatted report.
+     */
+    void Write(EAssertLevel level, std::string_view report) override;
+
+    /**
+     * @brief      Writes the pending batch.
+     */
+    void Flush() override;
+
+    /**
+     * @brief      Gets the count of the writev calls made by the sink.
+     *
+     * @return     The count of the system calls.
+     */
+    [[nodiscard]] std::size_t SyscallCount() const noexcept;
+
+private:
+
+    /**
+     * @internal
+     * @brief      Writes the pending batch, must be called under m_mtxBatch.
+     */
+    void flushLocked();
+
+    /**
+     * @internal
+     * @brief      Writes all given buffers, retries on partial writes and EINTR.
+     *
+     * @param[in]  pIovecs  The buffers.
+     * @param[in]  count    The count of the buffers.
+     */
+    void writeAll(iovec* pIovecs, std::size_t count);
+
+    /**
+     * @internal
+     * @brief      The loop of the background thread which enforces the age limit.
+     *
+     * @param[in]  stopToken  The stop token of the thread.
+     */
+    void flusherLoop(std::stop_token stopToken);
+
+private:
+
+    /**
+     * @internal
+     * @brief      The file descriptor.
+     */
+    const int m_iFd;
+
+    /**
+     * @internal
+     * @brief      The maximum count of the reports in one batch.
+     */
+    const std::size_t m_uMaxBatchReports;
+
+    /**
+     * @internal
+     * @brief      The maximum time a report waits in the batch.
+     */
+    const std::chrono::milliseconds m_maxAge;
+
+    /**
+     * @internal
+     * @brief      The mutex protecting the batch.
+     */
+    std::mutex m_mtxBatch;
+
+    /**
+     * @internal
+     * @brief      Wakes the background thread when the first report of a batch is added.
+     */
+    std::condition_variable_any m_cvBatchStarted;
+
+    /**
+     * @internal
+     * @brief      The preallocated buffer for the reports of the batch, never reallocated.
+     */
+    std::vector<char> m_vecBuffer;
+
+    /**
+     * @internal
+     * @brief      The used size of the buffer.
+     */
+    std::size_t m_uBufferUsed;
+
+    /**
+     * @internal
+     * @brief      The buffers of the batch, the report and the line terminator for every report.
+     */
+    std::vector<iovec> m_vecIovecs;
+
+    /**
+     * @internal
+     * @brief      The time of the oldest report in the batch.
+     */
+    std::chrono::steady_clock::time_point m_oldestReport;
+
+    /**
+     * @internal
+     * @brief      The count of the writev calls.
+     */
+    std::atomic<std::size_t> m_uSyscallCount;
+
+    /**
+     * @internal
+     * @brief      The background thread, declared last to be stopped before the other members are destroyed.
+     */
+    std::jthread m_flusher;
+
+}; // class CWritevSink
+
+} // namespace dbgh
@@ -0,0 +1,184 @@
+/**
+ * @file        EAssertLevel.h
+ * @author      Argishti Ayvazyan (ayvazyan.argishti@gmail.com)
+ * @brief       Declaration for EAssertLevel enum.
+ * @date        16-10-2026
+ * @copyright   Copyright (c) 2020
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dbgh
+{
+
+/**
+ * @enum       EAssertLevel
+ * @brief      The described types for assertions.
+ */
+enum class EAssertLevel : size_t
+{
+    /**
+     * @brief   The enum value mapped to \ref ASSERT_WARNING assert.
+     */
+    Warning,
+
+    /**
+     * @brief   The enum value mapped to \ref ASSERT_DEBUG assert.
+     */
+    Debug,
+
+    /**
+     * @brief   The enum value mapped to \ref ASSERT_ERROR assert.
+     */
+    Error,
+
+    /**
+     * @brief   The enum value mapped to \ref ASSERT_FATAL assert.
+     */
+    Fatal,
+
+    /**
+     * @internal
+     * @breaf   An enumeration value that indicates the end of the enumeration.
+     */
+    END_ENUM_
+};
+
+/**
+ * @brief      Gets the bit of the level in the level masks.
+ *
+ * @param[in]  level  The level.
+ *
+ * @return     The mask with the single bit of the level.
+ */
+[[nodiscard]] constexpr std::uint32_t LevelMask(const EAssertLevel level) noexcept
+{
+    return std::uint32_t { 1 } << static_cast<std::uint32_t>(level);
+}
+
+/**
+ * @brief      The mask with the bits of all levels.
+ */
+constexpr std::uint32_t AllLevelsMask = LevelMask(EAssertLevel::END_ENUM_) - 1;
+
+/**
+ * @brief      The count of the bits of one level in the enable word: the categories and the override bit.
+ */
+constexpr std::uint32_t BitsPerLevel = 16;
+
+/**
+ * @brief      The maximum count of the assert categories, see \ref SAssertCategory.
+ */
+constexpr std::uint32_t MaxCategories = BitsPerLevel - 1;
+
+/**
+ * @brief      The mask with the bits of all categories.
+ */
+constexpr std::uint32_t AllCategoriesMask = (std::uint32_t { 1 } << MaxCategories) - 1;
+
+/**
+ * @brief      Gets the bit of the level and the category in the enable word.
+ *
+ * @details    The enable word has \ref BitsPerLevel bits per level, the bit of the category of the level is set if
+ *              the asserts of the level and the category are enabled. The last bit of the level is its override bit,
+ *              see \ref OverrideBit.
+ *
+ * @param[in]  level     The level.
+ * @param[in]  category  The index of the category.
+ *
+ * @return     The word with the single bit.
+ */
+[[nodiscard]] constexpr std::uint64_t EnableBit(const EAssertLevel level, const std::uint32_t category) noexcept
+{
+    return std::uint64_t { 1 } << (static_cast<std::uint32_t>(level) * BitsPerLevel + category);
+}
+
+/**
+ * @brief      Gets the override bit of the level in the enable word.
+ *
+ * @details    The override bit is set while a site rule may enable a site of the level whose category is disabled,
+ *              see \ref CSiteRules. The site of the level passes the enable word by the override bit, then it is
+ *              evaluated only if the rule enables it, see \ref CAssertProbe.
+ *
+ * @param[in]  level  The level.
+ *
+ * @return     The word with the single bit.
+ */
+[[nodiscard]] constexpr std::uint64_t OverrideBit(const EAssertLevel level) noexcept
+{
+    return std::uint64_t { 1 } << (static_cast<std::uint32_t>(level) * BitsPerLevel + MaxCategories);
+}
+
+/**
+ * @brief      Gets the bits of the categories of the level in the enable word.
+ *
+ * @param[in]  level       The level.
+ * @param[in]  categories  The mask of the categories.
+ *
+ * @return     The word with the bits of the categories of the level.
+ */
+[[nodiscard]] constexpr std::uint64_t LevelBits(
+        const EAssertLevel level, const std::uint32_t categories = AllCategoriesMask) noexcept
+{
+    return std::uint64_t { categories & AllCategoriesMask } << (static_cast<std::uint32_t>(level) * BitsPerLevel);
+}
+
+/**
+ * @brief      Gets the mask of the categories of the level from the enable word.
+ *
+ * @param[in]  word   The enable word.
+ * @param[in]  level  The level.
+ *
+ * @return     The mask of the categories.
+ */
+[[nodiscard]] constexpr std::uint32_t CategoriesOf(const std::uint64_t word, const EAssertLevel level) noexcept
+{
+    return static_cast<std::uint32_t>(word >> (static_cast<std::uint32_t>(level) * BitsPerLevel)) & AllCategoriesMask;
+}
+
+/**
+ * @brief      Gets the enable word with all categories of the levels of the mask.
+ *
+ * @param[in]  levels  The mask of the levels, see \ref LevelMask.
+ *
+ * @return     The enable word.
+ */
+[[nodiscard]] constexpr std::uint64_t EnableWordOf(const std::uint32_t levels) noexcept
+{
+    std::uint64_t uWord = 0;
+    for (std::uint32_t uLevel = 0; uLevel < static_cast<std::uint32_t>(EAssertLevel::END_ENUM_); ++uLevel)
+    {
+        if (0 != (levels & (std::uint32_t { 1 } << uLevel)))
+        {
+            uWord |= LevelBits(static_cast<EAssertLevel>(uLevel));
+        }
+    }
+    return uWord;
+}
+
+/**
+ * @brief      Gets the word with the override bits of the levels of the mask.
+ *
+ * @param[in]  levels  The mask of the levels, see \ref LevelMask.
+ *
+ * @return     The word with the override bits.
+ */
+[[nodiscard]] constexpr std::uint64_t OverrideWordOf(const std::uint32_t levels) noexcept
+{
+    std::uint64_t uWord = 0;
+    for (std::uint32_t uLevel = 0; uLevel < static_cast<std::uint32_t>(EAssertLevel::END_ENUM_); ++uLevel)
+    {
+        if (0 != (levels & (std::uint32_t { 1 } << uLevel)))
+        {
+            uWord |= OverrideBit(static_cast<EAssertLevel>(uLevel));
+        }
+    }
+    return uWord;
+}
+
+static_assert(static_cast<std::uint32_t>(EAssertLevel::END_ENUM_) * BitsPerLevel <= 64, "The enable word is 64 bits.");
+
+} // namespace dbgh
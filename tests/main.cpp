@@ -1,10 +1,47 @@
+#include <algorithm>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 #include "DBGHAssert.h"
+#include "impl/CWritevSink.h"
+#include "impl/CIoUringSink.h"
+#include "impl/CRotatingFileSink.h"
+#include "impl/CCaptureClock.h"
+#include "impl/CAssertProfiler.h"
+#include "impl/CConfigParser.h"
+#include "impl/CControlServer.h"
+#include "impl/CSharedControl.h"
+#include "impl/CReportBackoff.h"
+#include "impl/CMessageSketches.h"
+#include "impl/CStatsSegment.h"
 
 namespace
 {
 
+DBGH_ASSERT_CATEGORY(Storage, 1);
+DBGH_ASSERT_CATEGORY(Network, 2);
+
+// Runs the test binary as a child which only constructs the config, see main.
+constexpr const char* s_pszGetConfigOption = "--get-config";
+
 class DummyExecutor : public dbgh::CHandlerExecutor
 {
 public:
@@ -50,6 +87,136 @@ public:
     static inline std::string s_strMessage{};
 };
 
+class StaticExecutor final
+{
+public:
+    void Terminate(std::string_view message)
+    {
+        Logs(message);
+        s_bTerminateCalled = true;
+    }
+
+    void HandleWarning(std::string_view message)
+    {
+        Logs(message);
+        s_bHandleWarningCalled = true;
+    }
+
+    void HandleError(std::string_view message, [[maybe_unused]] const dbgh::CAssertException& exception)
+    {
+        Logs(message);
+        s_bHandleErrorCalled = true;
+    }
+
+    void Logs(std::string_view message)
+    {
+        s_strMessage = message;
+    }
+
+    void ShowMessage(std::string_view message)
+    {
+        Logs(message);
+    }
+
+    char GetUserInput()
+    {
+        return 'i';
+    }
+
+    void DebugPreCall()
+    {
+    }
+
+    static inline bool s_bTerminateCalled = false;
+    static inline bool s_bHandleWarningCalled = false;
+    static inline bool s_bHandleErrorCalled = false;
+    static inline std::string s_strMessage{};
+};
+
+class CountingSink : public dbgh::CAssertSink
+{
+public:
+    void Write([[maybe_unused]] dbgh::EAssertLevel level, std::string_view report) override
+    {
+        ++m_iWriteCount;
+        m_strLastReport = report;
+    }
+
+    int m_iWriteCount = 0;
+    std::string m_strLastReport{};
+};
+
+class SummaryExecutor : public dbgh::CHandlerExecutor
+{
+public:
+    void HandleWarning(std::string_view message) override
+    {
+        std::lock_guard lock { m_mtx };
+        if (std::string_view::npos != message.find("times in the last")
+            || std::string_view::npos != message.find("assertion storm"))
+        {
+            ++m_iSummaries;
+            m_strLastSummary = message;
+        }
+        else
+        {
+            ++m_iReports;
+        }
+    }
+
+    std::mutex m_mtx;
+    int m_iReports = 0;
+    int m_iSummaries = 0;
+    std::string m_strLastSummary{};
+};
+
+class ReentrantExecutor : public dbgh::CHandlerExecutor
+{
+public:
+    void HandleWarning(std::string_view message) override
+    {
+        if (0 == s_iDepth)
+        {
+            ++s_iDepth;
+            ASSERT_WARNING(2 + 2 == 5, "inner");
+            --s_iDepth;
+            s_strOuter = message;
+        }
+        else
+        {
+            s_strInner = message;
+        }
+    }
+
+    static inline int s_iDepth = 0;
+    static inline std::string s_strOuter{};
+    static inline std::string s_strInner{};
+};
+
+class ScriptedRouter : public dbgh::CAssertRouter
+{
+public:
+    void ShowMessage([[maybe_unused]] std::string_view message) override
+    {
+    }
+
+    char GetUserInput() override
+    {
+        return 'i';
+    }
+};
+
+struct SFormatCounter
+{
+    operator std::string_view() const
+    {
+        ++s_iFormatCount;
+        return "counted";
+    }
+
+    static inline int s_iFormatCount = 0;
+};
+
 }
 
 #define TEST_ASSERT(exp) if (!bool(exp))            \
@@ -202,13 +369,1734 @@ void TestTextFormating()
     std::cout << "End text format testing." << std::endl;
 }
 
-int main()
+void TestBasicAsserts()
+{
+    std::cout << "Start basic asserts testing." << std::endl;
+    using TStaticAsserts = dbgh::CBasicAsserts<StaticExecutor>;
+
+    TStaticAsserts::HandleAssert<dbgh::EAssertLevel::Warning>(
+            dbgh::CCaptureClock::Capture(), std::string { "_Warning" }, "2 * 3 == 4", __FILE__, __LINE__, __func__);
+    TEST_ASSERT(StaticExecutor::s_bHandleWarningCalled == true);
+    TEST_ASSERT(StaticExecutor::s_strMessage.find("_Warning") != std::string::npos);
+
+    TStaticAsserts::HandleAssert<dbgh::EAssertLevel::Error>(
+            dbgh::CCaptureClock::Capture(), std::string { "_Error" }, "2 * 3 == 4", __FILE__, __LINE__, __func__);
+    TEST_ASSERT(StaticExecutor::s_bHandleErrorCalled == true);
+
+    TStaticAsserts::HandleAssert<dbgh::EAssertLevel::Fatal>(
+            dbgh::CCaptureClock::Capture(), std::string { "_Fatal" }, "2 * 3 == 4", __FILE__, __LINE__, __func__);
+    TEST_ASSERT(StaticExecutor::s_bTerminateCalled == true);
+
+    bool ignore = false;
+    TStaticAsserts::HandleAssert<dbgh::EAssertLevel::Debug>(
+            dbgh::CCaptureClock::Capture(), std::string { "_Debug" }, "2 * 3 == 4", __FILE__, __LINE__, __func__, ignore);
+    TEST_ASSERT(ignore == false);
+
+    std::cout << "End basic asserts testing." << std::endl << std::endl;
+}
+
+void TestAssertRouter()
+{
+    std::cout << "Start assert router testing." << std::endl;
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Warning);
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Error);
+
+    auto firstSink = std::make_shared<CountingSink>();
+    auto secondSink = std::make_shared<CountingSink>();
+    auto router = std::make_unique<dbgh::CAssertRouter>();
+    router->Subscribe(dbgh::EAssertLevel::Warning, firstSink);
+    router->Subscribe(dbgh::EAssertLevel::Warning, secondSink);
+    router->Subscribe(dbgh::EAssertLevel::Error, secondSink);
+    TEST_ASSERT(router->HasSubscribers(dbgh::EAssertLevel::Warning) == true);
+    TEST_ASSERT(router->HasSubscribers(dbgh::EAssertLevel::Fatal) == false);
+    auto* pRouter = router.get();
+    dbgh::CAssertConfig::Get().SetExecutor(std::move(router));
+
+    ASSERT_WARNING(2 * 3 == 4, "_Routed");
+    TEST_ASSERT(firstSink->m_iWriteCount == 1 && secondSink->m_iWriteCount == 1);
+    TEST_ASSERT(firstSink->m_strLastReport == secondSink->m_strLastReport);
+
+    try
+    {
+        ASSERT_ERROR(2 * 3 == 4, "_Routed");
+        TEST_ASSERT(false);
+    }
+    catch ([[maybe_unused]] const dbgh::CAssertException& e)
+    {
+        TEST_ASSERT(firstSink->m_iWriteCount == 1 && secondSink->m_iWriteCount == 2);
+    }
+
+    pRouter->Unsubscribe(dbgh::EAssertLevel::Warning, firstSink.get());
+    ASSERT_WARNING(2 * 3 == 4, "_Routed");
+    TEST_ASSERT(firstSink->m_iWriteCount == 1 && secondSink->m_iWriteCount == 3);
+
+    pRouter->Unsubscribe(dbgh::EAssertLevel::Warning, secondSink.get());
+    TEST_ASSERT(pRouter->IsReported(dbgh::EAssertLevel::Warning) == false);
+    {
+        const SFormatCounter counter;
+        dbgh::CScopedContext context { "counter", counter };
+        ASSERT_WARNING(2 * 3 == 4, "_Routed {}", std::string_view { counter });
+        TEST_ASSERT(SFormatCounter::s_iFormatCount == 0);
+        TEST_ASSERT(firstSink->m_iWriteCount == 1 && secondSink->m_iWriteCount == 3);
+
+        pRouter->Subscribe(dbgh::EAssertLevel::Warning, firstSink);
+        ASSERT_WARNING(2 * 3 == 4, "_Routed");
+        TEST_ASSERT(SFormatCounter::s_iFormatCount == 1 && firstSink->m_iWriteCount == 2);
+    }
+
+    auto debugSink = std::make_shared<CountingSink>();
+    auto debugRouter = std::make_unique<ScriptedRouter>();
+    debugRouter->Subscribe(dbgh::EAssertLevel::Debug, debugSink);
+    dbgh::CAssertConfig::Get().SetExecutor(std::move(debugRouter));
+    const auto bDebugActive = dbgh::CAssertConfig::Get().IsActiveAssert(dbgh::EAssertLevel::Debug);
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Debug);
+    ASSERT_DEBUG(2 * 3 == 4, "_Routed");
+    TEST_ASSERT(debugSink->m_iWriteCount == 1);
+    TEST_ASSERT(debugSink->m_strLastReport.starts_with("DEBUG ASSERT:"));
+    if (! bDebugActive)
+    {
+        dbgh::CAssertConfig::Get().DisableAsserts(dbgh::EAssertLevel::Debug);
+    }
+
+    std::cout << "End assert router testing." << std::endl << std::endl;
+
+    dbgh::CAssertConfig::Get().SetExecutor();
+}
+
+int s_iFilterCallCount = 0;
+
+dbgh::EFilterVerdict RejectLineFilter(const dbgh::SAssertSite& site, [[maybe_unused]] const dbgh::SThreadContext& context)
+{
+    ++s_iFilterCallCount;
+    return std::string_view { site.expression }.find("213") != std::string_view::npos
+            ? dbgh::EFilterVerdict::RejectForever
+            : dbgh::EFilterVerdict::Accept;
+}
+
+void TestAssertFilter()
+{
+    std::cout << "Start assert filter testing." << std::endl;
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Warning);
+    dbgh::CAssertConfig::Get().SetExecutor(std::make_unique<DummyExecutor>());
+    dbgh::CAssertConfig::Get().SetFilter(RejectLineFilter);
+
+    constexpr int testCount = 10;
+
+    DummyExecutor::s_bHandleWarningCalled = false;
+    for (int i = 0; i < testCount; ++i)
+    {
+        ASSERT_WARNING(2 * 3 == 213, "FAIL");
+    }
+    TEST_ASSERT(DummyExecutor::s_bHandleWarningCalled == false);
+    TEST_ASSERT(s_iFilterCallCount == 1);
+
+    for (int i = 0; i < testCount; ++i)
+    {
+        ASSERT_WARNING(2 * 3 == 4, "FAIL");
+    }
+    TEST_ASSERT(DummyExecutor::s_bHandleWarningCalled == true);
+    TEST_ASSERT(s_iFilterCallCount == 1 + testCount);
+
+    dbgh::CAssertConfig::Get().SetFilter();
+    DummyExecutor::s_bHandleWarningCalled = false;
+    ASSERT_WARNING(2 * 3 == 213, "FAIL");
+    TEST_ASSERT(DummyExecutor::s_bHandleWarningCalled == true);
+
+    std::cout << "End assert filter testing." << std::endl << std::endl;
+
+    dbgh::CAssertConfig::Get().SetExecutor();
+}
+
+void TestWritevSink()
+{
+    std::cout << "Start writev sink testing." << std::endl;
+
+    int arrPipe[2] {};
+    TEST_ASSERT(::pipe(arrPipe) == 0);
+
+    constexpr int reportCount = 10;
+    {
+        dbgh::CWritevSink sink { arrPipe[1], 4, 1024, std::chrono::milliseconds { 0 } };
+        for (int i = 0; i < reportCount; ++i)
+        {
+            sink.Write(dbgh::EAssertLevel::Warning, "report");
+        }
+        TEST_ASSERT(sink.SyscallCount() == 2);
+        sink.Write(dbgh::EAssertLevel::Fatal, "fatal");
+        TEST_ASSERT(sink.SyscallCount() == 3);
+    }
+    ::close(arrPipe[1]);
+
+    std::string strOutput;
+    char arrBuffer[256] {};
+    for (auto read = ::read(arrPipe[0], arrBuffer, sizeof(arrBuffer)); read > 0;
+         read = ::read(arrPipe[0], arrBuffer, sizeof(arrBuffer)))
+    {
+        strOutput.append(arrBuffer, static_cast<size_t>(read));
+    }
+    ::close(arrPipe[0]);
+    const auto expectedSize = reportCount * std::string_view { "report\n" }.size() + std::string_view { "fatal\n" }.size();
+    TEST_ASSERT(strOutput.size() == expectedSize);
+
+    std::cout << "End writev sink testing." << std::endl << std::endl;
+}
+
+void TestIoUringSink()
+{
+    std::cout << "Start io_uring sink testing." << std::endl;
+
+    auto* pFile = std::tmpfile();
+    TEST_ASSERT(nullptr != pFile);
+    const int fd = ::fileno(pFile);
+
+    constexpr int reportCount = 100;
+    {
+        dbgh::CIoUringSink sink { fd, 2, 64 };
+        for (int i = 0; i < reportCount; ++i)
+        {
+            sink.Write(dbgh::EAssertLevel::Warning, "report");
+        }
+        // One submission carries the reports of a full buffer, the fallback writes every report.
+        TEST_ASSERT(sink.SyscallCount() < (sink.IsUringActive() ? reportCount / 4 : reportCount + 1));
+        sink.Write(dbgh::EAssertLevel::Warning, std::string(100, 'x'));
+        sink.Write(dbgh::EAssertLevel::Fatal, "fatal");
+    }
+
+    std::string strOutput;
+    char arrBuffer[256] {};
+    for (auto read = ::pread(fd, arrBuffer, sizeof(arrBuffer), static_cast<off_t>(strOutput.size())); read > 0;
+         read = ::pread(fd, arrBuffer, sizeof(arrBuffer), static_cast<off_t>(strOutput.size())))
+    {
+        strOutput.append(arrBuffer, static_cast<size_t>(read));
+    }
+    std::fclose(pFile);
+
+    std::string strExpected;
+    for (int i = 0; i < reportCount; ++i)
+    {
+        strExpected += "report\n";
+    }
+    strExpected += std::string(100, 'x') + "\nfatal\n";
+    TEST_ASSERT(strOutput == strExpected);
+
+    int arrPipe[2] {};
+    TEST_ASSERT(::pipe(arrPipe) == 0);
+    {
+        dbgh::CIoUringSink sink { arrPipe[1], 2, 64, std::chrono::milliseconds { 10 } };
+        sink.Write(dbgh::EAssertLevel::Warning, "aged");
+        sink.Write(dbgh::EAssertLevel::Warning, "aged");
+        // The batch is submitted by the age limit, without Flush.
+        strOutput.clear();
+        while (strOutput.size() < 10)
+        {
+            const auto read = ::read(arrPipe[0], arrBuffer, sizeof(arrBuffer));
+            if (read <= 0)
+            {
+                break;
+            }
+            strOutput.append(arrBuffer, static_cast<size_t>(read));
+        }
+        TEST_ASSERT(strOutput == "aged\naged\n");
+    }
+    ::close(arrPipe[0]);
+    ::close(arrPipe[1]);
+
+    std::cout << "End io_uring sink testing." << std::endl << std::endl;
+}
+
+void TestJsonReportFormat()
+{
+    std::cout << "Start JSON report format testing." << std::endl;
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Warning);
+    dbgh::CAssertConfig::Get().SetExecutor(std::make_unique<DummyExecutor>());
+    dbgh::CAssertConfig::Get().SetReportFormat(dbgh::EReportFormat::JsonLines);
+
+    ASSERT_WARNING(2 * 3 == 4, "_Text \"{}\"\n\t\\{}", 121, '\x01');
+    const auto& report = DummyExecutor::s_strMessage;
+    TEST_ASSERT(report.front() == '{' && report.back() == '}');
+    TEST_ASSERT(report.find('\n') == std::string::npos);
+    TEST_ASSERT(report.find(R"("level":"WARNING")") != std::string::npos);
+    TEST_ASSERT(report.find(R"("expression":"2 * 3 == 4")") != std::string::npos);
+    TEST_ASSERT(report.find(R"("message":"_Text \"121\"\n\t\\\u0001")") != std::string::npos);
+
+    dbgh::CAssertConfig::Get().SetReportFormat(dbgh::EReportFormat::Text);
+    std::cout << "End JSON report format testing." << std::endl << std::endl;
+
+    dbgh::CAssertConfig::Get().SetExecutor();
+}
+
+void TestReentrantReport()
+{
+    std::cout << "Start reentrant report testing." << std::endl;
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Warning);
+    dbgh::CAssertConfig::Get().SetExecutor(std::make_unique<ReentrantExecutor>());
+
+    ASSERT_WARNING(2 + 2 == 5, "outer");
+    TEST_ASSERT(ReentrantExecutor::s_strInner.find("[what]:         inner") != std::string::npos);
+    TEST_ASSERT(ReentrantExecutor::s_strOuter.find("[what]:         outer") != std::string::npos);
+    TEST_ASSERT(ReentrantExecutor::s_strOuter.find("inner") == std::string::npos);
+
+    dbgh::CAssertConfig::Get().SetExecutor();
+    std::cout << "End reentrant report testing." << std::endl << std::endl;
+}
+
+void TestRotatingFileSink()
+{
+    std::cout << "Start rotating file sink testing." << std::endl;
+
+    const auto directory = std::filesystem::temp_directory_path() / "dbgh_rotating_sink_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const auto basePath = (directory / "asserts.log").string();
+
+    constexpr int reportCount = 1000;
+    std::string strExpected;
+    {
+        dbgh::CRotatingFileSink sink { basePath, 4096, std::chrono::seconds { 0 }, 0 };
+        for (int i = 0; i < reportCount; ++i)
+        {
+            const auto report = "report " + std::to_string(i);
+            sink.Write(dbgh::EAssertLevel::Warning, report);
+            strExpected += report + '\n';
+        }
+    }
+
+    std::string strOutput;
+    int segmentCount = 0;
+    for (auto sequence = 1;; ++sequence)
+    {
+        std::ifstream segment { basePath + '.' + std::to_string(sequence), std::ios::binary };
+        if (! segment)
+        {
+            break;
+        }
+        ++segmentCount;
+        std::stringstream ss;
+        ss << segment.rdbuf();
+        strOutput += ss.str();
+    }
+    TEST_ASSERT(segmentCount > 1);
+    TEST_ASSERT(strOutput == strExpected);
+
+    std::filesystem::remove_all(directory);
+    std::cout << "End rotating file sink testing." << std::endl << std::endl;
+}
+
+void TestCaptureClock()
+{
+    std::cout << "Start capture clock testing." << std::endl;
+
+    const auto first = dbgh::CCaptureClock::Capture();
+    const auto second = dbgh::CCaptureClock::Capture();
+    TEST_ASSERT(first.ticks <= second.ticks);
+    TEST_ASSERT(first.threadId == second.threadId);
+
+    std::uint32_t uOtherThreadId = first.threadId;
+    std::thread { [&uOtherThreadId] { uOtherThreadId = dbgh::CCaptureClock::Capture().threadId; } }.join();
+    TEST_ASSERT(uOtherThreadId != first.threadId);
+
+    const auto drift = std::chrono::system_clock::now() - dbgh::CCaptureClock::ToSystemTime(second.ticks);
+    TEST_ASSERT(drift > -std::chrono::seconds { 1 } && drift < std::chrono::seconds { 1 });
+
+    // The short intervals are measurable, the budget governor and the profiler depend on it.
+    const auto uStartTicks = dbgh::CCaptureClock::Ticks();
+    const auto steadyStart = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - steadyStart < std::chrono::microseconds { 200 })
+    {
+    }
+    const auto dIntervalNs = static_cast<double>(dbgh::CCaptureClock::Ticks() - uStartTicks)
+                             * dbgh::CCaptureClock::NanosecondsPerTick();
+    TEST_ASSERT(dIntervalNs > 100'000.0 && dIntervalNs < 100'000'000.0);
+
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Warning);
+    dbgh::CAssertConfig::Get().SetExecutor(std::make_unique<DummyExecutor>());
+    dbgh::CAssertConfig::Get().SetReportFormat(dbgh::EReportFormat::JsonLines);
+    ASSERT_WARNING(false, "stamp");
+    const auto strThread = R"("thread":)" + std::to_string(first.threadId) + ',';
+    TEST_ASSERT(DummyExecutor::s_strMessage.find(strThread) != std::string::npos);
+    TEST_ASSERT(DummyExecutor::s_strMessage.find(R"("cpu":)") != std::string::npos);
+
+    // The time is taken at the failure, not when the report is formatted after the slow filter.
+    dbgh::CAssertConfig::Get().SetFilter([](const dbgh::SAssertSite&, const dbgh::SThreadContext&)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds { 50 });
+        return dbgh::EFilterVerdict::Accept;
+    });
+    const auto failedAt = std::chrono::system_clock::now();
+    ASSERT_WARNING(false, "slow filter");
+    dbgh::CAssertConfig::Get().SetFilter();
+    const auto uTimestamp = DummyExecutor::s_strMessage.find(R"("timestamp":)");
+    TEST_ASSERT(std::string::npos != uTimestamp);
+    const auto reportedAt = std::chrono::system_clock::time_point { std::chrono::duration_cast<
+            std::chrono::system_clock::duration>(std::chrono::nanoseconds {
+            std::stoll(DummyExecutor::s_strMessage.substr(uTimestamp + std::strlen(R"("timestamp":)"))) }) };
+    TEST_ASSERT(reportedAt - failedAt < std::chrono::milliseconds { 25 });
+
+    dbgh::CAssertConfig::Get().SetReportFormat(dbgh::EReportFormat::Text);
+    ASSERT_WARNING(false, "stamp");
+    TEST_ASSERT(DummyExecutor::s_strMessage.find("  [thread]:       " + std::to_string(first.threadId))
+                != std::string::npos);
+
+    dbgh::CAssertConfig::Get().SetExecutor();
+    std::cout << "End capture clock testing." << std::endl << std::endl;
+}
+
+void TestScopedContext()
+{
+    std::cout << "Start scoped context testing." << std::endl;
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Warning);
+    dbgh::CAssertConfig::Get().SetExecutor(std::make_unique<DummyExecutor>());
+
+    const std::string strTenant = "acme \"corp\"";
+    const int requestId = 42;
+    {
+        dbgh::CScopedContext tenant { "tenant", strTenant };
+        {
+            dbgh::CScopedContext request { "request", requestId };
+            TEST_ASSERT(dbgh::CScopedContext::Top()->parent->name == std::string_view { "tenant" });
+
+            ASSERT_WARNING(false, "context");
+            TEST_ASSERT(DummyExecutor::s_strMessage.find("  [context]:      tenant=acme \"corp\" request=42\n")
+                        != std::string::npos);
+
+            dbgh::CAssertConfig::Get().SetReportFormat(dbgh::EReportFormat::JsonLines);
+            ASSERT_WARNING(false, "context");
+            TEST_ASSERT(DummyExecutor::s_strMessage.find(R"("context":{"tenant":"acme \"corp\"","request":"42"})")
+                        != std::string::npos);
+            dbgh::CAssertConfig::Get().SetReportFormat(dbgh::EReportFormat::Text);
+        }
+        TEST_ASSERT(dbgh::CScopedContext::Top()->parent == nullptr);
+    }
+    TEST_ASSERT(dbgh::CScopedContext::Top() == nullptr);
+
+    ASSERT_WARNING(false, "no context");
+    TEST_ASSERT(DummyExecutor::s_strMessage.find("[context]") == std::string::npos);
+
+    dbgh::CAssertConfig::Get().SetExecutor();
+    std::cout << "End scoped context testing." << std::endl << std::endl;
+}
+
+void TestRequestSampling()
+{
+    std::cout << "Start request sampling testing." << std::endl;
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Warning);
+    dbgh::CAssertConfig::Get().SetExecutor(std::make_unique<DummyExecutor>());
+
+    constexpr auto warningMask = dbgh::LevelMask(dbgh::EAssertLevel::Warning);
+    static_assert(dbgh::CRequestSampling::IsSampled("any", 1.0));
+    static_assert(! dbgh::CRequestSampling::IsSampled("any", 0.0));
+
+    int sampledCount = 0;
+    int reportCount = 0;
+    bool bConsistent = true;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const auto strKey = "request-" + std::to_string(i);
+        dbgh::CScopedRequestSampling sampling { strKey, 0.1, warningMask };
+        bConsistent = bConsistent && sampling.IsSampled() == dbgh::CRequestSampling::IsSampled(strKey, 0.1)
+                && dbgh::CAssertConfig::Get().IsActiveAssert(dbgh::EAssertLevel::Error);
+        sampledCount += sampling.IsSampled() ? 1 : 0;
+
+        DummyExecutor::s_strMessage.clear();
+        ASSERT_WARNING(false, "sampled");
+        reportCount += DummyExecutor::s_strMessage.empty() ? 0 : 1;
+    }
+    TEST_ASSERT(bConsistent);
+    TEST_ASSERT(sampledCount == reportCount);
+    TEST_ASSERT(sampledCount > 800 && sampledCount < 1200);
+    TEST_ASSERT(dbgh::CRequestSampling::ThreadMask() == dbgh::AllLevelsMask);
+
+    {
+        dbgh::CScopedRequestSampling outer { "key", 0.0, warningMask };
+        {
+            dbgh::CScopedRequestSampling inner { "key", 1.0, warningMask };
+            TEST_ASSERT(! dbgh::CAssertConfig::Get().IsActiveAssert(dbgh::EAssertLevel::Warning));
+        }
+        TEST_ASSERT(! dbgh::CAssertConfig::Get().IsActiveAssert(dbgh::EAssertLevel::Warning));
+    }
+    TEST_ASSERT(dbgh::CAssertConfig::Get().IsActiveAssert(dbgh::EAssertLevel::Warning));
+
+    dbgh::CAssertConfig::Get().SetExecutor();
+    std::cout << "End request sampling testing." << std::endl << std::endl;
+}
+
+/**
+ * @brief      The eager fire-and-forget coroutine with the assert state propagation.
+ */
+struct SDetachedTask
 {
+    struct promise_type : dbgh::CAssertContextPromise
+    {
+        SDetachedTask get_return_object() noexcept { return { }; }
+        auto initial_suspend() noexcept { return InitialSuspend(std::suspend_never { }); }
+        auto final_suspend() noexcept { return FinalSuspend(std::suspend_never { }); }
+        void return_void() noexcept { }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/**
+ * @brief      Resumes the awaiting coroutine on a new thread.
+ */
+struct SResumeOnNewThread
+{
+    std::thread& thread;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { thread = std::thread { [handle] { handle.resume(); } }; }
+    void await_resume() const noexcept { }
+};
+
+/**
+ * @brief      The persistent worker thread which runs the posted jobs in order.
+ */
+class CWorker
+{
+public:
+    void Post(std::function<void()> job)
+    {
+        {
+            std::lock_guard lock { m_mtxJobs };
+            m_deqJobs.push_back(std::move(job));
+        }
+        m_cvJobs.notify_one();
+    }
+
+    void Start()
+    {
+        m_thread = std::thread { [this]
+        {
+            for (;;)
+            {
+                std::unique_lock lock { m_mtxJobs };
+                m_cvJobs.wait(lock, [this] { return m_bStopped || ! m_deqJobs.empty(); });
+                if (m_deqJobs.empty())
+                {
+                    return;
+                }
+                auto job = std::move(m_deqJobs.front());
+                m_deqJobs.pop_front();
+                lock.unlock();
+                job();
+            }
+        } };
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard lock { m_mtxJobs };
+            m_bStopped = true;
+        }
+        m_cvJobs.notify_one();
+        m_thread.join();
+    }
+
+private:
+    std::mutex m_mtxJobs;
+    std::condition_variable m_cvJobs;
+    std::deque<std::function<void()>> m_deqJobs;
+    bool m_bStopped = false;
+    std::thread m_thread;
+};
+
+/**
+ * @brief      Resumes the awaiting coroutine on the worker.
+ */
+struct SResumeOnWorker
+{
+    CWorker& worker;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { worker.Post([handle] { handle.resume(); }); }
+    void await_resume() const noexcept { }
+};
+
+// GCC lowers the coroutine body into a switch without the default label.
+#if defined(__GNUC__) && ! defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-default"
+#endif
+SDetachedTask CoroutineWithContext(std::thread& thread, std::string& strReport, bool& bMaskKept)
+{
+    const std::string strTask = "task-1";
+    dbgh::CScopedContext task { "task", strTask };
+    co_await SResumeOnNewThread { thread };
+
+    bMaskKept = ! dbgh::CAssertConfig::Get().IsActiveAssert(dbgh::EAssertLevel::Debug);
+    ASSERT_WARNING(false, "coroutine");
+    strReport = DummyExecutor::s_strMessage;
+}
+
+SDetachedTask CoroutineOnWorker(CWorker& worker, std::string& strReport)
+{
+    const std::string strTask = "task-2";
+    dbgh::CScopedContext task { "task", strTask };
+    co_await SResumeOnWorker { worker };
+
+    ASSERT_WARNING(false, "worker");
+    strReport = DummyExecutor::s_strMessage;
+}
+#if defined(__GNUC__) && ! defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * @brief      Calls the function under the context frames of the depth, the value of every frame is its depth.
+ */
+void WithContextDepth(const std::size_t uDepth, const std::function<void()>& fnBody)
+{
+    if (0 == uDepth)
+    {
+        fnBody();
+        return;
+    }
+    const std::string strValue = std::to_string(uDepth) + std::string(40, '.');
+    dbgh::CScopedContext frame { "depth", strValue };
+    WithContextDepth(uDepth - 1, fnBody);
+}
+
+void TestCoroutineContext()
+{
+    std::cout << "Start coroutine context testing." << std::endl;
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Warning);
+    dbgh::CAssertConfig::Get().SetExecutor(std::make_unique<DummyExecutor>());
+
+    std::thread thread;
+    std::string strReport;
+    bool bMaskKept = false;
+    {
+        const std::string strRequest = "request-1";
+        dbgh::CScopedContext request { "request", strRequest };
+        dbgh::CScopedRequestSampling sampling { "request-1", 0.0, dbgh::LevelMask(dbgh::EAssertLevel::Debug) };
+        CoroutineWithContext(thread, strReport, bMaskKept);
+
+        // The coroutine is suspended, the thread has its own state back.
+        TEST_ASSERT(dbgh::CScopedContext::Top()->name == std::string_view { "request" });
+        thread.join();
+    }
+    TEST_ASSERT(bMaskKept);
+    TEST_ASSERT(strReport.find("  [context]:      request=request-1 task=task-1\n") != std::string::npos);
+    TEST_ASSERT(dbgh::CScopedContext::Top() == nullptr);
+
+    // The worker outlives the task and the creator scope, it must get its own state back and the task must not
+    // reference the frames of the creator.
+    CWorker worker;
+    strReport.clear();
+    {
+        const std::string strRequest = "request-2";
+        dbgh::CScopedContext request { "request", strRequest };
+        dbgh::CScopedRequestSampling sampling { "request-2", 0.0, dbgh::LevelMask(dbgh::EAssertLevel::Debug) };
+        CoroutineOnWorker(worker, strReport);
+        TEST_ASSERT(dbgh::CScopedContext::Top()->name == std::string_view { "request" });
+    }
+    const dbgh::SContextFrame* pWorkerTop = nullptr;
+    std::uint32_t uWorkerMask = 0;
+    worker.Start();
+    worker.Post([&pWorkerTop, &uWorkerMask]
+    {
+        pWorkerTop = dbgh::CScopedContext::Top();
+        uWorkerMask = dbgh::CRequestSampling::ThreadMask();
+    });
+    worker.Stop();
+    TEST_ASSERT(strReport.find("  [context]:      request=request-2 task=task-2\n") != std::string::npos);
+    TEST_ASSERT(nullptr == pWorkerTop);
+    TEST_ASSERT(dbgh::AllLevelsMask == uWorkerMask);
+
+    // The task keeps the outermost frames, the innermost text is cut at the capacity.
+    WithContextDepth(dbgh::CAssertTaskContext::MaxFrames + 2, []
+    {
+        dbgh::CAssertTaskContext context;
+        std::size_t uFrames = 0;
+        std::string strText;
+        std::string strOutermost;
+        for (auto pFrame = context.TaskState().pContext; nullptr != pFrame; pFrame = pFrame->parent)
+        {
+            ++uFrames;
+            strOutermost.clear();
+            pFrame->format(strOutermost, pFrame->value);
+            strText += strOutermost;
+        }
+        TEST_ASSERT(dbgh::CAssertTaskContext::MaxFrames == uFrames);
+        TEST_ASSERT(dbgh::CAssertTaskContext::MaxTextLength == strText.size());
+        TEST_ASSERT(std::to_string(dbgh::CAssertTaskContext::MaxFrames + 2) + std::string(40, '.') == strOutermost);
+    });
+
+    dbgh::CAssertConfig::Get().SetExecutor();
+    std::cout << "End coroutine context testing." << std::endl << std::endl;
+}
+
+bool SlowCheck()
+{
+    volatile std::uint64_t uSum = 0;
+    for (std::uint64_t i = 0; i < 20000; ++i)
+    {
+        uSum = uSum + i;
+    }
+    return uSum > 0;
+}
+
+void TestCpuBudget()
+{
+    std::cout << "Start CPU budget testing." << std::endl;
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Warning);
+    dbgh::CAssertConfig::Get().SetExecutor(std::make_unique<DummyExecutor>());
+
+    const auto runSlowAssert = []
+    {
+        for (int i = 0; i < 3000; ++i)
+        {
+            ASSERT_WARNING(SlowCheck(), "slow");
+        }
+    };
+    const auto slowSiteMode = []
+    {
+        auto mode = dbgh::ESiteMode::Full;
+        dbgh::CAssertSiteRegistry::ForEach([&mode](const dbgh::SAssertSite& site)
+        {
+            if (std::string_view { "SlowCheck()" } == site.expression)
+            {
+                mode = dbgh::CAssertConfig::GetSiteMode(site);
+            }
+        });
+        return mode;
+    };
+
+    dbgh::CAssertConfig::Get().SetCpuBudget(0.001, std::chrono::hours { 1 });
+    runSlowAssert();
+    dbgh::CAssertConfig::Get().EvaluateCpuBudget();
+    TEST_ASSERT(dbgh::CAssertConfig::Get().GetCpuBudgetUsage() > 0.001);
+    TEST_ASSERT(slowSiteMode() == dbgh::ESiteMode::Sampled);
+
+    runSlowAssert();
+    dbgh::CAssertConfig::Get().EvaluateCpuBudget();
+    TEST_ASSERT(slowSiteMode() == dbgh::ESiteMode::Disabled);
+
+    dbgh::CAssertConfig::Get().SetCpuBudget();
+    TEST_ASSERT(slowSiteMode() == dbgh::ESiteMode::Full);
+    TEST_ASSERT(dbgh::CAssertConfig::Get().GetCpuBudgetUsage() < 0.001);
+
+    dbgh::CAssertConfig::Get().SetExecutor();
+    std::cout << "End CPU budget testing." << std::endl << std::endl;
+}
+
+void TestAssertProfiler()
+{
+    std::cout << "Start assert profiler testing." << std::endl;
+
+    static dbgh::SAssertSite site { dbgh::EAssertLevel::Warning, "Profiled()", __FILE__, __LINE__, __func__ };
+    dbgh::CAssertProfiler::RecordEvaluation(site, 100);
+    dbgh::CAssertProfiler::RecordEvaluation(site, 300);
+    std::thread { [] { dbgh::CAssertProfiler::RecordHandler(site, 5000); } }.join();
+
+    const auto vecProfiles = dbgh::CAssertProfiler::Collect();
+    const auto iter = std::find_if(vecProfiles.begin(), vecProfiles.end(),
+                                   [](const auto& profile) { return profile.pSite == &site; });
+    TEST_ASSERT(iter != vecProfiles.end());
+    TEST_ASSERT(iter->evaluation.count == 2 && iter->evaluation.ticks == 400);
+    TEST_ASSERT(iter->evaluation.Quantile(0.99) == 511);
+    TEST_ASSERT(iter->handler.count == 1 && iter->handler.ticks == 5000);
+
+    std::stringstream report;
+    dbgh::CAssertProfiler::WriteTopReport(report, 1000);
+    TEST_ASSERT(report.str().find("(Profiled())") != std::string::npos);
+
+#if defined(DBGH_ASSERTS_PROFILE)
+    dbgh::CAssertConfig::Get().EnableAsserts(dbgh::EAssertLevel::Warning);
+    dbgh::CAssertConfig::Get().SetExecutor(std::make_unique<DummyExecutor>());
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_WARNING(i % 2 == 0, "profiled");
+    }
+    dbgh::CAssertConfig::Get().SetExecutor();
+
+    const auto vecMacroProfiles = dbgh::CAssertProfiler::Collect();
+    TEST_ASSERT(std::any_of(vecMacroProfiles.begin(), vecMacroProfiles.end(), [](const auto& profile)
+    {
+        return std::string_view { "i % 2 == 0" } == profile.pSite->expression
+               && 10 == profile.evaluation.count && 5 == profile.handler.count;
+    }));
+#endif
+
+    std::cout << "End assert profiler testing." << std::endl << std::endl;
+}
+
+void TestSiteDemotions()
+{
+    std::cout << "Start site demotions testing." << std::endl;
+
+    static constexpr dbgh::SSiteDemotion arrTable[] = {
+            { "src/hot.cpp", 10, dbgh::ESiteMode::Disabled },
+            { "warm.cpp", 20, dbgh::ESiteMode::Sampled },
+            { nullptr, 0, dbgh::ESiteMode::Full } };
+    static_assert(dbgh::ESiteMode::Disabled == dbgh::CSiteDemotions::Find(arrTable, "/root/src/hot.cpp", 10));
+    static_assert(dbgh::ESiteMode::Full == dbgh::CSiteDemotions::Find(arrTable, "/root/src/hot.cpp", 11));
+    static_assert(dbgh::ESiteMode::Full == dbgh::CSiteDemotions::Find(arrTable, "/root/src/nothot.cpp", 10));
+    static_assert(dbgh::ESiteMode::Sampled == dbgh::CSiteDemotions::Find(arrTable, "C:\\src\\warm.cpp", 20));
+    static_assert(dbgh::ESiteMode::Sampled == dbgh::CSiteDemotions::Find(arrTable, "warm.cpp", 20));
+
+    static dbgh::SAssertSite site { dbgh::EAssertLevel::Warning, "Sampled()", __FILE__, __LINE__, __func__ };
+    int iEvaluated = 0;
+    for (std::uint32_t i = 0; i < 64 * dbgh::CAssertProbe::SampleRate; ++i)
+    {
+        dbgh::CAssertProbe probe { site, dbgh::ESiteMode::Sampled };
+        iEvaluated += probe.ShouldEvaluate() ? 1 : 0;
+    }
+    TEST_ASSERT(iEvaluated > 0 && iEvaluated < 256);
+
+    dbgh::CAssertProfiler::RecordEvaluation(site, 1000);
+    std::stringstream profile;
+    dbgh::CAssertProfiler::WriteProfile(profile);
+    TEST_ASSERT(profile.str().find(std::format("{}\t{}\t1\t1000\t0\t0\n", __FILE__, site.line)) != std::string::npos);
+
+    std::cout << "End site demotions testing." << std::endl << std::endl;
+}
+
+void TestStartupConfig()
+{
+    std::cout << "Start startup config testing." << std::endl;
+
+    const auto settings = dbgh::CConfigParser::Parse(
+            "# comment\nlevels=warning, Fatal; format=json\n budget=0.25;sink=file:/tmp/a=b.log\n"
+            "level:error=off; file:net/=sampled:256; site:C:\\src\\db.cpp:12=on");
+    TEST_ASSERT(settings.enableMask == (dbgh::LevelMask(dbgh::EAssertLevel::Warning)
+                                        | dbgh::LevelMask(dbgh::EAssertLevel::Fatal)));
+    TEST_ASSERT(settings.reportFormat == dbgh::EReportFormat::JsonLines);
+    TEST_ASSERT(settings.cpuBudget == 0.25);
+    TEST_ASSERT(settings.sink == dbgh::ESinkChoice::File && "/tmp/a=b.log" == settings.sinkPath);
+    TEST_ASSERT(3 == settings.siteRules.size());
+    TEST_ASSERT(settings.siteRules[0].level == dbgh::EAssertLevel::Error);
+    TEST_ASSERT("net/" == settings.siteRules[1].file && 8 == settings.siteRules[1].rateShift);
+    TEST_ASSERT("C:\\src\\db.cpp" == settings.siteRules[2].file && 12 == settings.siteRules[2].line);
+
+    for (const auto* pszInvalid : { "levels=all", "budget=2", "file:a.cpp=sampled:3", "site:a.cpp=off", "color=red" })
+    {
+        bool bThrown = false;
+        try
+        {
+            static_cast<void>(dbgh::CConfigParser::Parse(pszInvalid));
+        }
+        catch (const std::invalid_argument&)
+        {
+            bThrown = true;
+        }
+        TEST_ASSERT(bThrown);
+    }
+
+    TEST_ASSERT(dbgh::CSiteRules::MatchesPath("/src/net/socket.cpp", "net/socket.cpp"));
+    TEST_ASSERT(dbgh::CSiteRules::MatchesPath("/src/net/tcp/client.cpp", "net/"));
+    TEST_ASSERT(! dbgh::CSiteRules::MatchesPath("/src/subnet/socket.cpp", "net/socket.cpp"));
+    TEST_ASSERT(! dbgh::CSiteRules::MatchesPath("/src/subnet/socket.cpp", "net/"));
+
+    auto& config = dbgh::CAssertConfig::Get();
+    config.SetExecutor(std::make_unique<DummyExecutor>());
+    int line = 0;
+    const auto failures = [&line](const int iPasses)
+    {
+        int iFailures = 0;
+        for (int i = 0; i < iPasses; ++i)
+        {
+            DummyExecutor::s_bHandleWarningCalled = false;
+            line = __LINE__; ASSERT_WARNING(false, "configured");
+            iFailures += DummyExecutor::s_bHandleWarningCalled ? 1 : 0;
+        }
+        return iFailures;
+    };
+    TEST_ASSERT(1 == failures(1));
+
+    config.Configure(std::format("levels=warning; site:tests/main.cpp:{}=off", line));
+    TEST_ASSERT(0 == failures(100));
+    TEST_ASSERT(! config.IsActiveAssert(dbgh::EAssertLevel::Error));
+    // The pass which checked the old enable word is stopped by the enable word of the new rule slot.
+    static dbgh::SAssertSite errorSite { dbgh::EAssertLevel::Error, "Switched()", __FILE__, __LINE__, __func__ };
+    TEST_ASSERT(! dbgh::CAssertProbe { errorSite }.ShouldEvaluate());
+
+    config.Configure(std::format("file:tests/main.cpp=sampled:1024; site:tests/main.cpp:{}=sampled:4", line));
+    const auto iSampled = failures(4096);
+    TEST_ASSERT(iSampled > 512 && iSampled < 2048);
+
+    bool bThrown = false;
+    try
+    {
+        config.Configure("levels=none; format=yaml");
+    }
+    catch (const std::invalid_argument&)
+    {
+        bThrown = true;
+    }
+    TEST_ASSERT(bThrown && config.IsActiveAssert(dbgh::EAssertLevel::Warning));
+
+    config.Configure("levels=warning,debug,error");
+    TEST_ASSERT(100 == failures(100));
+    TEST_ASSERT(dbgh::CAssertProbe { errorSite }.ShouldEvaluate());
+    config.SetExecutor();
+
+    std::cout << "End startup config testing." << std::endl << std::endl;
+}
+
+void TestConfigWatcher()
+{
+    std::cout << "Start config watcher testing." << std::endl;
+
+    const auto directory = std::filesystem::temp_directory_path() / "dbgh_config_watcher_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const auto path = (directory / "asserts.conf").string();
+
+    auto& config = dbgh::CAssertConfig::Get();
+    config.SetExecutor(std::make_unique<DummyExecutor>());
+    dbgh::SAssertSite* pSite = nullptr;
+    int line = 0;
+    const auto failures = [&line](const int iPasses)
+    {
+        int iFailures = 0;
+        for (int i = 0; i < iPasses; ++i)
+        {
+            DummyExecutor::s_bHandleWarningCalled = false;
+            line = __LINE__; ASSERT_WARNING(false, "watched");
+            iFailures += DummyExecutor::s_bHandleWarningCalled ? 1 : 0;
+        }
+        return iFailures;
+    };
+    TEST_ASSERT(1 == failures(1));
+    dbgh::CAssertSiteRegistry::ForEach([&pSite, &line](dbgh::SAssertSite& site)
+    {
+        if (line == site.line && std::string_view { site.file }.ends_with("main.cpp"))
+        {
+            pSite = &site;
+        }
+    });
+    TEST_ASSERT(nullptr != pSite);
+
+    const auto waitMode = [pSite](const dbgh::ESiteMode mode)
+    {
+        for (int i = 0; i < 200 && mode != dbgh::CAssertConfig::GetSiteMode(*pSite); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds { 10 });
+        }
+        return mode == dbgh::CAssertConfig::GetSiteMode(*pSite);
+    };
+
+    std::ofstream { path } << std::format("site:tests/main.cpp:{}=off\n", line);
+    config.WatchConfigFile(path);
+    TEST_ASSERT(dbgh::ESiteMode::Disabled == dbgh::CAssertConfig::GetSiteMode(*pSite));
+    TEST_ASSERT(0 == failures(100));
+
+    // The asserting thread runs through the reloads without blocking.
+    std::jthread asserting { [&failures](std::stop_token stopToken)
+    {
+        while (! stopToken.stop_requested())
+        {
+            static_cast<void>(failures(1));
+        }
+    } };
+
+    // Rewritten in place.
+    std::ofstream { path } << std::format("format=json\nsite:tests/main.cpp:{}=sampled:4\n", line);
+    TEST_ASSERT(waitMode(dbgh::ESiteMode::Sampled));
+    TEST_ASSERT(dbgh::EReportFormat::JsonLines == config.GetReportFormat());
+
+    // Replaced by rename, as editors and configuration managers do.
+    const auto tempPath = (directory / "asserts.conf.tmp").string();
+    std::ofstream { tempPath } << "# back to the defaults\n";
+    std::filesystem::rename(tempPath, path);
+    TEST_ASSERT(waitMode(dbgh::ESiteMode::Full));
+    // The keys removed from the file return to their defaults.
+    TEST_ASSERT(dbgh::EReportFormat::Text == config.GetReportFormat());
+
+    // The malformed file is ignored.
+    std::ofstream { path } << "levels=all\n";
+    std::this_thread::sleep_for(std::chrono::milliseconds { 200 });
+    TEST_ASSERT(dbgh::ESiteMode::Full == dbgh::CAssertConfig::GetSiteMode(*pSite));
+    asserting.request_stop();
+    asserting.join();
+
+    config.WatchConfigFile();
+    std::ofstream { path } << std::format("site:tests/main.cpp:{}=off\n", line);
+    std::this_thread::sleep_for(std::chrono::milliseconds { 200 });
+    TEST_ASSERT(dbgh::ESiteMode::Full == dbgh::CAssertConfig::GetSiteMode(*pSite));
+    TEST_ASSERT(100 == failures(100));
+
+    config.SetExecutor();
+    std::filesystem::remove_all(directory);
+
+    std::cout << "End config watcher testing." << std::endl << std::endl;
+}
+
+void TestControlServer()
+{
+    std::cout << "Start control server testing." << std::endl;
+
+    auto& config = dbgh::CAssertConfig::Get();
+    config.SetExecutor(std::make_unique<DummyExecutor>());
+    int line = 0;
+    const auto failures = [&line](const int iPasses)
+    {
+        int iFailures = 0;
+        for (int i = 0; i < iPasses; ++i)
+        {
+            DummyExecutor::s_bHandleWarningCalled = false;
+            line = __LINE__; ASSERT_WARNING(1 + 1 == 3, "controlled");
+            iFailures += DummyExecutor::s_bHandleWarningCalled ? 1 : 0;
+        }
+        return iFailures;
+    };
+    TEST_ASSERT(3 == failures(3));
+
+    const auto site = std::format("tests/main.cpp:{}", line);
+    const auto path = (std::filesystem::temp_directory_path() / "dbgh_control_test.sock").string();
+    config.StartControlServer(path);
+    const auto request = [&path](const std::string& text)
+    {
+        std::string strResponse;
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address { };
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        if (0 == ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address))
+            && static_cast<ssize_t>(text.size() + 1) == ::write(fd, (text + "\n").c_str(), text.size() + 1))
+        {
+            char arrBuffer[4096];
+            for (auto iRead = ::read(fd, arrBuffer, sizeof(arrBuffer)); iRead > 0; iRead = ::read(fd, arrBuffer, sizeof(arrBuffer)))
+            {
+                strResponse.append(arrBuffer, static_cast<std::size_t>(iRead));
+            }
+        }
+        ::close(fd);
+        return strResponse;
+    };
+
+    struct stat status { };
+    TEST_ASSERT(0 == ::stat(path.c_str(), &status));
+    TEST_ASSERT((S_IRUSR | S_IWUSR) == (status.st_mode & 0777));
+
+    const auto listed = request("list tests/main.cpp");
+    TEST_ASSERT(listed.ends_with("ok\n"));
+    TEST_ASSERT(std::string::npos != listed.find(site + "\tfull\t3\t1 + 1 == 3\n"));
+    TEST_ASSERT(std::string::npos != request("status").find("levels=WARNING,DEBUG,ERROR\n"));
+
+    TEST_ASSERT("ok\n" == request("set site:" + site + "=off"));
+    TEST_ASSERT(0 == failures(100));
+    TEST_ASSERT(std::string::npos != request("list").find(site + "\toff\t3\t"));
+    TEST_ASSERT("site:" + site + "=off\nok\n" == request("rules"));
+
+    TEST_ASSERT("ok\n" == request("set level:warning=sampled:16"));
+    TEST_ASSERT(std::string::npos != request("list " + site.substr(0, site.find(':'))).find(site + "\tsampled:16\t"));
+    TEST_ASSERT(request("set level:warning=maybe").starts_with("error: "));
+    TEST_ASSERT(request("reboot").starts_with("error: Unknown request"));
+    TEST_ASSERT(dbgh::impl::CControlServer::Execute("rules").starts_with("site:" + site + "=off\nlevel:WARNING=sampled:16\n"));
+
+    TEST_ASSERT("ok\n" == request("config levels=warning,debug,error"));
+    TEST_ASSERT(100 == failures(100));
+
+    // The executor replaced by a reload outlives the reports which use it.
+    const auto pHeld = config.GetExecutor();
+    std::jthread asserting { [&failures](std::stop_token stopToken)
+    {
+        while (! stopToken.stop_requested())
+        {
+            static_cast<void>(failures(1));
+        }
+    } };
+    for (int i = 0; i < 200; ++i)
+    {
+        config.SetExecutor(std::make_unique<DummyExecutor>());
+    }
+    TEST_ASSERT("ok\n" == request("config sink=default; levels=debug,error"));
+    asserting.request_stop();
+    asserting.join();
+    TEST_ASSERT(1 == pHeld.use_count());
+    config.EnableAsserts(dbgh::EAssertLevel::Warning);
+
+    config.StartControlServer();
+    TEST_ASSERT(! std::filesystem::exists(path));
+    config.SetExecutor();
+
+    std::cout << "End control server testing." << std::endl << std::endl;
+}
+
+void TestSharedControl()
+{
+    std::cout << "Start shared control testing." << std::endl;
+
+    auto& config = dbgh::CAssertConfig::Get();
+    config.SetExecutor(std::make_unique<DummyExecutor>());
+    int line = 0;
+    const auto failures = [&line](const int iPasses)
+    {
+        int iFailures = 0;
+        for (int i = 0; i < iPasses; ++i)
+        {
+            DummyExecutor::s_bHandleWarningCalled = false;
+            line = __LINE__; ASSERT_WARNING(2 + 2 == 5, "shared");
+            iFailures += DummyExecutor::s_bHandleWarningCalled ? 1 : 0;
+        }
+        return iFailures;
+    };
+    TEST_ASSERT(1 == failures(1));
+
+    const auto name = std::format("/dbgh_shared_test_{}", ::getpid());
+    config.AttachSharedControl(name);
+    TEST_ASSERT(config.IsActiveAssert(dbgh::EAssertLevel::Warning));
+
+    // The writer maps the block at another address, as dbgh-ctl in another process does.
+    dbgh::impl::CSharedControl writer { name, false };
+    const auto site = std::format("tests/main.cpp:{}", line);
+    TEST_ASSERT(std::string::npos != writer.Execute("list tests/main.cpp").find(site + "\tdefault\n"));
+
+    TEST_ASSERT("ok\n" == writer.Execute("set site:" + site + "=off"));
+    TEST_ASSERT(0 == failures(100));
+    const dbgh::SAssertSite* pSite = nullptr;
+    dbgh::CAssertSiteRegistry::ForEach([&pSite, &line](const dbgh::SAssertSite& registered)
+    {
+        pSite = (line == registered.line) ? &registered : pSite;
+    });
+    TEST_ASSERT(nullptr != pSite && dbgh::ESiteMode::Disabled == dbgh::CAssertConfig::GetSiteMode(*pSite));
+    TEST_ASSERT(writer.Execute("set format=json").starts_with("error: "));
+
+    // The change of another writer reaches the enable word of the process through the mirror thread.
+    const auto mirrored = [&config](const dbgh::EAssertLevel level, const bool bActive)
+    {
+        for (int i = 0; i < 1000 && bActive != config.IsActiveAssert(level); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+        }
+        return bActive == config.IsActiveAssert(level);
+    };
+
+    // The forked worker sees the levels set by the writer.
+    const auto pid = ::fork();
+    if (0 == pid)
+    {
+        for (int i = 0; i < 2000 && config.IsActiveAssert(dbgh::EAssertLevel::Warning); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+        }
+        ::_exit(config.IsActiveAssert(dbgh::EAssertLevel::Warning) ? 1 : 0);
+    }
+    TEST_ASSERT("ok\n" == writer.Execute("set levels=error"));
+    int iStatus = -1;
+    ::waitpid(pid, &iStatus, 0);
+    TEST_ASSERT(WIFEXITED(iStatus) && 0 == WEXITSTATUS(iStatus));
+    TEST_ASSERT(mirrored(dbgh::EAssertLevel::Warning, false));
+
+    // The process writes to the shared mask too.
+    config.EnableAsserts(dbgh::EAssertLevel::Warning);
+    TEST_ASSERT(writer.Execute("status").starts_with("levels=WARNING,ERROR\n"));
+
+    TEST_ASSERT("ok\n" == writer.Execute("config levels=warning,debug,error"));
+    TEST_ASSERT(mirrored(dbgh::EAssertLevel::Debug, true));
+    TEST_ASSERT(100 == failures(100));
+    TEST_ASSERT("ok\n" == writer.Execute("rules"));
+    dbgh::impl::CSharedControl::Remove(name);
+    config.SetExecutor();
+
+    std::cout << "End shared control testing." << std::endl << std::endl;
+}
+
+void TestAssertCategories()
+{
+    std::cout << "Start assert categories testing." << std::endl;
+
+    auto& config = dbgh::CAssertConfig::Get();
+    config.SetExecutor(std::make_unique<DummyExecutor>());
+    const auto fires = [](const auto& fnAssert)
+    {
+        DummyExecutor::s_bHandleWarningCalled = false;
+        fnAssert();
+        return DummyExecutor::s_bHandleWarningCalled;
+    };
+    const auto storage = [] { ASSERT_WARNING_IN(Storage, 2 + 2 == 5, "storage"); };
+    const auto network = [] { ASSERT_WARNING_IN(Network, 2 + 2 == 5, "network"); };
+    const auto untagged = [] { ASSERT_WARNING(2 + 2 == 5, "untagged"); };
+    TEST_ASSERT(fires(storage) && fires(network) && fires(untagged));
+
+    config.DisableCategory(dbgh::EAssertLevel::Warning, Storage);
+    TEST_ASSERT(! fires(storage) && fires(network) && fires(untagged));
+    TEST_ASSERT(config.IsActiveAssert(dbgh::EAssertLevel::Warning));
+    config.EnableCategory(dbgh::EAssertLevel::Warning, Storage);
+    TEST_ASSERT(fires(storage));
+
+    config.Amend("categories=default,Network");
+    TEST_ASSERT(! fires(storage) && fires(network) && fires(untagged));
+    TEST_ASSERT(! config.IsActiveAssert(dbgh::EAssertLevel::Fatal, Network.index));
+    TEST_ASSERT(std::string::npos != dbgh::impl::CControlServer::Execute("status").find("categories:DEBUG=default,Network\n"));
+
+    config.Amend("categories:warning=1");
+    TEST_ASSERT(fires(storage) && ! fires(network) && ! fires(untagged));
+    TEST_ASSERT(config.IsActiveAssert(dbgh::EAssertLevel::Debug, Network.index));
+
+    bool bThrown = false;
+    try
+    {
+        config.Amend("categories=Unknown");
+    }
+    catch (const std::invalid_argument&)
+    {
+        bThrown = true;
+    }
+    TEST_ASSERT(bThrown);
+
+    config.Amend("levels=warning,debug,error");
+    TEST_ASSERT(fires(storage) && fires(network) && fires(untagged));
+    TEST_ASSERT(dbgh::impl::CControlServer::Execute("status").starts_with("levels=WARNING,DEBUG,ERROR\nformat="));
+    config.SetExecutor();
+
+    std::cout << "End assert categories testing." << std::endl << std::endl;
+}
+
+void TestBurstEnablement()
+{
+    std::cout << "Start burst enablement testing." << std::endl;
+
+    auto& config = dbgh::CAssertConfig::Get();
+    config.SetExecutor(std::make_unique<DummyExecutor>());
+    const auto waitUntil = [](const auto& fnCondition)
+    {
+        for (int i = 0; i < 2000 && ! fnCondition(); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+        }
+        return fnCondition();
+    };
+    const auto fatalActive = [&config] { return config.IsActiveAssert(dbgh::EAssertLevel::Fatal); };
+
+    TEST_ASSERT(! fatalActive());
+    config.EnableFor(dbgh::EAssertLevel::Fatal, std::chrono::milliseconds { 50 });
+    TEST_ASSERT(fatalActive());
+    TEST_ASSERT(waitUntil([&fatalActive] { return ! fatalActive(); }));
+
+    // The level enabled before the burst stays enabled.
+    config.EnableFor(dbgh::EAssertLevel::Warning, std::chrono::milliseconds { 10 });
+    std::this_thread::sleep_for(std::chrono::milliseconds { 100 });
+    TEST_ASSERT(config.IsActiveAssert(dbgh::EAssertLevel::Warning));
+
+    // The level enabled explicitly during the burst keeps the explicit state.
+    config.EnableFor(dbgh::EAssertLevel::Fatal, std::chrono::milliseconds { 10 });
+    config.EnableAsserts(dbgh::EAssertLevel::Fatal);
+    std::this_thread::sleep_for(std::chrono::milliseconds { 100 });
+    TEST_ASSERT(fatalActive());
+    config.DisableAsserts(dbgh::EAssertLevel::Fatal);
+
+    int line = 0;
+    const auto fires = [&line]
+    {
+        DummyExecutor::s_bHandleWarningCalled = false;
+        line = __LINE__; ASSERT_WARNING(2 + 2 == 5, "burst");
+        return DummyExecutor::s_bHandleWarningCalled;
+    };
+    TEST_ASSERT(fires());
+    config.Amend(std::format("site:tests/main.cpp:{}=off", line));
+    TEST_ASSERT(! fires());
+    config.EnableSiteFor("tests/main.cpp", line, std::chrono::milliseconds { 50 });
+    TEST_ASSERT(fires());
+    TEST_ASSERT(waitUntil([&fires] { return ! fires(); }));
+
+    // The burst site of the disabled level is evaluated, the other sites of the level are not.
+    config.DisableAsserts(dbgh::EAssertLevel::Warning);
+    const auto rare = [] { ASSERT_WARNING(2 + 2 == 5, "rare"); };
+    const auto rareLine = __LINE__ - 1;
+    const auto other = [] { ASSERT_WARNING(2 + 2 == 5, "other"); };
+    const auto otherLine = __LINE__ - 1;
+    const auto firesAt = [](const auto& fnSite)
+    {
+        DummyExecutor::s_bHandleWarningCalled = false;
+        fnSite();
+        return DummyExecutor::s_bHandleWarningCalled;
+    };
+    const auto registered = [](const int siteLine)
+    {
+        bool bFound = false;
+        dbgh::CAssertSiteRegistry::ForEach([&bFound, siteLine](const dbgh::SAssertSite& site)
+        {
+            bFound = bFound || (siteLine == site.line && std::string_view { site.file }.ends_with("main.cpp"));
+        });
+        return bFound;
+    };
+    TEST_ASSERT(! firesAt(rare) && ! registered(rareLine));
+    config.EnableSiteFor("tests/main.cpp", rareLine, std::chrono::milliseconds { 50 });
+    TEST_ASSERT(firesAt(rare) && registered(rareLine));
+    TEST_ASSERT(! firesAt(other) && registered(otherLine));
+    TEST_ASSERT(waitUntil([&firesAt, &rare] { return ! firesAt(rare); }));
+
+    // So is the site of the site rule, until the rule is replaced.
+    config.Amend(std::format("site:tests/main.cpp:{}=full", otherLine));
+    TEST_ASSERT(firesAt(other) && ! firesAt(rare));
+    config.Configure("levels=warning,debug,error");
+    TEST_ASSERT(firesAt(rare) && firesAt(other));
+    config.Configure("levels=debug,error");
+    TEST_ASSERT(! firesAt(other));
+    config.EnableAsserts(dbgh::EAssertLevel::Warning);
+    config.SetExecutor();
+
+    std::cout << "End burst enablement testing." << std::endl << std::endl;
+}
+
+void TestReportBackoff()
+{
+    std::cout << "Start report backoff testing." << std::endl;
+
+    auto& config = dbgh::CAssertConfig::Get();
+    auto pExecutor = std::make_unique<SummaryExecutor>();
+    auto& executor = *pExecutor;
+    config.SetExecutor(std::move(pExecutor));
+    const auto fail = [](const int iPasses)
+    {
+        for (int i = 0; i < iPasses; ++i)
+        {
+            ASSERT_WARNING(2 + 2 == 5, "chronic");
+        }
+    };
+    const auto reports = [&executor]
+    {
+        std::lock_guard lock { executor.m_mtx };
+        return executor.m_iReports;
+    };
+    const auto summaries = [&executor]
+    {
+        std::lock_guard lock { executor.m_mtx };
+        return executor.m_iSummaries;
+    };
+
+    // The first failure before the backoff is not summarized, the backoff counts the failures from its start.
+    fail(1);
+    TEST_ASSERT(1 == reports());
+    config.SetReportBackoff(dbgh::LevelMask(dbgh::EAssertLevel::Warning), std::chrono::milliseconds { 200 });
+    fail(99);
+    TEST_ASSERT(1 + 7 == reports()); // The failures 1, 2, 4, 8, 16, 32 and 64.
+    for (int i = 0; i < 2000 && 0 == summaries(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+    }
+    TEST_ASSERT(0 < summaries());
+    {
+        std::lock_guard lock { executor.m_mtx };
+        TEST_ASSERT(std::string_view::npos
+                    != executor.m_strLastSummary.find("The site failed 99 times in the last 200ms, 7 of them reported."));
+    }
+    TEST_ASSERT("The site failed 1200000 times in the last 10s, 2 of them reported."
+                == dbgh::impl::CReportBackoff::FormatSummary(1'200'000, 2, std::chrono::seconds { 10 }));
+
+    config.SetReportBackoff();
+    fail(1);
+    TEST_ASSERT(1 + 7 + 1 == reports());
+
+    // Enabled again, the backoff starts from the first failure.
+    config.Amend("backoff=warning");
+    fail(2);
+    TEST_ASSERT(1 + 7 + 3 == reports());
+    fail(1);
+    TEST_ASSERT(1 + 7 + 3 == reports());
+    config.Amend("backoff=none");
+    fail(1);
+    TEST_ASSERT(1 + 7 + 4 == reports());
+
+    bool bThrown = false;
+    try
+    {
+        config.Amend("backoff=error");
+    }
+    catch (const std::invalid_argument&)
+    {
+        bThrown = true;
+    }
+    TEST_ASSERT(bThrown);
+    config.SetExecutor();
+
+    std::cout << "End report backoff testing." << std::endl << std::endl;
+}
+
+void TestCircuitBreaker()
+{
+    std::cout << "Start circuit breaker testing." << std::endl;
+
+    auto& config = dbgh::CAssertConfig::Get();
+    config.EnableAsserts(dbgh::EAssertLevel::Warning);
+    config.EnableAsserts(dbgh::EAssertLevel::Error);
+    auto pExecutor = std::make_unique<SummaryExecutor>();
+    auto& executor = *pExecutor;
+    config.SetExecutor(std::move(pExecutor));
+    const auto reports = [&executor]
+    {
+        std::lock_guard lock { executor.m_mtx };
+        return executor.m_iReports;
+    };
+    const auto summaries = [&executor]
+    {
+        std::lock_guard lock { executor.m_mtx };
+        return executor.m_iSummaries;
+    };
+    const auto lastSummary = [&executor]
+    {
+        std::lock_guard lock { executor.m_mtx };
+        return executor.m_strLastSummary;
+    };
+
+    config.SetCircuitBreaker(1000.0, std::chrono::milliseconds { 20 });
+    TEST_ASSERT(! config.IsCircuitBreakerTripped());
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds { 2 };
+    while (! config.IsCircuitBreakerTripped() && std::chrono::steady_clock::now() < deadline)
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            ASSERT_WARNING(2 + 2 == 5, "storm");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+    }
+    TEST_ASSERT(config.IsCircuitBreakerTripped());
+    TEST_ASSERT(1 == summaries());
+    TEST_ASSERT(std::string_view::npos != lastSummary().find("over the threshold 1000"));
+
+    // While tripped the warnings are only counted and the errors do not throw.
+    const auto iReports = reports();
+    ASSERT_WARNING(2 + 2 == 5, "counted");
+    TEST_ASSERT(iReports == reports());
+    bool bThrown = false;
+    try
+    {
+        ASSERT_ERROR(2 + 2 == 5, "counted");
+    }
+    catch (const std::exception&)
+    {
+        bThrown = true;
+    }
+    TEST_ASSERT(! bThrown);
+
+    for (int i = 0; i < 2000 && config.IsCircuitBreakerTripped(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+    }
+    TEST_ASSERT(! config.IsCircuitBreakerTripped());
+    TEST_ASSERT(2 == summaries());
+    TEST_ASSERT(std::string_view::npos != lastSummary().find("non-fatal failures were not reported."));
+    ASSERT_WARNING(2 + 2 == 5, "reported");
+    TEST_ASSERT(iReports + 1 == reports());
+
+    config.SetCircuitBreaker();
+    config.Amend("breaker=500");
+    config.Amend("breaker=0");
+    TEST_ASSERT(! config.IsCircuitBreakerTripped());
+    bThrown = false;
+    try
+    {
+        config.Amend("breaker=fast");
+    }
+    catch (const std::invalid_argument&)
+    {
+        bThrown = true;
+    }
+    TEST_ASSERT(bThrown);
+    config.SetExecutor();
+
+    std::cout << "End circuit breaker testing." << std::endl << std::endl;
+}
+
+void TestMessageSketches()
+{
+    std::cout << "Start message sketches testing." << std::endl;
+
+    auto& config = dbgh::CAssertConfig::Get();
+    config.EnableAsserts(dbgh::EAssertLevel::Warning);
+    config.SetExecutor(std::make_unique<SummaryExecutor>());
+    int iLine = 0;
+    const auto fail = [&iLine](const int iPasses)
+    {
+        for (int i = 0; i < iPasses; ++i)
+        {
+            // Every 10th message is distinct, the others are the same.
+            iLine = __LINE__ + 1;
+            ASSERT_WARNING(i < 0, "{}", (0 == i % 10) ? std::format("request {} failed", i) : std::string { "shard 7 timeout" });
+        }
+    };
+    const auto find = [&iLine]
+    {
+        auto vecSketches = dbgh::CMessageSketches::Collect();
+        const auto itSketch = std::find_if(vecSketches.begin(), vecSketches.end(), [&iLine](const auto& sketch)
+        {
+            return iLine == sketch.pSite->line;
+        });
+        return (vecSketches.end() != itSketch) ? std::optional { *itSketch } : std::nullopt;
+    };
+
+    fail(1);
+    TEST_ASSERT(! find().has_value());
+
+    config.Amend("sketches=on");
+    TEST_ASSERT(dbgh::CMessageSketches::IsEnabled());
+    fail(10000);
+    const auto sketch = find();
+    TEST_ASSERT(sketch.has_value());
+    TEST_ASSERT(10000 == sketch->observed);
+    TEST_ASSERT(sketch->distinct > 900.0 && sketch->distinct < 1100.0);
+    TEST_ASSERT(dbgh::CMessageSketches::TopCount == sketch->top.size());
+    TEST_ASSERT("shard 7 timeout" == sketch->top.front().sample);
+    TEST_ASSERT(sketch->top.front().count >= 9000);
+    TEST_ASSERT(sketch->top.front().count - sketch->top.front().error <= 9000);
+    const auto strSnapshot = dbgh::impl::CControlServer::Execute("sketches tests/main.cpp");
+    TEST_ASSERT(std::string::npos != strSnapshot.find("\tobserved 10000\t"));
+    TEST_ASSERT(std::string::npos != strSnapshot.find("\tshard 7 timeout\n"));
+
+    // Under the backoff the suppressed failures are sampled and weighted.
+    dbgh::CMessageSketches::Reset();
+    config.SetReportBackoff(dbgh::LevelMask(dbgh::EAssertLevel::Warning));
+    fail(64000);
+    config.SetReportBackoff();
+    const auto sampled = find();
+    TEST_ASSERT(sampled.has_value());
+    TEST_ASSERT(sampled->observed > 51200 && sampled->observed < 76800);
+    TEST_ASSERT("shard 7 timeout" == sampled->top.front().sample);
+    TEST_ASSERT(sampled->top.front().count > 46080);
+    dbgh::CMessageSketches::Reset();
+    fail(10000);
+
+    config.Amend("sketches=off");
+    fail(10);
+    TEST_ASSERT(10000 == find()->observed);
+    dbgh::CMessageSketches::Reset();
+    TEST_ASSERT(! find().has_value());
+
+    bool bThrown = false;
+    try
+    {
+        config.Amend("sketches=maybe");
+    }
+    catch (const std::invalid_argument&)
+    {
+        bThrown = true;
+    }
+    TEST_ASSERT(bThrown);
+    config.SetExecutor();
+
+    std::cout << "End message sketches testing." << std::endl << std::endl;
+}
+
+template<class T>
+int FailTemplated()
+{
+    ASSERT_WARNING(std::is_void_v<T>, "templated");
+    return __LINE__ - 1;
+}
+
+void TestMetricsExport()
+{
+    std::cout << "Start metrics export testing." << std::endl;
+
+    auto& config = dbgh::CAssertConfig::Get();
+    config.EnableAsserts(dbgh::EAssertLevel::Warning);
+    config.SetExecutor(std::make_unique<SummaryExecutor>());
+    config.SetReportBackoff(dbgh::LevelMask(dbgh::EAssertLevel::Warning), std::chrono::seconds { 60 });
+    static int s_iFilteredLine = 0;
+    const auto failFiltered = []
+    {
+        s_iFilteredLine = __LINE__ + 1;
+        ASSERT_WARNING(2 + 2 == 5, "filtered");
+    };
+    const auto iBackoffLine = __LINE__ + 3;
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_WARNING(2 + 2 == 5, "exported");
+    }
+    failFiltered();
+    config.SetReportBackoff();
+
+    const auto siteLabels = [](const int iLine)
+    {
+        return std::string { "{file=\"" } + __FILE__ + "\",line=\"" + std::to_string(iLine) + "\",level=\"warning\"} ";
+    };
+    config.SetFilter([](const dbgh::SAssertSite& site, const dbgh::SThreadContext&)
+    {
+        return s_iFilteredLine == site.line ? dbgh::EFilterVerdict::Reject : dbgh::EFilterVerdict::Accept;
+    });
+    failFiltered();
+    config.SetFilter();
+    static_cast<void>(FailTemplated<int>());
+    static_cast<void>(FailTemplated<int>());
+    const auto iTemplatedLine = FailTemplated<long>();
+
+    const auto strMetrics = config.RenderMetrics();
+    TEST_ASSERT(strMetrics.starts_with("# HELP dbgh_assert_failures_total "));
+    TEST_ASSERT(std::string::npos != strMetrics.find("# TYPE dbgh_assert_site_suppressed_total counter\n"));
+    TEST_ASSERT(std::string::npos != strMetrics.find("dbgh_assert_site_failures_total" + siteLabels(iBackoffLine) + "4\n"));
+    TEST_ASSERT(std::string::npos != strMetrics.find("dbgh_assert_site_suppressed_total" + siteLabels(iBackoffLine) + "1\n"));
+    TEST_ASSERT(std::string::npos != strMetrics.find("dbgh_assert_site_dropped_total" + siteLabels(s_iFilteredLine) + "1\n"));
+    TEST_ASSERT(std::string::npos != strMetrics.find("dbgh_assert_failures_total{level=\"fatal\"} "));
+    TEST_ASSERT(std::string::npos != strMetrics.find("dbgh_assert_circuit_breaker_tripped 0\n"));
+    // The two instantiations share the labels, their counters are summed into one series.
+    const auto strTemplated = "dbgh_assert_site_failures_total" + siteLabels(iTemplatedLine);
+    const auto uTemplated = strMetrics.find(strTemplated);
+    TEST_ASSERT(std::string::npos != uTemplated && strMetrics.compare(uTemplated + strTemplated.size(), 2, "3\n") == 0);
+    TEST_ASSERT(std::string::npos == strMetrics.find(strTemplated, uTemplated + 1));
+#if defined(DBGH_ASSERTS_PROFILE)
+    TEST_ASSERT(std::string::npos != strMetrics.find("dbgh_assert_site_evaluations_total" + siteLabels(iBackoffLine) + "4\n"));
+#else
+    TEST_ASSERT(std::string::npos == strMetrics.find("evaluations_total"));
+#endif
+    TEST_ASSERT(dbgh::impl::CControlServer::Execute("metrics").starts_with("# HELP dbgh_assert_failures_total "));
+
+    const auto path = std::filesystem::temp_directory_path() / "dbgh_metrics_test.prom";
+    std::filesystem::remove(path);
+    config.StartMetricsFile(path.string(), std::chrono::milliseconds { 10 });
+    const auto readFile = [&path]
+    {
+        std::ifstream file { path };
+        return std::string { std::istreambuf_iterator<char> { file }, std::istreambuf_iterator<char> { } };
+    };
+    TEST_ASSERT(std::string::npos != readFile().find("dbgh_assert_site_failures_total" + siteLabels(iBackoffLine) + "4\n"));
+    failFiltered();
+    bool bRefreshed = false;
+    for (int i = 0; i < 2000 && ! bRefreshed; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+        bRefreshed = std::string::npos != readFile().find("dbgh_assert_site_failures_total" + siteLabels(s_iFilteredLine) + "3\n");
+    }
+    TEST_ASSERT(bRefreshed);
+    config.StartMetricsFile();
+    TEST_ASSERT(std::filesystem::exists(path));
+    TEST_ASSERT(! std::filesystem::exists(path.string() + ".tmp"));
+    std::filesystem::remove(path);
+
+    // The metrics file named by the environment is written while the config is constructed.
+    const auto pid = ::fork();
+    if (0 == pid)
+    {
+        ::setenv("DBGH_ASSERTS_METRICS", path.c_str(), 1);
+        ::execl("/proc/self/exe", "run_test", s_pszGetConfigOption, nullptr);
+        ::_exit(127);
+    }
+    int iStatus = -1;
+    ::waitpid(pid, &iStatus, 0);
+    TEST_ASSERT(WIFEXITED(iStatus) && 0 == WEXITSTATUS(iStatus));
+    TEST_ASSERT(std::string::npos != readFile().find("dbgh_assert_circuit_breaker_tripped 0\n"));
+    std::filesystem::remove(path);
+    config.SetExecutor();
+
+    std::cout << "End metrics export testing." << std::endl << std::endl;
+}
+
+void TestStatsSegment()
+{
+    std::cout << "Start stats segment testing." << std::endl;
+
+    auto& config = dbgh::CAssertConfig::Get();
+    config.EnableAsserts(dbgh::EAssertLevel::Warning);
+    config.SetExecutor(std::make_unique<SummaryExecutor>());
+    config.StartStatsSegment("/dbgh_stats_test", std::chrono::milliseconds { 10 });
+    const auto iLine = __LINE__ + 3;
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_WARNING(2 + 2 == 5, "published");
+    }
+
+    bool bPublished = false;
+    for (int i = 0; i < 2000 && ! bPublished; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+        const auto snapshot = dbgh::impl::CStatsSegment::Read("dbgh_stats_test");
+        TEST_ASSERT(static_cast<std::uint32_t>(getpid()) == snapshot.pid);
+        TEST_ASSERT(0 < snapshot.publications);
+        bPublished = std::any_of(snapshot.sites.begin(), snapshot.sites.end(), [iLine](const auto& stats)
+        {
+            return iLine == stats.line && std::string_view { __FILE__ }.ends_with(stats.file) && 3 == stats.failures
+                   && dbgh::EAssertLevel::Warning == stats.level && "2 + 2 == 5" == stats.expression;
+        });
+    }
+    TEST_ASSERT(bPublished);
+
+    // The rates are measured between the publication times.
+    const auto first = dbgh::impl::CStatsSegment::Read("dbgh_stats_test");
+    auto second = first;
+    for (int i = 0; i < 2000 && second.publications == first.publications; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+        second = dbgh::impl::CStatsSegment::Read("dbgh_stats_test");
+    }
+    TEST_ASSERT(second.publications > first.publications && second.publishedAt > first.publishedAt);
+
+    // The segment of the running process is not replaced.
+    bool bRejected = false;
+    try
+    {
+        dbgh::impl::CStatsSegment segment { "dbgh_stats_test", std::chrono::milliseconds { 10 } };
+    }
+    catch (const std::system_error& e)
+    {
+        bRejected = EEXIST == e.code().value();
+    }
+    TEST_ASSERT(bRejected);
+    TEST_ASSERT(static_cast<std::uint32_t>(getpid()) == dbgh::impl::CStatsSegment::Read("dbgh_stats_test").pid);
+
+    // The segment left by the crashed process is.
+    config.StartStatsSegment();
+    const auto pid = ::fork();
+    if (0 == pid)
+    {
+        auto* pSegment = new dbgh::impl::CStatsSegment { "dbgh_stats_test", std::chrono::milliseconds { 10 } };
+        static_cast<void>(pSegment);
+        ::_exit(0);
+    }
+    int iStatus = -1;
+    ::waitpid(pid, &iStatus, 0);
+    TEST_ASSERT(WIFEXITED(iStatus) && 0 == WEXITSTATUS(iStatus));
+    TEST_ASSERT(static_cast<std::uint32_t>(pid) == dbgh::impl::CStatsSegment::Read("dbgh_stats_test").pid);
+    config.StartStatsSegment("/dbgh_stats_test", std::chrono::milliseconds { 10 });
+    TEST_ASSERT(static_cast<std::uint32_t>(getpid()) == dbgh::impl::CStatsSegment::Read("dbgh_stats_test").pid);
+
+    config.StartStatsSegment();
+    bool bRemoved = false;
+    try
+    {
+        static_cast<void>(dbgh::impl::CStatsSegment::Read("/dbgh_stats_test"));
+    }
+    catch (const std::system_error&)
+    {
+        bRemoved = true;
+    }
+    TEST_ASSERT(bRemoved);
+    config.SetExecutor();
+
+    std::cout << "End stats segment testing." << std::endl << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (2 == argc && std::string_view { s_pszGetConfigOption } == argv[1])
+    {
+        // The child of the startup tests: only constructs the config, with the environment set by the test.
+        static_cast<void>(dbgh::CAssertConfig::Get());
+        return 0;
+    }
+
     TestFatalAssert();
     TestWarningAssert();
     TestErrorAssert();
     TestDebugAssert();
     TestTextFormating();
+    TestBasicAsserts();
+    TestAssertRouter();
+    TestAssertFilter();
+    TestWritevSink();
+    TestIoUringSink();
+    TestJsonReportFormat();
+    TestReentrantReport();
+    TestRotatingFileSink();
+    TestCaptureClock();
+    TestScopedContext();
+    TestRequestSampling();
+    TestCoroutineContext();
+    TestCpuBudget();
+    TestAssertProfiler();
+    TestSiteDemotions();
+    TestStartupConfig();
+    TestConfigWatcher();
+    TestControlServer();
+    TestSharedControl();
+    TestAssertCategories();
+    TestBurstEnablement();
+    TestReportBackoff();
+    TestCircuitBreaker();
+    TestMessageSketches();
+    TestMetricsExport();
+    TestStatsSegment();
     std::cout << "__END_OF_TESTING__" << std::endl;
     return 0;
 }
@@ -0,0 +1,155 @@
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include "impl/CSharedControl.h"
+#endif
+
+// Sends one request to the control socket of the process (see dbgh::impl::CControlServer) or executes it on the
+// shared control block of the process group (the "shm:<name>" target, see dbgh::impl::CSharedControl) and prints the
+// response. The exit code is 0 for the "ok" response, 1 for the "error" response and 2 if the target is not reachable.
+
+namespace
+{
+
+void PrintUsage()
+{
+    std::cerr << "Usage: dbgh-ctl <socket>|shm:<name> <request> [<argument>...]\n"
+              << "  dbgh-ctl /tmp/server.asserts list net/\n"
+              << "  dbgh-ctl /tmp/server.asserts set \"site:db/pool.cpp:120=off\"\n"
+              << "  dbgh-ctl shm:/server.asserts set \"levels=warning,error\"\n"
+              << "  dbgh-ctl /tmp/server.asserts help" << std::endl;
+}
+
+bool SendAll(const int fd, std::string_view buffer)
+{
+    while (! buffer.empty())
+    {
+        const auto iSent = send(fd, buffer.data(), buffer.size(), 0);
+        if (iSent < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        if (iSent <= 0)
+        {
+            return false;
+        }
+        buffer.remove_prefix(static_cast<std::size_t>(iSent));
+    }
+    return true;
+}
+
+// Sends the request to the control socket, returns false if the process is not reachable.
+bool RequestSocket(const std::string_view path, const std::string& request, std::string& response)
+{
+    sockaddr_un address { };
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "dbgh-ctl: the socket path is too long." << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.data(), path.size());
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (-1 == fd || -1 == connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address))
+        || ! SendAll(fd, request + '\n'))
+    {
+        std::cerr << "dbgh-ctl: cannot reach '" << path << "': " << std::strerror(errno) << std::endl;
+        if (-1 != fd)
+        {
+            close(fd);
+        }
+        return false;
+    }
+    shutdown(fd, SHUT_WR);
+
+    char arrBuffer[4096];
+    for (auto iRead = recv(fd, arrBuffer, sizeof(arrBuffer), 0); 0 != iRead; iRead = recv(fd, arrBuffer, sizeof(arrBuffer), 0))
+    {
+        if (iRead < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        if (iRead < 0)
+        {
+            std::cerr << "dbgh-ctl: cannot read the response: " << std::strerror(errno) << std::endl;
+            close(fd);
+            return false;
+        }
+        response.append(arrBuffer, static_cast<std::size_t>(iRead));
+    }
+    close(fd);
+    return true;
+}
+
+// Executes the request on the shared control block, returns false if the block cannot be opened.
+bool RequestShared(const std::string_view name, const std::string& request, std::string& response)
+{
+#if defined(__linux__)
+    try
+    {
+        dbgh::impl::CSharedControl control { std::string { name }, false };
+        response = control.Execute(request);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "dbgh-ctl: " << e.what() << std::endl;
+        return false;
+    }
+#else
+    static_cast<void>(name);
+    static_cast<void>(request);
+    static_cast<void>(response);
+    std::cerr << "dbgh-ctl: the shared control block is available on Linux only." << std::endl;
+    return false;
+#endif
+}
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    std::string strRequest;
+    for (int i = 2; i < argc; ++i)
+    {
+        strRequest.append(2 == i ? "" : " ").append(argv[i]);
+    }
+
+    constexpr std::string_view sharedPrefix { "shm:" };
+    const std::string_view target { argv[1] };
+    std::string strResponse;
+    const auto bReached = target.starts_with(sharedPrefix)
+            ? RequestShared(target.substr(sharedPrefix.size()), strRequest, strResponse)
+            : RequestSocket(target, strRequest, strResponse);
+    if (! bReached)
+    {
+        return 2;
+    }
+
+    // The last line is the status, the lines before it are the output.
+    const auto uStatus = strResponse.rfind('\n', strResponse.size() < 2 ? 0 : strResponse.size() - 2);
+    const auto uStatusBegin = (std::string::npos == uStatus || strResponse.size() < 2) ? 0 : uStatus + 1;
+    const std::string_view status = std::string_view { strResponse }.substr(uStatusBegin);
+    std::cout << std::string_view { strResponse }.substr(0, uStatusBegin) << std::flush;
+    if (status.starts_with("ok"))
+    {
+        return 0;
+    }
+    std::cerr << "dbgh-ctl: " << (status.empty() ? std::string_view { "no response.\n" } : status) << std::flush;
+    return 1;
+}
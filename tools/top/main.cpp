@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
+
+#include "impl/CReportFormatter.h"
+#include "impl/CStatsSegment.h"
+
+// Attaches read-only to the stats segment of the process (see dbgh::impl::CStatsSegment) and shows the sites ordered
+// by the failure rate, like top. The rate is measured between the publications of the process, by their times stored
+// in the segment, so the refresh period of the viewer does not skew it. The exit code is 0 when the iterations are
+// done and 2 if the segment cannot be read.
+
+namespace
+{
+
+void PrintUsage()
+{
+    std::cerr << "Usage: dbgh-top <name> [-d <seconds>] [-n <iterations>]\n"
+              << "  dbgh-top /server.stats\n"
+              << "  dbgh-top /server.stats -d 0.5 -n 10" << std::endl;
+}
+
+// The key of the site in the segment, the entries are append-only, so the index is stable.
+using TSiteKey = std::size_t;
+
+struct SRow
+{
+    double rate = 0.0;
+    const dbgh::impl::SSiteStats* pStats = nullptr;
+};
+
+void PrintSnapshot(const std::string_view name, const dbgh::impl::SStatsSnapshot& snapshot,
+                   const std::unordered_map<TSiteKey, double>& rates, const bool bClear)
+{
+    std::vector<SRow> vecRows;
+    vecRows.reserve(snapshot.sites.size());
+    for (TSiteKey uKey = 0; uKey < snapshot.sites.size(); ++uKey)
+    {
+        const auto itRate = rates.find(uKey);
+        vecRows.push_back({ (rates.end() != itRate) ? itRate->second : 0.0, &snapshot.sites[uKey] });
+    }
+    std::stable_sort(vecRows.begin(), vecRows.end(), [](const auto& left, const auto& right)
+    {
+        if (left.rate > right.rate || right.rate > left.rate)
+        {
+            return left.rate > right.rate;
+        }
+        return left.pStats->failures > right.pStats->failures;
+    });
+
+    if (bClear)
+    {
+        std::cout << "\033[H\033[2J";
+    }
+    std::cout << "dbgh-top " << name << "  pid " << snapshot.pid << "  sites " << snapshot.sites.size()
+              << "  unpublished " << snapshot.overflows << "\n\n";
+    char arrLine[256];
+    std::snprintf(arrLine, sizeof(arrLine), "%10s %12s %12s %12s %-9s %s\n",
+                  "RATE/s", "FAILURES", "SUPPRESSED", "DROPPED", "LEVEL", "SITE");
+    std::cout << arrLine;
+    for (const auto& row : vecRows)
+    {
+        const auto& stats = *row.pStats;
+        std::snprintf(arrLine, sizeof(arrLine), "%10.1f %12llu %12llu %12llu %-9s ", row.rate,
+                      static_cast<unsigned long long>(stats.failures),
+                      static_cast<unsigned long long>(stats.suppressed),
+                      static_cast<unsigned long long>(stats.dropped),
+                      dbgh::impl::CReportFormatter::ToString(stats.level));
+        std::cout << arrLine << stats.file << ":" << stats.line << "  " << stats.expression << "\n";
+    }
+    std::cout << std::flush;
+}
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    const std::string strName { argv[1] };
+    double dDelay = 1.0;
+    long lIterations = -1;
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string_view option { argv[i] };
+        if (i + 1 >= argc || ("-d" != option && "-n" != option))
+        {
+            PrintUsage();
+            return 2;
+        }
+        try
+        {
+            if ("-d" == option)
+            {
+                dDelay = std::stod(argv[++i]);
+            }
+            else
+            {
+                lIterations = std::stol(argv[++i]);
+            }
+        }
+        catch (const std::exception&)
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+    if (dDelay <= 0.0)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    const auto bClear = 1 == isatty(STDOUT_FILENO);
+    // The failures at the previous publication, the rates are kept until the next publication.
+    std::unordered_map<TSiteKey, std::uint64_t> mapPrevious;
+    std::unordered_map<TSiteKey, double> mapRates;
+    std::uint32_t uPreviousPid = 0;
+    std::uint64_t uPreviousPublications = 0;
+    std::chrono::steady_clock::time_point previousPublishedAt { };
+    for (long lIteration = 0; lIterations < 0 || lIteration < lIterations; ++lIteration)
+    {
+        dbgh::impl::SStatsSnapshot snapshot;
+        try
+        {
+            snapshot = dbgh::impl::CStatsSegment::Read(strName);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "dbgh-top: " << e.what() << std::endl;
+            return 2;
+        }
+        if (snapshot.pid != uPreviousPid || snapshot.publications != uPreviousPublications)
+        {
+            // The first snapshot of the process (also of the restarted one) is only the base of the rates.
+            const auto dSeconds = (snapshot.pid != uPreviousPid || snapshot.publishedAt <= previousPublishedAt) ? 0.0
+                    : std::chrono::duration<double> { snapshot.publishedAt - previousPublishedAt }.count();
+            mapRates.clear();
+            for (TSiteKey uKey = 0; uKey < snapshot.sites.size() && dSeconds > 0.0; ++uKey)
+            {
+                const auto uFailures = snapshot.sites[uKey].failures;
+                const auto itPrevious = mapPrevious.find(uKey);
+                const auto uDelta = (mapPrevious.end() != itPrevious && uFailures >= itPrevious->second)
+                        ? uFailures - itPrevious->second : 0;
+                mapRates[uKey] = static_cast<double>(uDelta) / dSeconds;
+            }
+            mapPrevious.clear();
+            for (TSiteKey uKey = 0; uKey < snapshot.sites.size(); ++uKey)
+            {
+                mapPrevious[uKey] = snapshot.sites[uKey].failures;
+            }
+            uPreviousPid = snapshot.pid;
+            uPreviousPublications = snapshot.publications;
+            previousPublishedAt = snapshot.publishedAt;
+        }
+        PrintSnapshot(strName, snapshot, mapRates, bClear);
+
+        if (lIterations < 0 || lIteration + 1 < lIterations)
+        {
+            std::this_thread::sleep_for(std::chrono::duration<double> { dDelay });
+        }
+    }
+    return 0;
+}